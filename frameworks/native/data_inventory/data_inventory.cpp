@@ -15,6 +15,7 @@
 
 #include "data_inventory.h"
 #include <algorithm>
+#include "util/text_sanitizer.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -91,5 +92,19 @@ bool DataInventory::InjectStringWithFilter(const std::string& source, DataId dat
     return Inject(dataId, std::make_shared<std::vector<std::string>>(result));
 }
 
+bool DataInventory::InjectSanitizedString(const std::string& source, DataId dataId, bool isFile)
+{
+    auto result = std::make_shared<std::vector<std::string>>();
+    auto loader = isFile ? HandleStringFromFile : HandleStringFromCommand;
+    if (!loader(source, [&result](const std::string& line) {
+        result->emplace_back();
+        TextSanitizer::SanitizeAppend(line.data(), line.size(), result->back());
+        return true;
+    })) {
+        return false;
+    }
+    return Inject(dataId, result);
+}
+
 } // namespace HiviewDFX
 } // namespace OHOS
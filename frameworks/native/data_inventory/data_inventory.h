@@ -105,6 +105,8 @@ public:
     using DataFilterHandler = std::function<void(std::string& line)>;
     bool InjectString(const std::string& source, DataId dataId, bool isFile);
     bool InjectStringWithFilter(const std::string& source, DataId dataId, bool isFile, const DataFilterHandler& func);
+    // scrubs the control characters of every line while it is copied into the data, see TextSanitizer.
+    bool InjectSanitizedString(const std::string& source, DataId dataId, bool isFile);
 
     std::set<DataId> RemoveRestData(const std::set<DataId>& keepingDataType);
     std::size_t Size() const;
@@ -83,6 +83,7 @@ struct DumperSysEventParams {
 inline const std::string LOG_DEFAULT = "log.txt";
 inline const std::string ZIP_FILEEXT = "zip";
 inline const std::string ZIP_FOLDER = "/data/log/hidumper/";
+inline const std::string TRACE_SUFFIX = ".trace.json";
 inline const std::string HISYSEVENT_TMP_FILE = "/data/log/hidumper/hisysevent.tmp";
 inline const int64_t ZIP_MAX_SIZE = 100 * 1024 * 1024;
 inline const int64_t ZIP_TARGET_SIZE = 80 * 1024 * 1024;
@@ -46,6 +46,9 @@ struct DumperOpts {
     long long endTime_;
     bool isFaultLog_;
     std::string path_; // for zip
+    bool isMachineProgress_;
+    std::string query_; // for the column rows filter
+    bool isTrace_; // write the spans of this dump as a Chrome trace
     bool isAppendix_;
     bool isShowSmaps_;
     bool isShowSmapsInfo_;
@@ -75,6 +78,7 @@ struct DumperOpts {
     bool isDumpIpcStat_;
     bool dumpJsRawHeap_;
     bool dumpMemPrune_;
+    int memTopN_;
     bool isDumpCjHeapMem_;
     bool isDumpCjHeapMemGC_;
     int dumpCjHeapMemPid_;
@@ -16,6 +16,7 @@
 #define CMD_DUMPER_H
 
 #include "hidumper_executor.h"
+#include "util/command_runner.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -27,7 +28,6 @@ public:
         StringMatrix dumpDatas) override;
     DumpStatus Execute() override;
     DumpStatus AfterExecute() override;
-    DumpStatus GetLineData(FILE* fp, StringMatrix dumpDatas);
     DumpStatus GetCmdInterface(const std::string& cmd, StringMatrix dumpDatas);
 
 private:
@@ -38,7 +38,7 @@ private:
 private:
     std::string cmd_ = "";
     StringMatrix dumpDatas_;
-    FILE *fp_;
+    std::unique_ptr<CommandRunner> runner_;
     std::vector<std::string> lineData_;
 
     // MoreData Flag
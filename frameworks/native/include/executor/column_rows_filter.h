@@ -18,6 +18,7 @@
 #include "common.h"
 #include "common/dumper_parameter.h"
 #include "hidumper_executor.h"
+#include "util/column_rows_query.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -31,7 +32,8 @@ public:
     DumpStatus AfterExecute() override;
 
 private:
-    void GetRuleTable();
+    StringMatrix dumpDatas_;
+    ColumnRowsQuery query_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -28,6 +28,8 @@ struct EventQueryParam {
     std::string processName_;
     std::string eventId_;
     std::vector<std::pair<std::string, std::vector<std::string>>> queryRule;
+    size_t limit_ = 0; // keeps only the newest limit_ events accepted by filter_, 0 keeps all of them
+    EventFilter filter_;
 };
 
 enum EventDumpResult {
@@ -49,6 +51,10 @@ private:
                                                      std::unordered_set<std::string> &faultEventQuerySet,
                                                      const EventQueryParam &param);
     void FillQueryParam(EventQueryParam &param, const std::unordered_set<std::string> &faultEventQuerySet);
+    void MatchFaultEvents(const std::vector<HiSysEventRecord> &faultEvents,
+                          const std::unordered_set<std::string> &pkRunningIdSet,
+                          const std::unordered_set<std::string> &faultEventQuerySet,
+                          std::vector<HiSysEventRecord> &events);
     void SortEventsByTimeDesc(std::vector<HiSysEventRecord>& events);
 };
 } // namespace HiviewDFX
@@ -18,29 +18,40 @@
 #include "hisysevent_manager.h"
 
 #include <condition_variable>
+#include <functional>
 #include <mutex>
 #include <atomic>
 #include <vector>
 
 namespace OHOS {
 namespace HiviewDFX {
+using EventFilter = std::function<bool(const HiSysEventRecord &)>;
+
 class EventQueryCallback : public HiSysEventQueryCallback {
 public:
     EventQueryCallback();
+    // keeps only the limit newest events accepted by filter as they arrive, a limit of 0 keeps all of them.
+    EventQueryCallback(size_t limit, const EventFilter &filter);
     ~EventQueryCallback();
 
     void OnQuery(std::shared_ptr<std::vector<HiSysEventRecord>> sysEvents) override;
     void OnComplete(int32_t reason, int32_t total) override;
     bool WaitForComplete(std::chrono::milliseconds timeout);
+    // the kept events, newest first when a limit is set.
     std::vector<HiSysEventRecord> GetEvents();
     int32_t GetReason();
 
+private:
+    void PushLimited(const HiSysEventRecord &event);
+
 private:
     std::mutex mutex_;
     std::condition_variable cv_;
     bool completed_;
     std::vector<HiSysEventRecord> events_;
     int32_t reason_;
+    size_t limit_ {0};
+    EventFilter filter_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
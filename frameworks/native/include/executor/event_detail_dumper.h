@@ -35,7 +35,13 @@ private:
     void CloseFd();
     std::vector<std::string> FilterLogPaths();
     void ReadLogsByPaths(const std::vector<std::string> &logPaths);
-    void ReadSingleLogFile(const std::string &path);
+    // takes the prefetched fd when it is the one of path.
+    void OpenLogFile(const std::string &path);
+    void ReadOpenedLogFile();
+    void ReadLinesFromFd();
+    void SendFdToOutput();
+    void PrefetchLogFile(const std::string &path);
+    void CloseFd(int &fd);
 private:
     StringMatrix dumpDatas_;
     std::string processName_;
@@ -44,8 +50,10 @@ private:
     int showEventCount_;
     std::string eventId_;
     std::vector<HiSysEventRecord> events_;
-    FILE* fp_;
     int fd_;
+    int nextFd_;
+    int outputFd_;
+    std::string nextPath_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -31,24 +31,31 @@ public:
 private:
     DumpStatus ReadFile();
     DumpStatus ReadLineInFile();
+    DumpStatus SendFileToOutput();
+    void DispatchBlock(char* data, size_t size);
+    DumpStatus NextFileStatus();
     void BuildFileNames(const std::string& target, bool arg_pid, int pid,
         bool arg_cpuid, int cpuid);
     void ReplacePidInFilename(std::string& filename, int pid);
     void ReplaceCpuidInFilename(std::string& filename, int cpuid);
     int OpenNextFile();
     void CloseFd();
-    std::string ReplaceAddresses(const std::string& input);
+    static void HideAddressesInBlock(char* data, size_t size);
 
 private:
     std::vector<std::string> filenames_;
-    FILE* fp_;
     int fd_;
+    int outputFd_ = -1;
+    std::vector<char> buffer_;
+    size_t carry_ = 0;
+    bool useSendFile_ = true;
     unsigned int next_file_index_;
     StringMatrix result_;
 
     // MoreData Flag
     bool more_data_;
     bool need_loop_;
+    bool directOutput_ = false;
 
     bool needHideAddr_ = false; // hide addr
 };
@@ -41,12 +41,21 @@ public:
     const std::shared_ptr<DumpCfg>& GetDumpConfig() const;
 
     bool IsCanceled() const;
+    // a staged dumper runs ahead on a worker into a private matrix, so it must not write the client fd itself.
+    void SetStaged(bool staged);
+protected:
+    // client fd when the data of this dumper reaches it without filter, zip or output file, otherwise -1.
+    int GetDirectOutputFd(const std::shared_ptr<DumperParameter>& parameter) const;
+    static void FlushDumpDatas(StringMatrix dumpDatas, int fd);
+    static bool WriteAll(int fd, const char* data, size_t size);
 protected:
     std::shared_ptr<DumpCfg> ptrDumpCfg_;
 private:
+    const std::string *GetTraceDetail() const; // the config name shown on the spans of this executor
 private:
     std::shared_ptr<RawParam> rawParam_;
     std::shared_ptr<HidumperExecutor> ptrParent_;
+    bool staged_ {false};
     static const std::string TIME_OUT_STR;
 };
 } // namespace HiviewDFX
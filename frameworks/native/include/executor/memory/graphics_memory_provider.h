@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRAPHICS_MEMORY_PROVIDER_H
+#define GRAPHICS_MEMORY_PROVIDER_H
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "executor/memory/parse/meminfo_data.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Collects the GL and graph memory of a whole pid set at once and serves the per pid lookups from an index.
+ * A provider that can not collect in one go leaves the index empty, then callers query each pid as before.
+ * GraphicMemoryCollector only answers per pid, so the only batched source is a plugin exporting
+ * OnCreatePluginBatch, which has to report the values GraphicMemoryCollector would. Without one, as on
+ * every device today, nothing is collected and the per pid queries are used unchanged.
+ */
+class GraphicsMemoryProvider {
+public:
+    using EntryMap = std::unordered_map<int32_t, MemInfoData::GraphicsMemory>;
+
+    virtual ~GraphicsMemoryProvider() = default;
+    // the provider of the device, it collects through the batched plugin entry point if there is one.
+    static std::unique_ptr<GraphicsMemoryProvider> Create();
+
+    // replaces the index with the memory of pids, the graph memory is only collected if withGraph.
+    bool Collect(const std::vector<int32_t> &pids, bool withGraph);
+    bool IsCollected() const;
+    // a pid the collection reported nothing for uses no graphics memory.
+    uint64_t GetGl(int32_t pid) const;
+    uint64_t GetGraph(int32_t pid) const;
+    void Clear();
+
+protected:
+    virtual bool CollectAll(const std::vector<int32_t> &pids, bool withGraph, EntryMap &entries) = 0;
+
+private:
+    EntryMap entries_;
+    bool collected_ = false;
+};
+
+class PluginGraphicsMemoryProvider : public GraphicsMemoryProvider {
+protected:
+    bool CollectAll(const std::vector<int32_t> &pids, bool withGraph, EntryMap &entries) override;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // GRAPHICS_MEMORY_PROVIDER_H
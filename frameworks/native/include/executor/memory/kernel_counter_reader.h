@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef KERNEL_COUNTER_READER_H
+#define KERNEL_COUNTER_READER_H
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "singleton.h"
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Reads integer counters that the kernel exports as small sysfs or debugfs files, without running a command.
+ * A counter is the sum of the files matching pattern under folder. The folder fd and the matched files are
+ * cached between reads for up to REMATCH_INTERVAL_MS, each file is read with a single pread.
+ */
+class KernelCounterReader : public Singleton<KernelCounterReader> {
+public:
+    KernelCounterReader();
+    ~KernelCounterReader();
+    KernelCounterReader(KernelCounterReader const &) = delete;
+    void operator=(KernelCounterReader const &) = delete;
+
+    struct CounterSpec {
+        std::string name;
+        std::string folder;
+        std::string pattern; // glob(3) pattern relative to folder, such as "*/used"
+    };
+    static constexpr const char *CMA_USED = "cma_used";
+    // files appearing under the folder are picked up once the cache is this old.
+    static constexpr int64_t REMATCH_INTERVAL_MS = 5000;
+
+    // adds or replaces a counter, its cached files are dropped.
+    void Register(const CounterSpec &spec);
+    bool IsRegistered(const std::string &name);
+    // adds the sum of the matched files to value, a counter whose folder is missing reads 0.
+    // false if the counter is unknown, or a matched file can not be read or is not a number.
+    bool Read(const std::string &name, uint64_t &value);
+    // closes the cached folder fds, the next read matches the files again.
+    void Reset();
+
+private:
+    struct Counter {
+        CounterSpec spec;
+        int folderFd {-1};
+        std::vector<std::string> files; // relative to folder
+        int64_t matchedMs {0}; // steady clock time the files were matched
+    };
+    bool Prepare(Counter &counter);
+    bool ReadCounter(Counter &counter, uint64_t &value);
+    static bool ReadNumber(int folderFd, const std::string &file, uint64_t &value);
+    static void Release(Counter &counter);
+
+private:
+    std::mutex mutex_;
+    std::map<std::string, Counter> counters_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif
@@ -21,7 +21,9 @@
 #include <string>
 #include <vector>
 #include "executor/memory/get_heap_info.h"
+#include "executor/memory/graphics_memory_provider.h"
 #include "executor/memory/parse/meminfo_data.h"
+#include "util/column_rows_query.h"
 #include "common.h"
 #include "time.h"
 #include "graphic_memory_collector.h"
@@ -65,7 +67,13 @@ public:
     void SetReceivedSigInt(bool isReceivedSigInt);
     DumpStatus GetMemoryInfoNoPid(int fd, StringMatrix result);
     DumpStatus GetMemoryInfoPrune(int fd, StringMatrix result);
+    // ranks only the topN largest processes, without the per pid table and the smaps breakdown.
+    DumpStatus GetMemoryInfoTop(int fd, size_t topN, bool prune, StringMatrix result);
     DumpStatus DealResult(StringMatrix result);
+    // the processes the filter drops are left out of the process rows of the next no pid request, not the totals.
+    void SetProcessFilter(const ColumnRowsQuery::ProcessFilter &filter);
+    // drops the state of the last request, so a pooled object can serve the next one.
+    void Reset();
 
 private:
     enum Status {
@@ -76,7 +84,8 @@ private:
     };
     int rawParamFd_ = 0;
     const int LINE_WIDTH_ = 14;
-    int TITLE_WIDTH_ = 17;
+    const int DEFAULT_TITLE_WIDTH_ = 17;
+    int TITLE_WIDTH_ = DEFAULT_TITLE_WIDTH_;
     const int RAM_WIDTH_ = 16;
     const size_t TYPE_SIZE = 2;
     const char SEPARATOR_ = '-';
@@ -122,6 +131,8 @@ private:
     bool isReady_ = false;
     bool dumpPrune_ = false;
     bool dumpSmapsOnStart_ = false;
+    size_t topN_ = 0; // 0 ranks every process
+    ColumnRowsQuery::ProcessFilter processFilter_;
     uint64_t totalGL_ = 0;
     uint64_t totalGraph_ = 0;
     uint64_t totalDma_ = 0;
@@ -139,6 +150,7 @@ private:
     };
     MemoryItemMap memoryItemMap_;
     MemInfoData::GraphicsMemory graphicsMemory_ = {0};
+    std::unique_ptr<GraphicsMemoryProvider> graphicsProvider_;
 
     void InsertMemoryTitle(StringMatrix result);
     void GetResult(const int32_t& pid, StringMatrix result, std::unique_ptr<ProcessMemoryDetail>& processMemoryDetail);
@@ -169,6 +181,10 @@ private:
     void AddMemByProcessTitle(StringMatrix result, std::string sortType);
     bool GetMemoryInfoInit(StringMatrix result);
     void GetMemoryUsageInfo(StringMatrix result);
+    void PushTopN(const MemInfoData::MemUsage &usage);
+    void FillUsageDetail(MemInfoData::MemUsage &usage);
+    // reads the name only if the filter has a name predicate.
+    bool MatchProcessFilter(MemInfoData::MemUsage &usage);
     
     static uint64_t GetVss(const int32_t &pid);
     static std::string GetProcName(const int32_t &pid);
@@ -28,13 +28,16 @@ extern "C" {
 #endif
 
 using StringMatrix = std::shared_ptr<std::vector<std::vector<std::string>>>;
+using ProcessFilter = OHOS::HiviewDFX::ColumnRowsQuery::ProcessFilter;
 
 EXPORT_API int GetMemoryInfoByPid(int pid, StringMatrix data, bool showAshmem, bool showDmaBuf, bool showGpumem);
-EXPORT_API int GetMemoryInfoNoPid(int fd, StringMatrix data);
-EXPORT_API int GetMemoryInfoPrune(int fd, StringMatrix data);
+EXPORT_API int GetMemoryInfoNoPid(int fd, StringMatrix data, const ProcessFilter &filter);
+EXPORT_API int GetMemoryInfoPrune(int fd, StringMatrix data, const ProcessFilter &filter);
+EXPORT_API int GetMemoryInfoTop(int fd, StringMatrix data, int topN, bool prune, const ProcessFilter &filter);
 EXPORT_API int ShowMemorySmapsByPid(int pid, StringMatrix data, bool isShowSmapsInfo);
 EXPORT_API void GetMemoryInfoByTimeInterval(int fd, int pid, int timeInterval);
 EXPORT_API void SetReceivedSigInt(bool isReceivedSigInt);
+EXPORT_API void ReleaseMemoryInfoPool();
 
 #ifdef __cplusplus
 }
@@ -16,7 +16,6 @@
 #define MEMORY_UTIL_H
 #include <map>
 #include <memory>
-#include <mutex>
 #include <string>
 #include <vector>
 #include "singleton.h"
@@ -54,9 +53,6 @@ public:
     void SetMemTotalValue(const std::string &value, std::vector<std::string> &lines, std::vector<std::string> &values,
         bool flag = false);
     uint64_t PermToInt(const std::string& perm);
-
-private:
-    std::mutex mutex_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
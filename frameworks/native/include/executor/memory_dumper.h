@@ -18,7 +18,10 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <mutex>
 #include "hidumper_executor.h"
+#include "util/column_rows_query.h"
+#include "util/dump_staging_area.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -33,6 +36,8 @@ public:
     DumpStatus PreExecute(const std::shared_ptr<DumperParameter> &parameter, StringMatrix dumpDatas) override;
     DumpStatus Execute() override;
     DumpStatus AfterExecute() override;
+    // drops the memory library kept for the service lifetime, the next request opens it again.
+    static void ReleaseMemoryLibrary();
 private:
     int pid_ = 0;
     int rawParamFd_ = 0;
@@ -41,23 +46,34 @@ private:
     bool isShowSmapsInfo_ = false;
     bool isReceivedSigInt_ = false;
     bool dumpMemPrune_ = false;
+    int memTopN_ = 0;
     bool showAshmem_ = false;
     bool showDmabuf_ = false;
     bool showGpumem_ = false;
     bool isZip_ = false;
+    std::shared_ptr<DumpStagingArea> stagingArea_; // owns the zip entry fd while it is set
+    ColumnRowsQuery::ProcessFilter processFilter_; // pushed down from --query
 
     DumpStatus status_ = DUMP_FAIL;
     StringMatrix dumpDatas_;
     using GetMemByPidFunc = int (*)(int, StringMatrix, bool, bool, bool);
-    using GetMemNoPidFunc = int (*)(int, StringMatrix);
-    using GetMemPruneNoPidFunc = int (*)(int, StringMatrix);
+    using GetMemNoPidFunc = int (*)(int, StringMatrix, const ColumnRowsQuery::ProcessFilter &);
+    using GetMemPruneNoPidFunc = int (*)(int, StringMatrix, const ColumnRowsQuery::ProcessFilter &);
+    using GetMemTopNoPidFunc = int (*)(int, StringMatrix, int, bool, const ColumnRowsQuery::ProcessFilter &);
     using GetMemSmapsByPidFunc = int (*)(int, StringMatrix, bool);
     using GetMemByTimeIntervalFunc = void (*)(int, int, int);
     using SetReceivedSigIntFunc = void (*)(bool);
+    using ReleaseMemoryInfoPoolFunc = void (*)();
+    struct MemoryLibrary;
+    static std::shared_ptr<MemoryLibrary> AcquireMemoryLibrary();
+    static std::mutex memoryLibraryMutex_;
+    // the service reference, requests hold their own while they run.
+    static std::shared_ptr<MemoryLibrary> memoryLibrary_;
 
     void GetMemByPid();
     void GetMemNoPid();
     void GetMemPruneNoPid();
+    void GetMemTopNoPid();
     void GetMemSmapsByPid();
     void GetMemByTimeInterval();
     void SetReceivedSigInt();
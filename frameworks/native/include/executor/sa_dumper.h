@@ -17,6 +17,7 @@
 #include <iservice_registry.h>
 #include <mutex>
 #include "hidumper_executor.h"
+#include "util/dump_staging_area.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -40,6 +41,7 @@ private:
     std::string argsStr_;
     int outputFd_ = -1;
     bool isZip_ = false;
+    std::shared_ptr<DumpStagingArea> stagingArea_; // owns the zip entry fd while it is set
 
     DumpStatus GetData(const std::string &name, const sptr<ISystemAbilityManager> &sam);
 };
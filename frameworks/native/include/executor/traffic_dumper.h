@@ -34,6 +34,10 @@ private:
 
     void GetAllBytes();
     void GetApplicationUidBytes();
+
+protected:
+    // asks the net stats service for the counters of one uid, the tests serve their own values.
+    virtual void GetUidBytes(uint32_t uid, uint64_t &receivedStats, uint64_t &sendStats);
 };
 }  // namespace HiviewDFX
 }  // namespace OHOS
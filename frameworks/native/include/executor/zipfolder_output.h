@@ -15,6 +15,7 @@
 #ifndef ZIP_FOLDER_OUTPUT_H
 #define ZIP_FOLDER_OUTPUT_H
 #include "hidumper_executor.h"
+#include "util/dump_staging_area.h"
 namespace OHOS {
 namespace HiviewDFX {
 class ZipFolderOutput : public HidumperExecutor {
@@ -31,6 +32,7 @@ private:
     StringMatrix dumpDatas_;
     std::shared_ptr<DumperParameter> param_;
     std::string logDefaultPath_;
+    std::shared_ptr<DumpStagingArea> stagingArea_;
     int fd_;
 };
 } // namespace HiviewDFX
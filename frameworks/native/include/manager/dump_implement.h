@@ -121,6 +121,7 @@ private:
     DumpStatus SetArkwebJsParam(DumperOpts &opt);
     DumpStatus SetRawParam(DumperOpts &opt);
     DumpStatus SetMemPruneParam(DumperOpts &opt);
+    DumpStatus SetMemTopParam(DumperOpts &opt);
     DumpStatus SetGCParam(DumperOpts &opt);
     DumpStatus SetLeakobjParam(DumperOpts &opt);
     DumpStatus SetCleanParam(DumperOpts &opt);
@@ -130,6 +131,11 @@ private:
         const std::shared_ptr<DumperParameter>& dumpParameter);
     DumpStatus CheckArgs(int argc, char* argv[]);
     bool IsNewStructSupport(std::shared_ptr<DumperParameter> ptrDumperParameter);
+    DumpStatus DumpByParameter(int argc, char *argv[], const std::shared_ptr<RawParam> &reqCtl,
+        std::shared_ptr<DumperParameter> &ptrDumperParameter);
+    std::string GetTracePath(const DumperOpts &opts);
+    // returns true once the trace is on disk, only then is its path reported.
+    bool SaveTrace(const std::string &path, const std::string &trace);
     bool CheckJsHeapSingleParam(const DumperOpts &opt);
 
 private:
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_MANAGER_DUMPER_STAGE_POOL_H
+#define HIDUMPER_MANAGER_DUMPER_STAGE_POOL_H
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common/dumper_parameter.h"
+#include "executor/hidumper_executor.h"
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Runs the collection phase of independent dumpers on worker threads, each into a private matrix.
+ * The serial pipeline commits the staged data in configuration order, so the output is the same
+ * as running every dumper in place. Workers stay at most STAGE_WINDOW dumpers ahead of the commit.
+ */
+class DumperStagePool {
+public:
+    static constexpr size_t MAX_THREAD_NUM = 4;
+    static constexpr size_t MIN_STAGE_COUNT = 2;
+    static constexpr size_t STAGE_WINDOW = 16;
+
+    DumperStagePool(const std::vector<std::shared_ptr<HidumperExecutor>>& executors,
+        const std::shared_ptr<DumperParameter>& parameter);
+    ~DumperStagePool();
+    DumperStagePool(const DumperStagePool&) = delete;
+    DumperStagePool& operator=(const DumperStagePool&) = delete;
+
+    // picks the dumpers that can run ahead and starts the workers, false if it is not worth it.
+    bool Start();
+    void Stop();
+    bool IsStaged(size_t index) const;
+    // waits for the staged dumper at index and appends its data to dumpDatas.
+    void Commit(size_t index, HidumperExecutor::StringMatrix dumpDatas);
+    // dumpers that only append to the matrix and share no state with the other dumpers.
+    static bool CanStage(int cls);
+
+private:
+    struct Slot {
+        HidumperExecutor::StringMatrix dumpDatas;
+        bool done {false};
+    };
+    void SelectStageIndexes();
+    void Run();
+    void RunDumper(const std::shared_ptr<HidumperExecutor>& executor, HidumperExecutor::StringMatrix dumpDatas);
+    bool IsCanceled() const;
+
+private:
+    static constexpr size_t NOT_STAGED = static_cast<size_t>(-1);
+    const std::vector<std::shared_ptr<HidumperExecutor>>& executors_;
+    std::shared_ptr<DumperParameter> parameter_;
+    std::vector<size_t> stageIndexes_; // executor indexes, in configuration order
+    std::vector<size_t> stagePos_; // executor index to the position in stageIndexes_
+    std::vector<Slot> slots_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    size_t next_ {0};
+    size_t committed_ {0};
+    bool stopped_ {false};
+    std::vector<std::thread> workers_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_MANAGER_DUMPER_STAGE_POOL_H
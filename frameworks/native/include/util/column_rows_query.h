@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef COLUMN_ROWS_QUERY_H
+#define COLUMN_ROWS_QUERY_H
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <regex.h>
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * A small query over the tables of a section, every clause is optional:
+ *   select PID,Name where Pss>=10240 and Name~^com\. sort Pss desc limit 10
+ * A table is a header row naming every column the query refers to, followed by the rows with at least as many
+ * columns. A row of one string is split on blanks like awk. A row with more fields than columns is split on its
+ * gaps of two blanks or more, else its fields go to the columns of the header they fall under; a row so divided
+ * with words where a predicate compares numbers is passed through whatever the query says.
+ * Column names are matched case insensitively, names and values with blanks or operators are quoted.
+ */
+class ColumnRowsQuery {
+public:
+    enum class Op { LESS, LESS_EQUAL, GREATER, GREATER_EQUAL, EQUAL, NOT_EQUAL, MATCH, IN };
+    // a POSIX extended regex, compiled once and searched by every row.
+    class Regex {
+    public:
+        Regex() = default;
+        ~Regex();
+        Regex(const Regex &) = delete;
+        Regex &operator=(const Regex &) = delete;
+        bool Compile(const std::string &pattern);
+        bool Search(const std::string &str) const;
+
+    private:
+        regex_t regex_ {};
+        bool compiled_ {false};
+    };
+    struct Predicate {
+        std::string column;
+        Op op {Op::EQUAL};
+        std::vector<std::string> values; // several for IN, one otherwise
+        std::shared_ptr<Regex> regex; // for MATCH
+    };
+    // the predicates a process collector answers itself, it leaves the processes they drop out of its rows.
+    struct ProcessFilter {
+        static constexpr int32_t NO_PID = -1; // the only pid of a pid set no process matches
+        std::set<int32_t> pids; // empty for any pid
+        uint64_t minPss {0}; // kB, with SwapPss
+        std::string name; // empty for any name
+        std::vector<std::shared_ptr<Regex>> nameRegexes; // all of them must match the name
+
+        bool IsEmpty() const;
+        bool HasName() const;
+        bool MatchPid(int32_t pid) const;
+        bool MatchName(const std::string &processName) const;
+    };
+
+    // false with errStr set if expr is not a query.
+    bool Parse(const std::string &expr, std::string &errStr);
+    bool IsEmpty() const;
+    ProcessFilter GetProcessFilter() const;
+    // true if the whole query is a ProcessFilter, no select, sort, limit or other predicates.
+    bool IsProcessFilterOnly() const;
+    // filters, sorts, limits and projects every table of datas in place, returns the count of tables found.
+    size_t Apply(std::vector<std::vector<std::string>> &datas) const;
+
+private:
+    struct Row {
+        size_t index; // in the section
+        std::vector<std::string> cells;
+        bool guessed {false}; // true if the cells were told apart by the offsets of the header
+    };
+    bool ParseSelect(std::string &errStr);
+    bool ParsePredicate(std::string &errStr);
+    bool ParseSort(std::string &errStr);
+    bool ParseLimit(std::string &errStr);
+    bool NextToken(std::string &token, bool raw = false);
+    bool PeekToken(std::string &token);
+    bool ExpectToken(const std::string &token);
+    std::vector<std::string> GetReferencedColumns() const;
+    bool IsHeader(const std::vector<std::string> &cells) const;
+    // indexes are the columns of predicates_ in the table.
+    bool MatchRow(const std::vector<std::string> &cells, const std::vector<size_t> &indexes) const;
+    // false if a cell compared with a number by a predicate is not a number.
+    bool IsComparable(const std::vector<std::string> &cells, const std::vector<size_t> &indexes) const;
+    void ApplyTable(const std::vector<std::vector<std::string>> &datas, const std::vector<Row> &table,
+        std::vector<std::vector<std::string>> &result) const;
+    void ProjectRows(const std::vector<std::vector<std::string>> &datas, const std::vector<std::string> &header,
+        const std::vector<const Row *> &rows, std::vector<std::vector<std::string>> &result) const;
+    std::vector<std::string> ProjectRow(const std::vector<std::string> &row, const std::vector<std::string> &cells,
+        const std::vector<size_t> &selected, const std::vector<size_t> &widths) const;
+    static size_t IndexOf(const std::vector<std::string> &header, const std::string &column);
+    // offsets of the columns in the header line, if the header is one string.
+    static std::vector<size_t> GetColumnOffsets(const std::vector<std::string> &header);
+    // guessed is true for a row with more fields than columns divided among them by the offsets of the header.
+    static std::vector<std::string> SplitRow(const std::vector<std::string> &row, const std::vector<size_t> &offsets,
+        size_t columnCount, bool &guessed);
+    // start and end of each run of characters of line separated by at least minGap blanks.
+    static std::vector<std::pair<size_t, size_t>> SplitFields(const std::string &line, size_t minGap);
+    static bool IsPushedDown(const Predicate &predicate);
+    static bool MatchCell(const std::string &cell, const Predicate &predicate);
+    static bool IsSameCell(const std::string &cell, const std::string &value);
+    static int CompareCells(const std::string &first, const std::string &second);
+    static bool ToNumber(const std::string &str, double &number, bool whole);
+    static bool IsSameColumn(const std::string &first, const std::string &second);
+    static std::string Trim(const std::string &str);
+
+private:
+    std::string expr_;
+    size_t pos_ {0}; // of the parser in expr_
+    std::vector<std::string> columns_; // selected, empty for all
+    std::vector<Predicate> predicates_;
+    std::string sortColumn_;
+    bool sortDesc_ {false};
+    size_t limit_ {0}; // 0 for no limit
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // COLUMN_ROWS_QUERY_H
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_COMMAND_RUNNER_H
+#define HIDUMPER_COMMAND_RUNNER_H
+#include <functional>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include "common.h"
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Runs an external command without a shell and drains its stdout in large blocks.
+ * Every instance owns its own child and pipe, so independent commands can run concurrently.
+ * The child is killed once it writes nothing for the timeout while a read waits on it.
+ */
+class CommandRunner {
+public:
+    using LineHandler = std::function<bool(const std::string& line)>;
+    using CancelChecker = std::function<bool()>;
+
+    static constexpr int DEFAULT_TIMEOUT_MS = 60 * 1000;
+    static constexpr int NO_TIMEOUT = -1;
+
+    explicit CommandRunner(const std::string& cmd, int timeoutMs = DEFAULT_TIMEOUT_MS);
+    ~CommandRunner();
+    CommandRunner(const CommandRunner&) = delete;
+    CommandRunner& operator=(const CommandRunner&) = delete;
+
+    bool Start();
+    // read one block of stdout and pass every complete line in it to func.
+    DumpStatus ReadLines(const LineHandler& func, bool keepNewLine = false);
+    DumpStatus ReadAll(const LineHandler& func, bool keepNewLine = false, const CancelChecker& isCanceled = nullptr);
+    void Kill();
+    int Wait();
+
+    static bool Run(const std::string& cmd, const LineHandler& func, bool keepNewLine = false,
+        int timeoutMs = DEFAULT_TIMEOUT_MS);
+    static bool ParseCommand(const std::string& cmd, std::vector<std::string>& args);
+
+private:
+    int GetRemainTime() const;
+    bool DispatchLines(const char* data, size_t size, const LineHandler& func, bool keepNewLine);
+    void Release();
+
+private:
+    std::string cmd_;
+    int timeoutMs_;
+    int64_t deadline_ = 0;
+    pid_t pid_ = -1;
+    int readFd_ = -1;
+    bool eof_ = false;
+    std::string pending_;
+    std::vector<char> buffer_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_COMMAND_RUNNER_H
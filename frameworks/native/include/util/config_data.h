@@ -15,6 +15,7 @@
 #ifndef HIDUMPER_SERVICES_CONFIG_DATA_H
 #define HIDUMPER_SERVICES_CONFIG_DATA_H
 #include <string>
+#include <vector>
 namespace OHOS {
 namespace HiviewDFX {
 class ConfigData {
@@ -72,6 +73,20 @@ public:
     static const std::string STR_BASE;
     static const std::string STR_SERVICE;
     static const std::string STR_SYSTEM;
+    enum class MemberType {
+        DUMPER,
+        MINIGROUP,
+        INVALID,
+    };
+    struct GroupMember {
+        MemberType type_;
+        int index_; // index in dumpers_ or groups_, -1 if the name is not defined
+    };
+    // the first dumper or group defined with the name, -1 if not found.
+    static int FindDumperIndex(const std::string &name);
+    static int FindGroupIndex(const std::string &name);
+    // members of groups_[index] resolved to table indexes, in list order.
+    static const std::vector<GroupMember> &GetGroupMembers(int index);
 protected:
     struct ItemCfg {
         const std::string &name_;
@@ -103,6 +118,8 @@ protected:
     static const int dumperSum_;
     static const int NEST_MAX;
 private:
+    struct ConfigIndex;
+    static const ConfigIndex &GetConfigIndex();
     static const ItemCfg baseInfoDumper_[];
     static const ItemCfg versionDumper_[];
     static const ItemCfg kernelVersionDumper_[];
@@ -60,6 +60,7 @@ private:
     bool HandleDumpFaultLog(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
     bool HandleDumpAppendix(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
     bool HandleDumpIpcStat(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
+    bool HandleQueryFilter(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
     bool CopySmaps();
     DumpStatus GetConfig(const std::string &name, std::vector<std::shared_ptr<DumpCfg>> &result,
         std::shared_ptr<OptionArgs> args);
@@ -74,7 +75,7 @@ private:
     // Used for get section name from group name
     static std::string GetSectionName(const std::string &name);
 private:
-    DumpStatus GetGroupSimple(const GroupCfg& groupCfg, std::vector<std::shared_ptr<DumpCfg>> &result,
+    DumpStatus GetGroupSimple(int index, std::vector<std::shared_ptr<DumpCfg>> &result,
         std::shared_ptr<OptionArgs> args, int level = DumperConstant::NONE, int nest = 0);
     static DumpStatus GetGroupNames(const std::string &name, std::vector<std::string> &nameList);
     static void ConvertTreeToList(std::vector<std::shared_ptr<DumpCfg>> &tree,
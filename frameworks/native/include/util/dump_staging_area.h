@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_UTIL_DUMP_STAGING_AREA_H
+#define HIDUMPER_UTIL_DUMP_STAGING_AREA_H
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Holds the entries of one zip request before they are archived.
+ * Entries filled by Append live in anonymous memfd files or in a tmpfs folder while the memory limit allows,
+ * the rest goes to the disk folder of the request, which is archived as before.
+ * Entries written through an fd go to the disk folder from the start, what is written through an fd that
+ * may be handed on, to another process even, can not be counted against the limit.
+ */
+class DumpStagingArea {
+public:
+    enum class Backend {
+        MEMFD,
+        TMPFS,
+        DISK,
+    };
+    static constexpr int64_t DEFAULT_MEMORY_LIMIT = 32 * 1024 * 1024;
+
+    // tmpfsFolder is only used by the TMPFS backend, a folder that is not on tmpfs falls back to DISK.
+    DumpStagingArea(const std::string &diskFolder, Backend backend, int64_t memoryLimit = DEFAULT_MEMORY_LIMIT,
+        const std::string &tmpfsFolder = "");
+    ~DumpStagingArea();
+    DumpStagingArea(const DumpStagingArea &) = delete;
+    DumpStagingArea &operator=(const DumpStagingArea &) = delete;
+
+    Backend GetBackend() const;
+    const std::string &GetDiskFolder() const;
+    // appends data to the entry, an entry that would go over the memory limit moves to the disk folder first.
+    bool Append(const std::string &name, const std::string &data);
+    // returns a new fd writing at the end of the entry in the disk folder, -1 on failure.
+    // an entry held in memory moves to the disk folder first. the fd must be given back through CloseEntry.
+    int OpenEntry(const std::string &name);
+    void CloseEntry(int fd);
+    // entries held in memory as (fd, name), the fds stay owned by the area.
+    std::vector<std::pair<int, std::string>> GetMemoryEntries();
+    int64_t GetMemoryUsage();
+
+private:
+    struct Entry {
+        int fd {-1}; // memory file, -1 for an entry in the disk folder
+        int64_t size {0}; // bytes in the memory file
+    };
+    // inMemory: a new entry may be held in memory.
+    Entry &GetEntry(const std::string &name, bool inMemory);
+    int CreateMemoryFile(const std::string &name);
+    int OpenDiskFile(const std::string &name);
+    bool Spill(const std::string &name, Entry &entry);
+    bool CopyToDisk(int diskFd, const Entry &entry);
+    static void CloseFd(int fd);
+
+private:
+    std::string diskFolder_;
+    Backend backend_;
+    int64_t memoryLimit_;
+    std::string tmpfsFolder_;
+    std::mutex mutex_;
+    std::map<std::string, Entry> entries_;
+    int64_t memoryUsage_ {0};
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_UTIL_DUMP_STAGING_AREA_H
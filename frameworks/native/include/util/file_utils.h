@@ -14,7 +14,11 @@
 */
 #ifndef FILE_UTILS_H
 #define FILE_UTILS_H
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 #include "dump_utils.h"
 #include "singleton.h"
 #include "string_utils.h"
@@ -32,7 +36,27 @@ public:
     bool LoadStringFromProcCb(const std::string& path, bool oneLine, bool lineEndWithN, const DataHandler& func);
     std::string GetProcValue(const int32_t &pid, const std::string& path, const std::string& key);
     bool GetLastWriteTime(const std::string &path, time_t& lastWriteTime);
+    /**
+     * Copy a proc file with large reads, the buffer grows while a read fills it up.
+     * A partial copy is removed, e.g. the process exits while its file is read.
+     *
+     * @param buffer, read buffer kept by the caller across files.
+     * @return int64_t, bytes copied, -1 on failure.
+     */
+    int64_t CopyProcFile(const std::string& src, const std::string& des, std::vector<char>& buffer);
+    /**
+     * The folder the /proc and /sys files are read under, empty for the real ones.
+     * A test or benchmark points it at a generated fixture tree.
+     */
+    void SetProcRoot(const std::string& root);
+    std::string GetProcRoot();
+    // path is an absolute /proc or /sys path, such as /proc/1/smaps. read without a lock, it runs per proc file.
+    std::string GetProcPath(const std::string& path);
 private:
+    std::mutex procRootMutex_; // for the writers only
+    // every root set is kept in procRoots_ until exit, so a reader never holds a freed one. nullptr for none.
+    std::atomic<const std::string *> procRoot_ {nullptr};
+    std::vector<std::unique_ptr<std::string>> procRoots_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_TEXT_SANITIZER_H
+#define HIDUMPER_TEXT_SANITIZER_H
+#include <cstddef>
+#include <string>
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Scrubs the terminal control characters out of command output: CR and LF are dropped, and so is an escape
+ * sequence from ESC '[' up to its final letter. Clean blocks are skipped 16 bytes at a time with SSE2, or 32 bytes
+ * with NEON, only the bytes after the first dirty one are moved.
+ */
+class TextSanitizer {
+public:
+    // the offset of the first CR, LF or ESC in data, size if there is none.
+    static size_t FindDirty(const char *data, size_t size);
+    static bool IsClean(const std::string &str);
+    // scrubs str in place, a clean str is not written.
+    static void Sanitize(std::string &str);
+    // appends the scrubbed data to out, it is the copy of data into out.
+    static void SanitizeAppend(const char *data, size_t size, std::string &out);
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_TEXT_SANITIZER_H
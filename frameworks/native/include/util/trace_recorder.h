@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_UTIL_TRACE_RECORDER_H
+#define HIDUMPER_UTIL_TRACE_RECORDER_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Records the spans of one dump into per-thread buffers and renders them as a Chrome trace event JSON.
+ * A thread appends to its own buffer without locks, the buffers are only read once the session stops.
+ * One session runs at a time, the spans of concurrent requests land in the same session.
+ */
+class TraceRecorder {
+public:
+    static bool IsEnabled()
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+    // false if a session is already running.
+    static bool Start();
+    // stops the session and returns its trace, "" if no session is running.
+    static std::string Stop();
+    static uint64_t NowUs();
+    // detail is copied and truncated, the category and name must be string literals.
+    static void Record(const char *category, const char *name, const std::string *detail, uint64_t beginUs,
+        uint64_t endUs);
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+/**
+ * Records the scope it lives in as a complete event. While no session runs it costs a relaxed load and a branch,
+ * the destructor only tests the begin time the constructor left.
+ */
+class TraceSpan {
+public:
+    TraceSpan(const char *category, const char *name, const std::string *detail = nullptr)
+        : category_(category), name_(name), detail_(detail)
+    {
+        if (TraceRecorder::IsEnabled()) {
+            beginUs_ = TraceRecorder::NowUs();
+        }
+    }
+    ~TraceSpan()
+    {
+        if (beginUs_ != 0) {
+            TraceRecorder::Record(category_, name_, detail_, beginUs_, TraceRecorder::NowUs());
+        }
+    }
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    const char *category_;
+    const char *name_;
+    const std::string *detail_; // must outlive the span
+    uint64_t beginUs_ {0};
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_UTIL_TRACE_RECORDER_H
@@ -33,21 +33,34 @@ public:
     // zipItems: first:absolutePath, second:relativePath
     bool Write(const std::vector<std::pair<std::string, std::string>> &zipItems,
         const ZipTickNotify notify = nullptr);
+    // fdItems: first:fd read from offset 0 and left open, second:relativePath
+    bool Write(const std::vector<std::pair<std::string, std::string>> &zipItems,
+        const std::vector<std::pair<int, std::string>> &fdItems, const ZipTickNotify notify = nullptr);
+    // source of one entry, the file at absolutePath or fd when it is valid.
+    struct ZipSource {
+        std::string absolutePath;
+        int fd;
+        std::string relativePath;
+    };
 private:
+    // compression of one entry, chosen by the name and the size of its source file.
+    struct EntryPolicy {
+        int method;
+        int level;
+    };
     bool FlushItems(const ZipTickNotify notify = nullptr);
+    static EntryPolicy GetEntryPolicy(const std::string &path, int64_t size);
     static bool SetTimeToZipFileInfo(zip_fileinfo &zipInfo);
     static zipFile OpenForZipping(const std::string &fileName, int append);
-    static bool ZipOpenNewFileInZip(zipFile zip_file, const std::string &strPath);
-    static bool AddFileContentToZip(zipFile zip_file, std::string &file_path);
-    static bool OpenNewFileEntry(zipFile zip_file, std::string &path);
+    static bool ZipOpenNewFileInZip(zipFile zip_file, const std::string &strPath, const EntryPolicy &policy);
+    static bool OpenNewFileEntry(zipFile zip_file, std::string &path, const EntryPolicy &policy);
     static bool CloseNewFileEntry(zipFile zip_file);
-    static bool AddFileEntryToZip(zipFile zip_file, std::string &relativePath, std::string &absolutePath);
 private:
-    std::vector<std::pair<std::string, std::string>> zipItems_;
+    std::vector<ZipSource> zipItems_;
     std::string zipFilePath_;
     zipFile zipFile_;
 #ifdef DUMP_TEST_MODE // for mock test
-    FRIEND_TEST(HidumperConfigUtilsTest, HidumperZipWriter001);
+    FRIEND_TEST(HidumperConfigUtilsTest, HidumperZipWriter003);
 #endif // for mock test
 };
 } // namespace HiviewDFX
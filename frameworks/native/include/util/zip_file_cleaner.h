@@ -26,6 +26,10 @@ constexpr int BYTES_PER_KB = 1024;
 constexpr int BYTES_PER_MB = 1024 * 1024;
 constexpr int ZIP_FILE_EXT_LEN = 4;
 constexpr int LOGFILE_MAX = 20;
+// the traces of --trace dumps next to the zips have their own limits, so they never evict a zip.
+constexpr int TRACEFILE_MAX = 10;
+constexpr int64_t TRACE_MAX_SIZE = 20 * BYTES_PER_MB;
+constexpr int64_t TRACE_TARGET_SIZE = 16 * BYTES_PER_MB;
 
 struct FileInfo {
     std::string path;
@@ -38,8 +42,10 @@ public:
     static bool CleanOldFiles(const std::string &dirPath);
 
 private:
-    static int64_t GetDirTotalSize(const std::string &dirPath, std::vector<FileInfo>& files);
-    static bool DeleteOldestFiles(int64_t totalSize, std::vector<FileInfo>& files);
+    static bool CleanFiles(const std::string &dirPath, bool isTrace);
+    static int64_t GetDirTotalSize(const std::string &dirPath, std::vector<FileInfo>& files, bool isTrace = false);
+    static bool DeleteOldestFiles(int64_t totalSize, std::vector<FileInfo>& files, bool isTrace = false);
+    static bool IsTraceFile(const std::string &fileName);
 };
 
 } // namespace HiviewDFX
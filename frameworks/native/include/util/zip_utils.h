@@ -15,6 +15,7 @@
 #ifndef HIDUMPER_UTIL_ZIP_H
 #define HIDUMPER_UTIL_ZIP_H
 #include <string>
+#include <vector>
 #include "util/zip/zip_common_type.h"
 namespace OHOS {
 namespace HiviewDFX {
@@ -24,8 +25,9 @@ public:
     // srcPath = /data/local/tmp/zipdata/
     // dstFile = /data/local/tmp/result/result.zip
     // notify : zip progress notify, default is nullptr.
+    // fdItems : entries staged outside srcPath, first:fd, second:relativePath
     static bool ZipFolder(const std::string &srcPath, const std::string &dstFile,
-        const ZipTickNotify notify = nullptr);
+        const ZipTickNotify notify = nullptr, const std::vector<std::pair<int, std::string>> &fdItems = {});
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -46,6 +46,7 @@ static struct option LONG_OPTIONS[] = {
     {"net", no_argument, 0, 0},
     {"storage", no_argument, 0, 0},
     {"zip", no_argument, 0, 0},
+    {"trace", no_argument, 0, 0},
     {"mem-smaps", required_argument, 0, 0},
     {"mem-jsheap", required_argument, 0, 0},
     {"gc", no_argument, 0, 0},
@@ -282,6 +283,7 @@ bool CmdParse::ParseSubLongCmdOption(int argc, DumpContext& dumpContext,
     } else if (optionName == "storage") {
         dumpContext.GetDumperOpts()->isDumpStorage = true;
     } else if (optionName == "zip") {
+    } else if (optionName == "trace") { // the trace session is run by DumpImplement
     } else {
         return false;
     }
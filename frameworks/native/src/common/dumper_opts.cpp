@@ -23,6 +23,7 @@
 #include "dump_utils.h"
 #include "hilog_wrapper.h"
 #include "string_ex.h"
+#include "util/column_rows_query.h"
 #include "util/config_data.h"
 #include "util/config_utils.h"
 namespace OHOS {
@@ -63,6 +64,7 @@ void DumperOpts::ResetMemOptions()
     isDumpMem_ = false;
     isReceivedSigInt_ = false;
     dumpMemPrune_ = false;
+    memTopN_ = 0;
     showAshmem_ = false;
     showDmaBuf_ = false;
     showGpumem_ = false;
@@ -155,6 +157,9 @@ void DumperOpts::ResetMiscOptions()
     isDumpService_ = false;
     isFaultLog_ = false;
     path_.clear(); // for zip
+    isMachineProgress_ = false;
+    query_.clear();
+    isTrace_ = false;
     isAppendix_ = false;
     isShowSmaps_ = false;
     isShowSmapsInfo_ = false;
@@ -196,6 +201,7 @@ void DumperOpts::AssignMemOptions(const DumperOpts& opts)
     timeInterval_ = opts.timeInterval_;
     memPid_ = opts.memPid_;
     dumpMemPrune_ = opts.dumpMemPrune_;
+    memTopN_ = opts.memTopN_;
     showAshmem_ = opts.showAshmem_;
     showDmaBuf_ = opts.showDmaBuf_;
     showGpumem_ = opts.showGpumem_;
@@ -290,6 +296,9 @@ void DumperOpts::AssignMiscOptions(const DumperOpts& opts)
     isDumpService_ = opts.isDumpService_;
     isFaultLog_ = opts.isFaultLog_;
     path_ = opts.path_;
+    isMachineProgress_ = opts.isMachineProgress_;
+    query_ = opts.query_;
+    isTrace_ = opts.isTrace_;
     isAppendix_ = opts.isAppendix_;
     threadId_ = opts.threadId_;
     isDumpFd_ = opts.isDumpFd_;
@@ -414,6 +423,23 @@ bool DumperOpts::CheckOptions(std::string& errStr) const
         errStr = "--list and --detail cannot be used together";
         return false;
     }
+    if ((memTopN_ > 0) && (memPid_ >= 0)) {
+        errStr = "--top cannot be used with pid";
+        return false;
+    }
+    if (isMachineProgress_ && path_.empty()) {
+        errStr = "--machine-progress needs --zip";
+        return false;
+    }
+    ColumnRowsQuery query;
+    if (!query_.empty() && !query.Parse(query_, errStr)) {
+        return false;
+    }
+    // the process table of --mem is written while it is collected, only its process filter can apply.
+    if (!query_.empty() && isDumpMem_ && (memPid_ < 0) && !query.IsProcessFilterOnly()) {
+        errStr = "--query of --mem only takes where PID ==/in, Pss >/>= and Name ==/~ predicates";
+        return false;
+    }
     if (isDumpFd_ && isDumpThread_) {
         errStr = "--fd and --thread cannot be used together";
         return false;
@@ -20,16 +20,12 @@
 namespace OHOS {
 namespace HiviewDFX {
 const std::string CMD_PREFIX = "/system/bin/";
-CMDDumper::CMDDumper() : fp_(nullptr)
+CMDDumper::CMDDumper()
 {
 }
 
 CMDDumper::~CMDDumper()
 {
-    if (fp_ != nullptr) {
-        pclose(fp_);
-        fp_ = nullptr;
-    }
 }
 
 DumpStatus CMDDumper::PreExecute(const std::shared_ptr<DumperParameter>& parameter,
@@ -54,8 +50,10 @@ DumpStatus CMDDumper::PreExecute(const std::shared_ptr<DumperParameter>& paramet
     }
     cmd_ = cmd;
     needLoop_ = (ptrDumpCfg_->loop_ == DumperConstant::LOOP);
-    if (fp_ == nullptr) {
-        if ((fp_ = popen((CMD_PREFIX + cmd_).c_str(), "r")) == nullptr) {
+    if (runner_ == nullptr) {
+        runner_ = std::make_unique<CommandRunner>(CMD_PREFIX + cmd_);
+        if (!runner_->Start()) {
+            runner_ = nullptr;
             return DumpStatus::DUMP_FAIL;
         }
     }
@@ -76,12 +74,14 @@ DumpStatus CMDDumper::Execute()
     DUMPER_HILOGI(MODULE_COMMON, "info|CMDDumper Execute");
     DumpStatus ret = DumpStatus::DUMP_OK;
     if (needLoop_) {
-        // cmd dump one line
+        // cmd dump one block of lines
         return ReadLineInCmd();
     } else {
         // cmd dump all line
         do {
             if (IsCanceled()) {
+                runner_->Kill();
+                moreData_ = false;
                 break;
             }
             ret = ReadLineInCmd();
@@ -94,10 +94,7 @@ DumpStatus CMDDumper::Execute()
 DumpStatus CMDDumper::AfterExecute()
 {
     if (!moreData_) {
-        if (fp_ != nullptr) {
-            pclose(fp_);
-            fp_ = nullptr;
-        }
+        runner_ = nullptr;
         return DumpStatus::DUMP_OK;
     }
     return DumpStatus::DUMP_MORE_DATA;
@@ -106,54 +103,26 @@ DumpStatus CMDDumper::AfterExecute()
 // provide interface to others
 DumpStatus CMDDumper::GetCmdInterface(const std::string& cmd, StringMatrix dumpDatas)
 {
-    DumpStatus ret = DumpStatus::DUMP_MORE_DATA;
-    FILE* fp = popen((CMD_PREFIX + cmd).c_str(), "r");
-    if (fp == nullptr) {
+    CommandRunner runner(CMD_PREFIX + cmd);
+    if (!runner.Start()) {
         return DumpStatus::DUMP_FAIL;
     }
-    do {
-        ret = GetLineData(fp, dumpDatas);
-    } while (ret == DumpStatus::DUMP_MORE_DATA);
-    pclose(fp);
-    return ret;
-}
-
-DumpStatus CMDDumper::GetLineData(FILE* fp, StringMatrix dumpDatas)
-{
-    DumpStatus ret = DumpStatus::DUMP_MORE_DATA;
-    char* line_buffer = nullptr;
-    size_t len = 0;
-    ssize_t read = 0;
-    read = getline(&line_buffer, &len, fp);
-    if (read > 0) {
-        if (line_buffer[read - 1] == '\n') {
-            line_buffer[read - 1] = '\0'; // replease \n
-        }
-        std::string line = line_buffer;
-        std::vector<std::string> line_vector;
-        line_vector.push_back(line);
-        dumpDatas->push_back(line_vector);
-    } else {
-        if (feof(fp) == 0) { // ferror()
-            ret = DumpStatus::DUMP_FAIL;
-        } else {
-            ret = DumpStatus::DUMP_OK;
-        }
-    }
-    if (line_buffer != nullptr) {
-        free(line_buffer);
-        line_buffer = nullptr;
-    }
-    return ret;
+    return runner.ReadAll([&dumpDatas](const std::string& line) {
+        dumpDatas->push_back({line});
+        return true;
+    });
 }
 
-// read one line
+// read all complete lines of one block
 DumpStatus CMDDumper::ReadLineInCmd()
 {
-    if (fp_ == nullptr) {
+    if (runner_ == nullptr) {
         return DumpStatus::DUMP_FAIL;
     }
-    DumpStatus ret = GetLineData(fp_, dumpDatas_);
+    DumpStatus ret = runner_->ReadLines([this](const std::string& line) {
+        dumpDatas_->push_back({line});
+        return true;
+    });
     moreData_ = (ret == DumpStatus::DUMP_MORE_DATA);
     return ret;
 }
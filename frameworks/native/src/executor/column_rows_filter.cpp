@@ -23,26 +23,35 @@ ColumnRowsFilter::ColumnRowsFilter()
 
 ColumnRowsFilter::~ColumnRowsFilter()
 {
+    dumpDatas_ = nullptr;
 }
 
 DumpStatus ColumnRowsFilter::PreExecute(const std::shared_ptr<DumperParameter>& parameter,
     StringMatrix dumpDatas)
 {
+    dumpDatas_ = dumpDatas;
+    std::string errStr;
+    if (!query_.Parse(parameter->GetOpts().query_, errStr)) {
+        DUMPER_HILOGE(MODULE_COMMON, "parse query failed, %{public}s", errStr.c_str());
+        return DumpStatus::DUMP_FAIL;
+    }
     return DumpStatus::DUMP_OK;
 }
 
 DumpStatus ColumnRowsFilter::Execute()
 {
+    if (dumpDatas_ == nullptr) {
+        return DumpStatus::DUMP_FAIL;
+    }
+    size_t tables = query_.Apply(*dumpDatas_);
+    DUMPER_HILOGD(MODULE_COMMON, "debug|query matched %{public}zu tables", tables);
     return DumpStatus::DUMP_OK;
 }
 
 DumpStatus ColumnRowsFilter::AfterExecute()
 {
+    dumpDatas_ = nullptr;
     return DumpStatus::DUMP_OK;
 }
-
-void ColumnRowsFilter::GetRuleTable()
-{
-}
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -47,13 +47,11 @@ DumpStatus CPUDumper::Execute()
         DumpCpuData dumpData = GetDumpCpuData();
         dumpManagerCpuClient.Request(dumpData);
         dumpCPUDatas_->clear();
-        for (auto it = dumpData.dumpCPUDatas_.begin(); it != dumpData.dumpCPUDatas_.end(); it++) {
-            std::vector<std::string> strVec;
-            for (auto str = it->begin(); str != it->end(); str++) {
-                strVec.push_back(*str);
-            }
-            dumpCPUDatas_->push_back(strVec);
+        dumpCPUDatas_->reserve(dumpData.dumpCPUDatas_.size() + dumpData.procRecords_.size());
+        for (auto &line : dumpData.dumpCPUDatas_) {
+            dumpCPUDatas_->push_back(std::move(line));
         }
+        dumpData.FormatProcRecords(*dumpCPUDatas_);
         return DumpStatus::DUMP_OK;
     } else {
         return DumpStatus::DUMP_FAIL;
@@ -14,6 +14,8 @@
  */
 
 #include "executor/event/dump_event_info.h"
+#include <atomic>
+#include <future>
 #include "hilog_wrapper.h"
 #include "util/string_utils.h"
 using namespace std;
@@ -21,6 +23,7 @@ namespace OHOS {
 namespace HiviewDFX {
 
 constexpr int TIMEOUT_PERIOD = 5; // seconds
+constexpr long long FAULT_LEAD_TIME_MS = 10 * 60 * 1000; // the longest a fault is reported before its kill
 
 DumpEventInfo::DumpEventInfo()
 {
@@ -35,6 +38,10 @@ static const std::unordered_set<std::string> FAULTEVENTSET = {
     "JsError", "CppCrash", "ThreadBlock6S", "AppInputBlock", "LifecycleTimeout"
 };
 
+static const std::unordered_set<std::string> FAULTQUERYSET = {
+    "CPP_CRASH", "JS_ERROR", "SYS_FREEZE", "APP_FREEZE"
+};
+
 bool DumpEventInfo::DumpEventList(std::vector<HiSysEventRecord> &events, EventQueryParam &param, bool isSort)
 {
     long long startTime = param.startTime_ == 0 ? -1 : param.startTime_;
@@ -44,7 +51,7 @@ bool DumpEventInfo::DumpEventList(std::vector<HiSysEventRecord> &events, EventQu
     for (const auto &[domain, eventList] : param.queryRule) {
         queryRules.emplace_back(domain, eventList);
     }
-    auto queryCallback = std::make_shared<EventQueryCallback>();
+    auto queryCallback = std::make_shared<EventQueryCallback>(param.limit_, param.filter_);
     int ret = HiSysEventManager::Query(arg, queryRules, queryCallback);
     if (ret != 0 && ret != -ENFILE) {
         DUMPER_HILOGE(MODULE_SERVICE, "DumpEventList Query failed, ret:%{public}d", ret);
@@ -69,42 +76,83 @@ bool DumpEventInfo::DumpEventList(std::vector<HiSysEventRecord> &events, EventQu
 
 EventDumpResult DumpEventInfo::DumpFaultEventListByPK(std::vector<HiSysEventRecord> &events, EventQueryParam &param)
 {
+    // a fault comes shortly before the kill it causes, so a pk query with a start time bounds the faults that
+    // can match it, and those are queried alongside it before the fault types are known.
+    // without a start time the faults of the needed types are queried once the processkill events are in.
+    std::atomic<bool> faultIgnored {false};
+    auto faultFilter = [&faultIgnored](const HiSysEventRecord &event) {
+        std::string runningId;
+        return !faultIgnored && event.GetParamValue("APP_RUNNING_UNIQUE_ID", runningId) == 0;
+    };
+    EventQueryParam faultParam;
+    std::vector<HiSysEventRecord> faultEvents;
+    std::future<bool> faultQuery;
+    if (param.startTime_ > 0) {
+        FillQueryParam(faultParam, FAULTQUERYSET);
+        faultParam.startTime_ = std::max(param.startTime_ - FAULT_LEAD_TIME_MS, 1LL);
+        faultParam.endTime_ = param.endTime_;
+        faultParam.filter_ = faultFilter;
+        faultQuery = std::async(std::launch::async, [this, &faultParam, &faultEvents] {
+            return DumpEventList(faultEvents, faultParam);
+        });
+    }
+
     std::vector<HiSysEventRecord> pkEvents;
     param.queryRule = {
         {"FRAMEWORK", {"PROCESS_KILL"}},
         {"KERNEL_VENDOR", {"PROCESS_KILL"}}
     };
+    std::unordered_set<std::string> faultEventQuerySet;
+    std::unordered_set<std::string> pkRunningIdSet;
+    EventDumpResult eventResult = EventDumpResult::EVENT_DUMP_FAIL;
     if (!DumpEventList(pkEvents, param)) {
         DUMPER_HILOGE(MODULE_SERVICE, "DumpFaultEventListByPK dump processkill events failed");
-        return EventDumpResult::EVENT_DUMP_FAIL;
-    }
-    if (pkEvents.empty()) {
-        return EventDumpResult::NONE_PROCESSKILL_EVENT;
+    } else if (pkEvents.empty()) {
+        eventResult = EventDumpResult::NONE_PROCESSKILL_EVENT;
+    } else {
+        eventResult = ExtractPkRunningIdsAndFaultTypes(pkEvents, pkRunningIdSet, faultEventQuerySet, param);
+        if (eventResult != EventDumpResult::EVENT_DUMP_OK) {
+            DUMPER_HILOGW(MODULE_SERVICE, "Match fault events failed");
+        }
     }
-    std::unordered_set<std::string> faultEventQuerySet;
-    std::unordered_set<std::string> pkRunningIdSet;
-    auto eventResult = ExtractPkRunningIdsAndFaultTypes(pkEvents, pkRunningIdSet, faultEventQuerySet, param);
     if (eventResult != EventDumpResult::EVENT_DUMP_OK) {
-        DUMPER_HILOGW(MODULE_SERVICE, "Match fault events failed");
+        // the query in flight can not be cancelled, the rest of its events are dropped by the filter.
+        faultIgnored = true;
         return eventResult;
     }
 
-    FillQueryParam(param, faultEventQuerySet);
-
-    std::vector<HiSysEventRecord> faultEvents;
-    if (!DumpEventList(faultEvents, param)) {
+    bool faultSuccess = false;
+    if (faultQuery.valid()) {
+        faultSuccess = faultQuery.get();
+    } else {
+        FillQueryParam(faultParam, faultEventQuerySet);
+        faultParam.filter_ = faultFilter;
+        faultSuccess = DumpEventList(faultEvents, faultParam);
+    }
+    if (!faultSuccess) {
         DUMPER_HILOGE(MODULE_SERVICE, "DumpFaultEventListByPK dump fault events failed");
         return EventDumpResult::EVENT_DUMP_FAIL;
     }
+    MatchFaultEvents(faultEvents, pkRunningIdSet, faultEventQuerySet, events);
+    SortEventsByTimeDesc(events);
+    return EventDumpResult::EVENT_DUMP_OK;
+}
+
+void DumpEventInfo::MatchFaultEvents(const std::vector<HiSysEventRecord> &faultEvents,
+                                     const std::unordered_set<std::string> &pkRunningIdSet,
+                                     const std::unordered_set<std::string> &faultEventQuerySet,
+                                     std::vector<HiSysEventRecord> &events)
+{
     for (const auto &event : faultEvents) {
         std::string runningId;
+        std::string eventName;
         if (event.GetParamValue("APP_RUNNING_UNIQUE_ID", runningId) == 0 &&
-            pkRunningIdSet.find(runningId) != pkRunningIdSet.end()) {
+            pkRunningIdSet.find(runningId) != pkRunningIdSet.end() &&
+            event.GetParamValue("name_", eventName) == 0 &&
+            faultEventQuerySet.find(eventName) != faultEventQuerySet.end()) {
             events.emplace_back(event);
         }
     }
-    SortEventsByTimeDesc(events);
-    return EventDumpResult::EVENT_DUMP_OK;
 }
 
 EventDumpResult DumpEventInfo::ExtractPkRunningIdsAndFaultTypes(const std::vector<HiSysEventRecord> &pkEvents,
@@ -14,15 +14,29 @@
  */
 
 #include "executor/event/event_query_callback.h"
+#include <algorithm>
 #include "hilog_wrapper.h"
 
 using namespace std;
 namespace OHOS {
 namespace HiviewDFX {
+namespace {
+// orders the heap with the oldest kept event on top, sort_heap then leaves the newest first.
+bool IsNewer(const HiSysEventRecord &a, const HiSysEventRecord &b)
+{
+    return a.GetTime() > b.GetTime();
+}
+} // namespace
+
 EventQueryCallback::EventQueryCallback() : completed_(false), reason_(-1)
 {
 }
 
+EventQueryCallback::EventQueryCallback(size_t limit, const EventFilter &filter)
+    : completed_(false), reason_(-1), limit_(limit), filter_(filter)
+{
+}
+
 EventQueryCallback::~EventQueryCallback()
 {
 }
@@ -33,7 +47,35 @@ void EventQueryCallback::OnQuery(std::shared_ptr<std::vector<HiSysEventRecord>>
         return;
     }
     std::lock_guard<std::mutex> lock(mutex_);
-    events_.insert(events_.end(), sysEvents->begin(), sysEvents->end());
+    if (limit_ == 0 && filter_ == nullptr) {
+        events_.insert(events_.end(), sysEvents->begin(), sysEvents->end());
+        return;
+    }
+    for (const auto &event : *sysEvents) {
+        if (filter_ != nullptr && !filter_(event)) {
+            continue;
+        }
+        if (limit_ == 0) {
+            events_.emplace_back(event);
+        } else {
+            PushLimited(event);
+        }
+    }
+}
+
+void EventQueryCallback::PushLimited(const HiSysEventRecord &event)
+{
+    if (events_.size() < limit_) {
+        events_.emplace_back(event);
+        std::push_heap(events_.begin(), events_.end(), IsNewer);
+        return;
+    }
+    if (!IsNewer(event, events_.front())) {
+        return;
+    }
+    std::pop_heap(events_.begin(), events_.end(), IsNewer);
+    events_.back() = event;
+    std::push_heap(events_.begin(), events_.end(), IsNewer);
 }
 
 void EventQueryCallback::OnComplete(int32_t reason, int32_t total)
@@ -53,7 +95,12 @@ bool EventQueryCallback::WaitForComplete(std::chrono::milliseconds timeout)
 std::vector<HiSysEventRecord> EventQueryCallback::GetEvents()
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    return events_;
+    if (limit_ == 0) {
+        return events_;
+    }
+    std::vector<HiSysEventRecord> events = events_;
+    std::sort_heap(events.begin(), events.end(), IsNewer);
+    return events;
 }
 
 int32_t EventQueryCallback::GetReason()
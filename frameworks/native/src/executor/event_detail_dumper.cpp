@@ -13,13 +13,23 @@
  * limitations under the License.
  */
 #include "executor/event_detail_dumper.h"
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/sendfile.h>
 #include "dump_utils.h"
 #include "common/dumper_constant.h"
 
 using namespace std;
 namespace OHOS {
 namespace HiviewDFX {
-EventDetailDumper::EventDetailDumper() : startTime_(0), endTime_(0), showEventCount_(-1), fp_(nullptr), fd_(-1)
+namespace {
+constexpr size_t READ_BLOCK_SIZE = 64 * 1024;
+constexpr size_t SEND_FILE_SIZE = 1024 * 1024;
+}
+
+EventDetailDumper::EventDetailDumper()
+    : startTime_(0), endTime_(0), showEventCount_(-1), fd_(-1), nextFd_(-1), outputFd_(-1)
 {
 }
 
@@ -42,6 +52,7 @@ DumpStatus EventDetailDumper::PreExecute(const shared_ptr<DumperParameter> &para
         endTime_ = 0;
     }
     dumpDatas_ = dumpDatas;
+    outputFd_ = GetDirectOutputFd(parameter);
     return DumpStatus::DUMP_OK;
 }
 
@@ -108,7 +119,8 @@ std::vector<std::string> EventDetailDumper::FilterLogPaths()
 
 void EventDetailDumper::ReadLogsByPaths(const std::vector<std::string> &logPaths)
 {
-    for (const auto &path : logPaths) {
+    for (size_t i = 0; i < logPaths.size(); i++) {
+        const auto &path = logPaths[i];
         std::vector<std::string> lineVectorBlank;
         lineVectorBlank.push_back("");
         std::vector<std::string> groupTitle;
@@ -121,59 +133,113 @@ void EventDetailDumper::ReadLogsByPaths(const std::vector<std::string> &logPaths
         dumpDatas_->push_back(lineVectorFilename);
         dumpDatas_->push_back(lineVectorBlank);
 
-        ReadSingleLogFile(path);
+        OpenLogFile(path);
+        if ((i + 1) < logPaths.size()) {
+            PrefetchLogFile(logPaths[i + 1]); // the readahead of the next log runs while this one is read
+        }
+        ReadOpenedLogFile();
 
         if (IsCanceled()) {
             break;
         }
     }
+    if (outputFd_ >= 0) {
+        FlushDumpDatas(dumpDatas_, outputFd_);
+    }
 }
 
-void EventDetailDumper::ReadSingleLogFile(const std::string &path)
+void EventDetailDumper::PrefetchLogFile(const std::string &path)
 {
-    CloseFd();
+    CloseFd(nextFd_);
+    nextFd_ = DumpUtils::FdToRead(path);
+    if (nextFd_ >= 0) {
+        nextPath_ = path;
+        (void)posix_fadvise(nextFd_, 0, 0, POSIX_FADV_WILLNEED);
+    }
+}
 
-    fd_ = DumpUtils::FdToRead(path);
+void EventDetailDumper::OpenLogFile(const std::string &path)
+{
+    CloseFd(fd_);
+    if (nextFd_ >= 0 && nextPath_ == path) {
+        fd_ = nextFd_;
+        nextFd_ = -1;
+    } else {
+        fd_ = DumpUtils::FdToRead(path);
+    }
+}
+
+void EventDetailDumper::ReadOpenedLogFile()
+{
     if (fd_ == -1) {
         std::vector<std::string> expiryNote;
         expiryNote.emplace_back("The faultlog has been deleted by the system due to expiration.");
         dumpDatas_->push_back(expiryNote);
         return;
     }
-    fp_ = fdopen(fd_, "r");
-    if (fp_ == nullptr) {
-        DUMPER_HILOGE(MODULE_COMMON, "logPaths fdopen failed");
-        fdsan_exchange_owner_tag(fd_, 0, FDTAG);
-        fdsan_close_with_tag(fd_, FDTAG);
-        fd_ = -1;
-        return;
+    if (outputFd_ >= 0) {
+        SendFdToOutput();
+    } else {
+        ReadLinesFromFd();
     }
+}
 
-    char* lineBuffer = nullptr;
-    size_t len = 0;
-    ssize_t read = 0;
-
+void EventDetailDumper::SendFdToOutput()
+{
+    // the section header goes first, then the log moves from fd to fd without a user space copy
+    FlushDumpDatas(dumpDatas_, outputFd_);
+    bool endWithNewLine = true;
     while (!IsCanceled()) {
-        read = getline(&lineBuffer, &len, fp_);
-        if (read <= 0) {
-            if (feof(fp_) == 0) {
-                DUMPER_HILOGE(MODULE_COMMON, "logPaths getline failed");
+        ssize_t sent = TEMP_FAILURE_RETRY(sendfile(outputFd_, fd_, nullptr, SEND_FILE_SIZE));
+        if (sent < 0 && (errno == EINVAL || errno == ENOSYS)) {
+            ReadLinesFromFd();
+            return;
+        }
+        if (sent <= 0) {
+            if (sent < 0) {
+                DUMPER_HILOGE(MODULE_COMMON, "logPaths sendfile failed, errno: %{public}d", errno);
             }
             break;
         }
-
-        if (lineBuffer[read - 1] == '\n') {
-            lineBuffer[read - 1] = '\0';
+        char lastChar = '\0';
+        off_t offset = lseek(fd_, 0, SEEK_CUR);
+        if (offset > 0 && pread(fd_, &lastChar, 1, offset - 1) == 1) {
+            endWithNewLine = (lastChar == '\n');
         }
-        std::string line = lineBuffer;
-        std::vector<std::string> lineVector;
-        lineVector.push_back(line);
-        dumpDatas_->push_back(lineVector);
     }
+    if (!endWithNewLine) {
+        WriteAll(outputFd_, "\n", 1);
+    }
+}
 
-    if (lineBuffer != nullptr) {
-        free(lineBuffer);
-        lineBuffer = nullptr;
+void EventDetailDumper::ReadLinesFromFd()
+{
+    std::vector<char> buffer(READ_BLOCK_SIZE);
+    std::string pending;
+    while (!IsCanceled()) {
+        ssize_t readLen = TEMP_FAILURE_RETRY(read(fd_, buffer.data(), buffer.size()));
+        if (readLen <= 0) {
+            if (readLen < 0) {
+                DUMPER_HILOGE(MODULE_COMMON, "logPaths read failed, errno: %{public}d", errno);
+            }
+            break;
+        }
+        const char* end = buffer.data() + readLen;
+        const char* lineStart = buffer.data();
+        while (lineStart < end) {
+            const char* lineEnd = static_cast<const char*>(memchr(lineStart, '\n', end - lineStart));
+            if (lineEnd == nullptr) {
+                pending.append(lineStart, end);
+                break;
+            }
+            pending.append(lineStart, lineEnd);
+            dumpDatas_->push_back({pending});
+            pending.clear();
+            lineStart = lineEnd + 1;
+        }
+    }
+    if (!pending.empty()) {
+        dumpDatas_->push_back({pending});
     }
 }
 
@@ -185,15 +251,17 @@ DumpStatus EventDetailDumper::AfterExecute()
 
 void EventDetailDumper::CloseFd()
 {
-    if (fp_ != nullptr) {
-        fclose(fp_);
-        fp_ = nullptr;
-        fd_ = -1;
-    } else if (fd_ >= 0) {
-        fdsan_exchange_owner_tag(fd_, 0, FDTAG);
-        fdsan_close_with_tag(fd_, FDTAG);
-        fd_ = -1;
-    }
-};
+    CloseFd(fd_);
+    CloseFd(nextFd_);
+}
+
+void EventDetailDumper::CloseFd(int &fd)
+{
+    if (fd >= 0) {
+        fdsan_exchange_owner_tag(fd, 0, FDTAG);
+        fdsan_close_with_tag(fd, FDTAG);
+        fd = -1;
+    }
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
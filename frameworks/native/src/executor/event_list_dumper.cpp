@@ -99,6 +99,13 @@ bool EventListDumper::QueryEvents()
         {"FRAMEWORK", {"PROCESS_KILL"}},
         {"KERNEL_VENDOR", {"PROCESS_KILL"}}
     };
+    // only the rows that will be printed are kept while the query streams in.
+    param.limit_ = showEventCount_ > 0 ? static_cast<size_t>(showEventCount_) : 0;
+    param.filter_ = [this](const HiSysEventRecord &event) {
+        std::string reason;
+        return !ShouldSkipEvent(event) && event.GetParamValue("REASON", reason) == 0 &&
+            !transformReason(reason).empty();
+    };
     std::shared_ptr<DumpEventInfo> dumpEventInfo = std::make_shared<DumpEventInfo>();
     return dumpEventInfo->DumpEventList(events_, param, true);
 }
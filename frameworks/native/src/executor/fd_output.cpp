@@ -17,6 +17,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include "common/dumper_constant.h"
+#include "util/trace_recorder.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -77,6 +78,7 @@ DumpStatus FDOutput::AfterExecute()
 void FDOutput::OutMethod()
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    TraceSpan span("output", "FdWrite");
     for (size_t i = 0; i < dumpDatas_->size(); i++) {
         std::vector<std::string> line = dumpDatas_->at(i);
         for (size_t j = 0; j < line.size(); j++) {
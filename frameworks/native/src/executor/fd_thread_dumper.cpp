@@ -15,6 +15,7 @@
 #include "executor/fd_thread_dumper.h"
 #include <fstream>
 #include <tuple>
+#include "util/file_utils.h"
 
 using namespace std;
 namespace OHOS {
@@ -160,7 +161,7 @@ void FdThreadDumper::DumpFdLinkCounts(const unordered_map<string, int>& linkCoun
 
 void FdThreadDumper::DumpThreadInfo()
 {
-    string taskPath = "/proc/" + to_string(processPid_) + "/task/";
+    string taskPath = FileUtils::GetInstance().GetProcPath("/proc/" + to_string(processPid_) + "/task/");
     auto threadIds = GetSubNodes(taskPath, true);
     map<string, int64_t> nameCntMap;
 
@@ -217,7 +218,7 @@ string FdThreadDumper::GetFdLink(const string &linkPath)
 
 vector<string> FdThreadDumper::GetFdLinks(int pid)
 {
-    string fdPath = "/proc/" + to_string(pid) + "/fd/";
+    string fdPath = FileUtils::GetInstance().GetProcPath("/proc/" + to_string(pid) + "/fd/");
     vector<string> nodes = GetSubNodes(fdPath, true);
     vector<string> links;
     for (const auto &node : nodes) {
@@ -383,7 +384,7 @@ size_t FdThreadDumper::FindFdClusterStartIndex(const string &fullFileName)
 
 string FdThreadDumper::GetThreadStartTime(int pid, const string &tid)
 {
-    string statPath = "/proc/" + to_string(pid) + "/task/" + tid + "/stat";
+    string statPath = FileUtils::GetInstance().GetProcPath("/proc/" + to_string(pid) + "/task/" + tid + "/stat");
     ifstream file(statPath);
     if (!file.is_open()) {
         return "";
@@ -433,7 +434,7 @@ string FdThreadDumper::GetThreadStartTime(int pid, const string &tid)
 
 string FdThreadDumper::GetThreadName(int pid, const string &tid)
 {
-    string commPath = "/proc/" + to_string(pid) + "/task/" + tid + "/comm";
+    string commPath = FileUtils::GetInstance().GetProcPath("/proc/" + to_string(pid) + "/task/" + tid + "/comm");
     ifstream file(commPath);
     if (!file.is_open()) {
         return "";
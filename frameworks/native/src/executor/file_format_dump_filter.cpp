@@ -13,20 +13,10 @@
  * limitations under the License.
  */
 #include "executor/file_format_dump_filter.h"
+#include "util/text_sanitizer.h"
 
 namespace OHOS {
 namespace HiviewDFX {
-namespace {
-const char ASCII_CR = '\r';
-const char ASCII_LF = '\n';
-const char ASCII_ESC = '\033';
-const char ASCII_OB = '[';
-const char ASCII_UA = 'A';
-const char ASCII_LA = 'a';
-const char ASCII_UZ = 'Z';
-const char ASCII_LZ = 'z';
-}
-
 FileFormatDumpFilter::FileFormatDumpFilter()
 {
 }
@@ -66,31 +56,7 @@ DumpStatus FileFormatDumpFilter::AfterExecute()
 
 void FileFormatDumpFilter::FilterControlChar(std::string &str)
 {
-    std::string newStr;
-
-    bool skip = false;
-    const size_t sum = str.size();
-    for (size_t pos = 0; pos < sum; pos++) {
-        char &c = str.at(pos);
-
-        if ((!skip) && (c == ASCII_ESC) && ((pos + 1) < sum)) {
-            char &next_c = str.at(pos + 1);
-            skip = (next_c == ASCII_OB);
-        }
-
-        if (skip && (((c >= ASCII_UA) && (c <= ASCII_UZ)) || ((c >= ASCII_LA) && (c <= ASCII_LZ)))) {
-            skip = false;
-            continue;
-        }
-
-        if (skip || (c == ASCII_CR) || (c == ASCII_LF)) {
-            continue;
-        }
-
-        newStr.append(1, c);
-    }
-
-    str = newStr;
+    TextSanitizer::Sanitize(str);
 }
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -13,16 +13,25 @@
  * limitations under the License.
  */
 #include "executor/file_stream_dumper.h"
+#include <cstring>
 #include <dirent.h>
 #include <unistd.h>
+#include <sys/sendfile.h>
 #include "dump_utils.h"
 #include "common/dumper_constant.h"
+#include "securec.h"
 
 namespace OHOS {
 namespace HiviewDFX {
+namespace {
+constexpr size_t READ_BLOCK_SIZE = 64 * 1024;
+constexpr size_t SEND_FILE_SIZE = 1024 * 1024;
+const std::string ADDR_PREFIX = ": u";
+const std::string ADDR_REPLACEMENT = ": u0000000000000000 c0000000000000000";
+}
+
 FileStreamDumper::FileStreamDumper()
-    :fp_(nullptr),
-    fd_(-1),
+    :fd_(-1),
     next_file_index_(0),
     more_data_(false),
     need_loop_(false)
@@ -59,6 +68,10 @@ DumpStatus FileStreamDumper::PreExecute(const std::shared_ptr<DumperParameter>&
         }
         BuildFileNames(target, arg_pid, pid, arg_cpuid, cpuid);
         need_loop_ = (ptrDumpCfg_->loop_ == DumperConstant::LOOP);
+        outputFd_ = GetDirectOutputFd(parameter);
+        directOutput_ = (outputFd_ >= 0);
+        buffer_.resize(READ_BLOCK_SIZE);
+        carry_ = 0;
 
         int ret = OpenNextFile();
         if (ret <= 0) {
@@ -79,16 +92,10 @@ int FileStreamDumper::OpenNextFile()
     }
     // Next file
     std::string filename = filenames_[next_file_index_];
-    // Open fd and fp
+    // Open fd
     if ((fd_ = DumpUtils::FdToRead(filename)) == -1) {
         return -1;
     }
-    if ((fp_ = fdopen(fd_, "r")) == nullptr) {
-        fdsan_exchange_owner_tag(fd_, 0, FDTAG);
-        fdsan_close_with_tag(fd_, FDTAG);
-        fd_ = -1;
-        return -1;
-    }
     next_file_index_ ++;
     // add file name into buffer
     std::vector<std::string> line_vector_blank;
@@ -101,61 +108,129 @@ int FileStreamDumper::OpenNextFile()
     return next_file_index_;
 }
 
-std::string FileStreamDumper::ReplaceAddresses(const std::string& input)
+void FileStreamDumper::HideAddressesInBlock(char* data, size_t size)
+{
+    // mask the first address pair of every line in place, the block only holds complete lines
+    char* end = data + size;
+    char* lineStart = data;
+    while (lineStart < end) {
+        char* lineEnd = static_cast<char*>(memchr(lineStart, '\n', end - lineStart));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        char* pos = static_cast<char*>(memmem(lineStart, lineEnd - lineStart, ADDR_PREFIX.c_str(),
+            ADDR_PREFIX.length()));
+        if (pos != nullptr) {
+            size_t len = std::min(ADDR_REPLACEMENT.length(), static_cast<size_t>(lineEnd - pos));
+            if (memcpy_s(pos, len, ADDR_REPLACEMENT.c_str(), len) != EOK) {
+                DUMPER_HILOGE(MODULE_COMMON, "hide address failed");
+            }
+        }
+        lineStart = lineEnd + 1;
+    }
+}
+
+void FileStreamDumper::DispatchBlock(char* data, size_t size)
 {
-    std::string result = input;
-    size_t start = result.find(": u");
-    if (start == std::string::npos) {
-        return result;
+    if (size == 0) {
+        return;
+    }
+    if (needHideAddr_ && DumpUtils::IsUserMode()) {
+        HideAddressesInBlock(data, size);
     }
-    std::string replacement = ": u0000000000000000 c0000000000000000";
-    if (start < result.length()) {
-        result.replace(start, replacement.length(), replacement);
+    if (directOutput_) {
+        WriteAll(outputFd_, data, size);
+        return;
+    }
+    const char* end = data + size;
+    const char* lineStart = data;
+    while (lineStart < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(lineStart, '\n', end - lineStart));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        result_->push_back({std::string(lineStart, lineEnd)});
+        lineStart = lineEnd + 1;
     }
-    return result;
 }
 
-// read one line
+DumpStatus FileStreamDumper::NextFileStatus()
+{
+    DumpStatus ret = DumpStatus::DUMP_FAIL;
+    int more_file = OpenNextFile();
+    if (more_file > 0) {
+        ret = DumpStatus::DUMP_MORE_DATA;
+    } else if (more_file == 0) {
+        ret = DumpStatus::DUMP_OK;
+    }
+    if (directOutput_) {
+        FlushDumpDatas(result_, outputFd_);
+    }
+    return ret;
+}
+
+// read one block of complete lines
 DumpStatus FileStreamDumper::ReadLineInFile()
 {
-    DumpStatus ret = DumpStatus::DUMP_MORE_DATA;
-    if (fp_ == nullptr) {
+    if (fd_ < 0) {
         return DumpStatus::DUMP_FAIL;
     }
-    char* line_buffer = nullptr;
-    size_t len = 0;
-    ssize_t read = 0;
-    read = getline(&line_buffer, &len, fp_);
-    if (read > 0) {
-        if (line_buffer[read-1] == '\n') {
-            line_buffer[read-1] = '\0'; // replease \n
-        }
-        std::string line = line_buffer;
-        if (needHideAddr_ && DumpUtils::IsUserMode()) {
-            line = ReplaceAddresses(line);
-        }
-        std::vector<std::string> line_vector;
-        line_vector.push_back(line);
-        result_->push_back(line_vector);
-    } else {
-        if (feof(fp_) == 0) { // ferror()
-            ret = DumpStatus::DUMP_FAIL;
+    ssize_t readLen = TEMP_FAILURE_RETRY(read(fd_, buffer_.data() + carry_, buffer_.size() - carry_));
+    if (readLen < 0) {
+        DUMPER_HILOGE(MODULE_COMMON, "read failed, errno: %{public}d", errno);
+        more_data_ = false;
+        return DumpStatus::DUMP_FAIL;
+    }
+    size_t dataLen = carry_ + static_cast<size_t>(readLen);
+    size_t blockLen = dataLen;
+    if (readLen > 0) {
+        const char* lastNewLine = static_cast<const char*>(memrchr(buffer_.data(), '\n', dataLen));
+        blockLen = (lastNewLine == nullptr) ? 0 : static_cast<size_t>(lastNewLine - buffer_.data() + 1);
+    }
+    DispatchBlock(buffer_.data(), blockLen);
+    carry_ = dataLen - blockLen;
+    if (carry_ > 0 && blockLen > 0) {
+        if (memmove_s(buffer_.data(), buffer_.size(), buffer_.data() + blockLen, carry_) != EOK) {
+            DUMPER_HILOGE(MODULE_COMMON, "memmove failed");
+            carry_ = 0;
         }
     }
-    // end of file
-    if (feof(fp_) != 0) {
-        int more_file = OpenNextFile();
-        if (more_file > 0) {
-            ret = DumpStatus::DUMP_MORE_DATA;
-        } else if (more_file == 0) {
-            ret = DumpStatus::DUMP_OK;
-        } else { // Error!
-            ret = DumpStatus::DUMP_FAIL;
+    if (carry_ == buffer_.size()) {
+        // a single line is longer than the buffer
+        buffer_.resize(buffer_.size() * 2);
+    }
+
+    DumpStatus ret = DumpStatus::DUMP_MORE_DATA;
+    if (readLen == 0) {
+        carry_ = 0;
+        ret = NextFileStatus();
+    }
+    more_data_ = (ret == DumpStatus::DUMP_MORE_DATA);
+    return ret;
+}
+
+DumpStatus FileStreamDumper::SendFileToOutput()
+{
+    if (!useSendFile_ || (needHideAddr_ && DumpUtils::IsUserMode())) {
+        return ReadLineInFile();
+    }
+    if (fd_ < 0) {
+        return DumpStatus::DUMP_FAIL;
+    }
+    ssize_t sent = TEMP_FAILURE_RETRY(sendfile(outputFd_, fd_, nullptr, SEND_FILE_SIZE));
+    if (sent < 0) {
+        if (errno == EINVAL || errno == ENOSYS) {
+            // some kernel files do not support splice, copy them through the buffer instead
+            useSendFile_ = false;
+            return ReadLineInFile();
         }
+        DUMPER_HILOGE(MODULE_COMMON, "sendfile failed, errno: %{public}d", errno);
+        more_data_ = false;
+        return DumpStatus::DUMP_FAIL;
     }
-    if (line_buffer != nullptr) {
-        free(line_buffer);
-        line_buffer = nullptr;
+    DumpStatus ret = DumpStatus::DUMP_MORE_DATA;
+    if (sent == 0) {
+        ret = NextFileStatus();
     }
     more_data_ = (ret == DumpStatus::DUMP_MORE_DATA);
     return ret;
@@ -164,13 +239,24 @@ DumpStatus FileStreamDumper::ReadLineInFile()
 DumpStatus FileStreamDumper::Execute()
 {
     DumpStatus ret = DumpStatus::DUMP_OK;
-    if (need_loop_) {
-        // file dump one line
+    if (directOutput_) {
+        FlushDumpDatas(result_, outputFd_);
+        // file dump all blocks, the data never goes through the executor chain
+        do {
+            if (IsCanceled()) {
+                more_data_ = false;
+                break;
+            }
+            ret = SendFileToOutput();
+        } while (ret == DumpStatus::DUMP_MORE_DATA);
+    } else if (need_loop_) {
+        // file dump one block
         return ReadLineInFile();
     } else {
         // file dump all line
         do {
             if (IsCanceled()) {
+                more_data_ = false;
                 break;
             }
             ret = ReadLineInFile();
@@ -252,11 +338,7 @@ void FileStreamDumper::ReplaceCpuidInFilename(std::string& filename, int cpuid)
 
 void FileStreamDumper::CloseFd()
 {
-    if (fp_ != nullptr) {
-        fclose(fp_);
-        fp_ = nullptr;
-        fd_ = -1;
-    } else if (fd_ >= 0) {
+    if (fd_ >= 0) {
         fdsan_exchange_owner_tag(fd_, 0, FDTAG);
         fdsan_close_with_tag(fd_, FDTAG);
         fd_ = -1;
@@ -13,7 +13,10 @@
  * limitations under the License.
  */
 #include "executor/hidumper_executor.h"
+#include <algorithm>
+#include <unistd.h>
 #include "datetime_ex.h"
+#include "util/trace_recorder.h"
 namespace OHOS {
 namespace HiviewDFX {
 const std::string HidumperExecutor::TIME_OUT_STR = "time out";
@@ -26,6 +29,7 @@ void HidumperExecutor::Reset()
 {
     rawParam_ = nullptr;
     ptrParent_ = nullptr;
+    staged_ = false;
 }
 
 DumpStatus HidumperExecutor::DoPreExecute(const std::shared_ptr<DumperParameter>& parameter, StringMatrix dumpDatas)
@@ -34,23 +38,34 @@ DumpStatus HidumperExecutor::DoPreExecute(const std::shared_ptr<DumperParameter>
         rawParam_ = parameter->getClientCallback();
     }
 
+    TraceSpan span("executor", "PreExecute", GetTraceDetail());
     DumpStatus ret = PreExecute(parameter, dumpDatas);
     return ret;
 }
 
 DumpStatus HidumperExecutor::DoExecute()
 {
+    TraceSpan span("executor", "Execute", GetTraceDetail());
     DumpStatus ret = Execute();
     return ret;
 }
 
 DumpStatus HidumperExecutor::DoAfterExecute()
 {
-    DumpStatus ret = AfterExecute();
+    DumpStatus ret = DumpStatus::DUMP_OK;
+    {
+        TraceSpan span("executor", "AfterExecute", GetTraceDetail());
+        ret = AfterExecute();
+    }
     rawParam_ = nullptr;
     return ret;
 }
 
+const std::string *HidumperExecutor::GetTraceDetail() const
+{
+    return (ptrDumpCfg_ == nullptr) ? nullptr : &ptrDumpCfg_->name_;
+}
+
 void HidumperExecutor::SetDumpConfig(const std::shared_ptr<DumpCfg>& config)
 {
     if (config == nullptr) {
@@ -74,5 +89,58 @@ bool HidumperExecutor::IsCanceled() const
 {
     return ((rawParam_ != nullptr) && rawParam_->IsCanceled());
 }
+
+void HidumperExecutor::SetStaged(bool staged)
+{
+    staged_ = staged;
+}
+
+int HidumperExecutor::GetDirectOutputFd(const std::shared_ptr<DumperParameter>& parameter) const
+{
+    if (staged_ || parameter == nullptr || parameter->getClientCallback() == nullptr ||
+        parameter->GetOpts().IsDumpZip() || !parameter->GetOutputFilePath().empty()) {
+        return -1;
+    }
+    auto& configs = parameter->GetExecutorConfigList();
+    auto it = std::find(configs.begin(), configs.end(), ptrDumpCfg_);
+    if (it == configs.end() || (it + 1) == configs.end() || (*(it + 1))->class_ != DumperConstant::FD_OUTPUT) {
+        return -1;
+    }
+    return parameter->getClientCallback()->GetOutputFd();
+}
+
+void HidumperExecutor::FlushDumpDatas(StringMatrix dumpDatas, int fd)
+{
+    // same layout as FDOutput, the collected lines must reach the fd before the streamed data
+    if (dumpDatas == nullptr) {
+        return;
+    }
+    TraceSpan span("output", "FlushWrite");
+    std::string content;
+    for (const auto& line : *dumpDatas) {
+        for (const auto& cell : line) {
+            content += cell;
+        }
+        if (!line.empty() && line.back().find('\n') == std::string::npos) {
+            content += "\n";
+        }
+    }
+    dumpDatas->clear();
+    WriteAll(fd, content.data(), content.size());
+}
+
+bool HidumperExecutor::WriteAll(int fd, const char* data, size_t size)
+{
+    size_t written = 0;
+    while (written < size) {
+        ssize_t ret = TEMP_FAILURE_RETRY(write(fd, data + written, size - written));
+        if (ret <= 0) {
+            DUMPER_HILOGE(MODULE_COMMON, "write to fd failed, errno: %{public}d", errno);
+            return false;
+        }
+        written += static_cast<size_t>(ret);
+    }
+    return true;
+}
 } // namespace HiviewDFX
 } // namespace OHOS
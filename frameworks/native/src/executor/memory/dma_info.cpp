@@ -74,7 +74,7 @@ bool DmaInfo::ParseDmaInfo()
         return true;
     }
     initialized_ = true;
-    string path = "/proc/process_dmabuf_info";
+    string path = FileUtils::GetInstance().GetProcPath("/proc/process_dmabuf_info");
     bool ret = FileUtils::GetInstance().LoadStringFromProcCb(path, false, true, [&](const string &line) -> void {
         CreateDmaInfo(line);
     });
@@ -15,11 +15,7 @@
 
 #include "executor/memory/get_cma_info.h"
 
-#include <cstdlib>
-
-#include "executor/cmd_dumper.h"
-#include "executor/memory/memory_util.h"
-#include "util/string_utils.h"
+#include "executor/memory/kernel_counter_reader.h"
 #include "hilog_wrapper.h"
 
 using namespace std;
@@ -35,21 +31,9 @@ GetCMAInfo::~GetCMAInfo()
 
 bool GetCMAInfo::GetUsed(uint64_t &value)
 {
-    string cmd = "cat /sys/kernel/debug/cma/*/used";
-    vector<string> usedInfos;
-    if (MemoryUtil::GetInstance().RunCMD(cmd, usedInfos)) {
-        const int base = 10;
-        for (size_t i = 0; i < usedInfos.size(); i++) {
-            string used = usedInfos.at(i);
-            if (StringUtils::GetInstance().IsNum(used)) {
-                value += strtoull(usedInfos.at(i).c_str(), nullptr, base);
-            } else {
-                DUMPER_HILOGE(MODULE_SERVICE, "CMA Get Used Data error\n");
-                return false;
-            }
-        }
-    } else {
-        DUMPER_HILOGE(MODULE_SERVICE, "Get CMA used by run cmd failed\n");
+    if (!KernelCounterReader::GetInstance().Read(KernelCounterReader::CMA_USED, value)) {
+        DUMPER_HILOGE(MODULE_SERVICE, "CMA Get Used Data error\n");
+        return false;
     }
     return true;
 }
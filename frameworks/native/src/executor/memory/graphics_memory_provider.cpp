@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "executor/memory/graphics_memory_provider.h"
+
+#include "dumper_plugin.h"
+#include "hilog_wrapper.h"
+
+using namespace std;
+namespace OHOS {
+namespace HiviewDFX {
+unique_ptr<GraphicsMemoryProvider> GraphicsMemoryProvider::Create()
+{
+    return make_unique<PluginGraphicsMemoryProvider>();
+}
+
+bool GraphicsMemoryProvider::Collect(const vector<int32_t> &pids, bool withGraph)
+{
+    Clear();
+    if (pids.empty()) {
+        return false;
+    }
+    collected_ = CollectAll(pids, withGraph, entries_);
+    if (!collected_) {
+        entries_.clear();
+    }
+    DUMPER_HILOGD(MODULE_SERVICE, "collect graphics memory of %{public}zu pids, ret:%{public}d",
+        pids.size(), collected_);
+    return collected_;
+}
+
+bool GraphicsMemoryProvider::IsCollected() const
+{
+    return collected_;
+}
+
+uint64_t GraphicsMemoryProvider::GetGl(int32_t pid) const
+{
+    auto it = entries_.find(pid);
+    return (it == entries_.end()) ? 0 : it->second.gl;
+}
+
+uint64_t GraphicsMemoryProvider::GetGraph(int32_t pid) const
+{
+    auto it = entries_.find(pid);
+    return (it == entries_.end()) ? 0 : it->second.graph;
+}
+
+void GraphicsMemoryProvider::Clear()
+{
+    entries_.clear();
+    collected_ = false;
+}
+
+bool PluginGraphicsMemoryProvider::CollectAll(const vector<int32_t> &pids, bool withGraph, EntryMap &entries)
+{
+    vector<int> pidSet(pids.begin(), pids.end());
+    vector<DumpPluginRecord> records;
+    if (!CollectBatch(pidSet, PLUGIN_BATCH_GRAPHICS_MEMORY, records)) {
+        return false;
+    }
+    // the values no longer come from GraphicMemoryCollector, say so where the dump can be traced back.
+    DUMPER_HILOGI(MODULE_SERVICE, "graphics memory of %{public}zu pids from the batch plugin, %{public}zu records",
+        pids.size(), records.size());
+    for (const auto &record : records) {
+        if (record.type == PLUGIN_RECORD_GL) {
+            entries[record.pid].gl = record.value;
+        } else if (withGraph && record.type == PLUGIN_RECORD_GRAPH) {
+            entries[record.pid].graph = record.value;
+        }
+    }
+    return true;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
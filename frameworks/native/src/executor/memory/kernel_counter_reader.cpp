@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "executor/memory/kernel_counter_reader.h"
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <glob.h>
+#include <unistd.h>
+#include "hilog_wrapper.h"
+using namespace std;
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr size_t NUMBER_BUF_SIZE = 32;
+constexpr int DECIMAL_BASE = 10;
+const string CMA_FOLDER = "/sys/kernel/debug/cma";
+const string CMA_USED_PATTERN = "*/used";
+
+int64_t GetNowMs()
+{
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+} // namespace
+
+KernelCounterReader::KernelCounterReader()
+{
+    Register({CMA_USED, CMA_FOLDER, CMA_USED_PATTERN});
+}
+
+KernelCounterReader::~KernelCounterReader()
+{
+    Reset();
+}
+
+void KernelCounterReader::Register(const CounterSpec &spec)
+{
+    lock_guard<mutex> lock(mutex_);
+    auto found = counters_.find(spec.name);
+    if (found != counters_.end()) {
+        Release(found->second);
+        counters_.erase(found);
+    }
+    Counter counter;
+    counter.spec = spec;
+    counters_.emplace(spec.name, counter);
+}
+
+bool KernelCounterReader::IsRegistered(const string &name)
+{
+    lock_guard<mutex> lock(mutex_);
+    return counters_.find(name) != counters_.end();
+}
+
+bool KernelCounterReader::Read(const string &name, uint64_t &value)
+{
+    lock_guard<mutex> lock(mutex_);
+    auto found = counters_.find(name);
+    if (found == counters_.end()) {
+        DUMPER_HILOGE(MODULE_SERVICE, "kernel counter %{public}s is not registered", name.c_str());
+        return false;
+    }
+    Counter &counter = found->second;
+    uint64_t sum = 0;
+    if (ReadCounter(counter, sum)) {
+        value += sum;
+        return true;
+    }
+    // the matched files may have changed since they were cached, match them again once.
+    Release(counter);
+    sum = 0;
+    if (ReadCounter(counter, sum)) {
+        value += sum;
+        return true;
+    }
+    Release(counter);
+    return false;
+}
+
+void KernelCounterReader::Reset()
+{
+    lock_guard<mutex> lock(mutex_);
+    for (auto &item : counters_) {
+        Release(item.second);
+    }
+}
+
+bool KernelCounterReader::Prepare(Counter &counter)
+{
+    int64_t now = GetNowMs();
+    if ((counter.folderFd >= 0) && (now - counter.matchedMs < REMATCH_INTERVAL_MS)) {
+        return true;
+    }
+    // a new file is not an error the read would see, so the files are matched again on a timer.
+    Release(counter);
+    counter.files.clear();
+    int fd = TEMP_FAILURE_RETRY(open(counter.spec.folder.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (fd < 0) {
+        DUMPER_HILOGD(MODULE_SERVICE, "open %{public}s failed, errno=%{public}d", counter.spec.folder.c_str(), errno);
+        return false;
+    }
+    string prefix = counter.spec.folder + "/";
+    glob_t globResult = {};
+    if (glob((prefix + counter.spec.pattern).c_str(), 0, nullptr, &globResult) == 0) {
+        for (size_t i = 0; i < globResult.gl_pathc; i++) {
+            string path = globResult.gl_pathv[i];
+            counter.files.push_back(path.substr(prefix.size()));
+        }
+    }
+    globfree(&globResult);
+    counter.folderFd = fd;
+    counter.matchedMs = now;
+    return true;
+}
+
+bool KernelCounterReader::ReadCounter(Counter &counter, uint64_t &value)
+{
+    if (!Prepare(counter)) {
+        // a missing folder is a kernel without this counter, which reads 0.
+        return true;
+    }
+    for (const auto &file : counter.files) {
+        uint64_t fileValue = 0;
+        if (!ReadNumber(counter.folderFd, file, fileValue)) {
+            DUMPER_HILOGE(MODULE_SERVICE, "read %{public}s/%{public}s failed", counter.spec.folder.c_str(),
+                file.c_str());
+            return false;
+        }
+        value += fileValue;
+    }
+    return true;
+}
+
+bool KernelCounterReader::ReadNumber(int folderFd, const string &file, uint64_t &value)
+{
+    int fd = TEMP_FAILURE_RETRY(openat(folderFd, file.c_str(), O_RDONLY | O_CLOEXEC));
+    if (fd < 0) {
+        return false;
+    }
+    char buf[NUMBER_BUF_SIZE] = {0};
+    ssize_t len = TEMP_FAILURE_RETRY(pread(fd, buf, sizeof(buf) - 1, 0));
+    close(fd);
+    if (len <= 0) {
+        return false;
+    }
+    buf[len] = '\0';
+    char *end = nullptr;
+    errno = 0;
+    value = strtoull(buf, &end, DECIMAL_BASE);
+    if ((end == buf) || (errno != 0) || (buf[0] == '-')) {
+        return false;
+    }
+    while (*end == '\n' || *end == ' ') {
+        end++;
+    }
+    return *end == '\0';
+}
+
+void KernelCounterReader::Release(Counter &counter)
+{
+    if (counter.folderFd >= 0) {
+        close(counter.folderFd);
+        counter.folderFd = -1;
+    }
+    counter.files.clear();
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -67,6 +67,24 @@ constexpr int APP_UID = 20000;
 constexpr int LINE_SPACING = 6;
 constexpr int DMABUF_MAX_WIDTH = 33;
 
+// larger Pss first, the other sizes and the pid break ties so the order is stable across dumps.
+static bool RanksBefore(const MemInfoData::MemUsage &left, const MemInfoData::MemUsage &right)
+{
+    if (right.pss + right.swapPss != left.pss + left.swapPss) {
+        return right.pss + right.swapPss < left.pss + left.swapPss;
+    }
+    if (right.vss != left.vss) {
+        return right.vss < left.vss;
+    }
+    if (right.rss != left.rss) {
+        return right.rss < left.rss;
+    }
+    if (right.uss != left.uss) {
+        return right.uss < left.uss;
+    }
+    return right.pid < left.pid;
+}
+
 MemoryInfo::MemoryInfo()
 {
     methodVec_.clear();
@@ -91,6 +109,7 @@ MemoryInfo::MemoryInfo()
     methodVec_.push_back(make_pair(MEMINFO_HEAP_FREE,
         bind(&MemoryInfo::SetHeapFree, this, placeholders::_1, placeholders::_2)));
     LoadPlugin();
+    graphicsProvider_ = GraphicsMemoryProvider::Create();
 }
 
 MemoryInfo::~MemoryInfo()
@@ -98,6 +117,38 @@ MemoryInfo::~MemoryInfo()
     UnloadPlugin();
 }
 
+void MemoryInfo::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fut_.valid()) {
+        // the smaps thread of an unfinished request still reads this object.
+        fut_.wait();
+        fut_ = std::future<GroupMap>();
+    }
+    rawParamFd_ = 0;
+    TITLE_WIDTH_ = DEFAULT_TITLE_WIDTH_;
+    isReady_ = false;
+    dumpPrune_ = false;
+    dumpSmapsOnStart_ = false;
+    topN_ = 0;
+    processFilter_ = ColumnRowsQuery::ProcessFilter();
+    totalGL_ = 0;
+    totalGraph_ = 0;
+    totalDma_ = 0;
+    currentPss_ = 0;
+    startTime_.clear();
+    pids_.clear();
+    memUsages_.clear();
+    for (auto &adjMem : adjMemResult_) {
+        adjMem.second.clear();
+    }
+    memoryItemMap_.clear();
+    graphicsMemory_ = {};
+    if (graphicsProvider_ != nullptr) {
+        graphicsProvider_->Clear();
+    }
+}
+
 void MemoryInfo::InsertMemoryTitle(StringMatrix result)
 {
     // Pss        Shared   ---- this line is line1
@@ -1097,7 +1148,7 @@ string MemoryInfo::GetProcName(const int32_t &pid)
     string procName = UNKNOWN_PROCESS;
     DumpCommonUtils::GetProcessNameByPid(pid, procName);
     if (procName == UNKNOWN_PROCESS) {
-        string path = "/proc/" + to_string(pid) + "/status";
+        string path = FileUtils::GetInstance().GetProcPath("/proc/" + to_string(pid) + "/status");
         procName = FileUtils::GetInstance().GetProcValue(pid, path, "Name");
     }
     return procName;
@@ -1105,7 +1156,7 @@ string MemoryInfo::GetProcName(const int32_t &pid)
 
 int32_t MemoryInfo::GetProcUid(const int32_t &pid)
 {
-    string path = "/proc/" + to_string(pid) + "/status";
+    string path = FileUtils::GetInstance().GetProcPath("/proc/" + to_string(pid) + "/status");
     string procUid = FileUtils::GetInstance().GetProcValue(pid, path, "Uid");
     if (procUid == UNKNOWN_PROCESS) {
         DUMPER_HILOGE(MODULE_SERVICE, "GetProcUid failed");
@@ -1124,7 +1175,7 @@ int32_t MemoryInfo::GetProcUid(const int32_t &pid)
 
 uint64_t MemoryInfo::GetProcValue(const int32_t &pid, const string& key)
 {
-    string path = "/proc/" + to_string(pid) + "/status";
+    string path = FileUtils::GetInstance().GetProcPath("/proc/" + to_string(pid) + "/status");
     std::string value = FileUtils::GetInstance().GetProcValue(pid, path, key);
     if (value == UNKNOWN_PROCESS) {
         DUMPER_HILOGE(MODULE_SERVICE, "GetProcStatusValue failed");
@@ -1146,7 +1197,7 @@ uint64_t MemoryInfo::GetProcValue(const int32_t &pid, const string& key)
 string MemoryInfo::GetProcessAdjLabel(const int32_t pid)
 {
     string adjLabel = Memory::RECLAIM_PRIORITY_UNKNOWN_DESC;
-    string fillPath = "/proc/" + to_string(pid) + "/oom_score_adj";
+    string fillPath = FileUtils::GetInstance().GetProcPath("/proc/" + to_string(pid) + "/oom_score_adj");
     if (!DumpUtils::PathIsValid(fillPath)) {
         DUMPER_HILOGE(MODULE_COMMON, "GetProcessAdjLabel leave|false, PathIsValid");
         return adjLabel;
@@ -1182,7 +1233,7 @@ string MemoryInfo::GetProcessAdjLabel(const int32_t pid)
 
 int MemoryInfo::GetScoreAdj(const int32_t pid)
 {
-    string filePath = "/proc/" + to_string(pid) + "/oom_score_adj";
+    string filePath = FileUtils::GetInstance().GetProcPath("/proc/" + to_string(pid) + "/oom_score_adj");
     if (!DumpUtils::PathIsValid(filePath)) {
         DUMPER_HILOGE(MODULE_COMMON, "GetScoreAdj leave|false, PathIsValid");
         return -1;
@@ -1206,9 +1257,15 @@ bool MemoryInfo::GetPids()
     return success;
 }
 
+void MemoryInfo::SetProcessFilter(const ColumnRowsQuery::ProcessFilter &filter)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    processFilter_ = filter;
+}
+
 uint64_t MemoryInfo::GetVss(const int32_t &pid)
 {
-    string path = "/proc/" + to_string(pid) + "/statm";
+    string path = FileUtils::GetInstance().GetProcPath("/proc/" + to_string(pid) + "/statm");
     uint64_t res = 0;
     bool ret = FileUtils::GetInstance().LoadStringFromProcCb(path, true, true, [&](const string& line) -> void {
         if (!line.empty()) {
@@ -1229,6 +1286,16 @@ uint64_t MemoryInfo::GetVss(const int32_t &pid)
 
 bool MemoryInfo::GetGraphicsMemory(int32_t pid, MemInfoData::GraphicsMemory &graphicsMemory, GraphicType graphicType)
 {
+    if ((graphicsProvider_ != nullptr) && graphicsProvider_->IsCollected()) {
+        if (graphicType == GraphicType::GL) {
+            graphicsMemory.gl = graphicsProvider_->GetGl(pid);
+            return true;
+        }
+        if (graphicType == GraphicType::GRAPH) {
+            graphicsMemory.graph = graphicsProvider_->GetGraph(pid);
+            return true;
+        }
+    }
     DUMPER_HILOGD(MODULE_SERVICE, "GetGraphicUsage start, pid:%{public}d", pid);
     std::shared_ptr<UCollectUtil::GraphicMemoryCollector> collector = UCollectUtil::GraphicMemoryCollector::Create();
     CollectResult<int32_t> data;
@@ -1256,13 +1323,11 @@ bool MemoryInfo::GetMemByProcessPid(const int32_t &pid, MemInfoData::MemUsage &u
     unique_ptr<ParseSmapsRollupInfo> getSmapsRollup = make_unique<ParseSmapsRollupInfo>();
     if (getSmapsRollup->GetMemInfo(pid, memInfo)) {
         if (!dumpPrune_) {
-            usage.vss = GetVss(pid);
             usage.uss = memInfo.privateClean + memInfo.privateDirty;
             usage.rss = memInfo.rss;
         }
         usage.pss = memInfo.pss;
         usage.swapPss = memInfo.swapPss;
-        usage.name = GetProcName(pid);
         usage.pid = pid;
 #ifdef HIDUMPER_MEMMGR_ENABLE
         usage.adjLabel = GetProcessAdjLabel(pid);
@@ -1298,6 +1363,29 @@ bool MemoryInfo::GetMemByProcessPid(const int32_t &pid, MemInfoData::MemUsage &u
     return success;
 }
 
+void MemoryInfo::FillUsageDetail(MemInfoData::MemUsage &usage)
+{
+    // only printed, so a top N ranking reads them for the processes it shows.
+    if (!dumpPrune_) {
+        usage.vss = GetVss(usage.pid);
+    }
+    if (usage.name.empty()) {
+        usage.name = GetProcName(usage.pid);
+    }
+}
+
+bool MemoryInfo::MatchProcessFilter(MemInfoData::MemUsage &usage)
+{
+    if (!processFilter_.MatchPid(usage.pid) || (usage.pss + usage.swapPss < processFilter_.minPss)) {
+        return false;
+    }
+    if (!processFilter_.HasName()) {
+        return true;
+    }
+    usage.name = GetProcName(usage.pid);
+    return processFilter_.MatchName(usage.name);
+}
+
 void MemoryInfo::MemUsageToMatrix(const MemInfoData::MemUsage &memUsage, StringMatrix result)
 {
     string pid = to_string(memUsage.pid);
@@ -1430,18 +1518,51 @@ void MemoryInfo::GetMemoryUsageInfo(StringMatrix result)
 {
     MemInfoData::MemUsage usage;
     MemoryUtil::GetInstance().InitMemUsage(usage);
+    if (graphicsProvider_ != nullptr) {
+        // one query for the whole pid set, the per pid queries are only left for a provider that can not batch.
+        graphicsProvider_->Collect(pids_, !dumpPrune_);
+    }
     for (auto pid : pids_) {
         if (GetMemByProcessPid(pid, usage)) {
-            memUsages_.push_back(usage);
+            usage.name.clear();
+            // the totals count every process, the filter only leaves rows out of the process tables.
+            bool shown = MatchProcessFilter(usage);
+            if (shown && (topN_ == 0)) {
+                FillUsageDetail(usage);
+            }
             adjMemResult_[usage.adjLabel].push_back(usage);
             totalGL_ += usage.gl;
             totalGraph_ += usage.graph;
             totalDma_ += usage.dma;
+            if (!shown) {
+                continue;
+            }
+            if (topN_ > 0) {
+                PushTopN(usage);
+                continue;
+            }
+            memUsages_.push_back(usage);
             MemUsageToMatrix(usage, result);
         } else {
             DUMPER_HILOGE(MODULE_SERVICE, "Get smaps_rollup error! pid = %{public}d\n", static_cast<int>(pid));
         }
     }
+    if (graphicsProvider_ != nullptr) {
+        graphicsProvider_->Clear();
+    }
+}
+
+void MemoryInfo::PushTopN(const MemInfoData::MemUsage &usage)
+{
+    // memUsages_ is a heap of at most topN_ entries with the lowest ranked one at the front.
+    if (memUsages_.size() < topN_) {
+        memUsages_.push_back(usage);
+        std::push_heap(memUsages_.begin(), memUsages_.end(), RanksBefore);
+    } else if (RanksBefore(usage, memUsages_.front())) {
+        std::pop_heap(memUsages_.begin(), memUsages_.end(), RanksBefore);
+        memUsages_.back() = usage;
+        std::push_heap(memUsages_.begin(), memUsages_.end(), RanksBefore);
+    }
 }
 
 DumpStatus MemoryInfo::GetMemoryInfoNoPid(int fd, StringMatrix result)
@@ -1483,6 +1604,34 @@ DumpStatus MemoryInfo::GetMemoryInfoPrune(int fd, StringMatrix result)
     return DUMP_OK;
 }
 
+DumpStatus MemoryInfo::GetMemoryInfoTop(int fd, size_t topN, bool prune, StringMatrix result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    rawParamFd_ = fd;
+    dumpPrune_ = prune;
+    topN_ = topN;
+    (void)dprintf(rawParamFd_, "%s\n", MEMORY_LINE.c_str());
+    memUsages_.clear();
+    pids_.clear();
+    if (!GetPids()) {
+        DUMPER_HILOGE(MODULE_SERVICE, "GetPids error!\n");
+        topN_ = 0;
+        return DUMP_FAIL;
+    }
+    GetMemoryUsageInfo(result);
+    for (auto &memUsage : memUsages_) {
+        FillUsageDetail(memUsage);
+    }
+    GetSortedMemoryInfoNoPid(result);
+#ifdef HIDUMPER_MEMMGR_ENABLE
+    SaveStringToFd(rawParamFd_, "\n");
+    GetMemoryByAdj(result);
+#endif
+    memUsages_.clear();
+    topN_ = 0;
+    return DUMP_OK;
+}
+
 DumpStatus MemoryInfo::DealResult(StringMatrix result)
 {
     ValueMap meminfoResult;
@@ -1521,24 +1670,9 @@ DumpStatus MemoryInfo::DealResult(StringMatrix result)
 void MemoryInfo::GetSortedMemoryInfoNoPid(StringMatrix result)
 {
     SaveStringToFd(rawParamFd_, "\n");
-    AddMemByProcessTitle(result, "Size");
+    AddMemByProcessTitle(result, (topN_ > 0) ? "Size (top " + to_string(topN_) + ")" : "Size");
 
-    std::sort(memUsages_.begin(), memUsages_.end(),
-        [] (MemInfoData::MemUsage &left, MemInfoData::MemUsage &right) {
-        if (right.pss + right.swapPss != left.pss + left.swapPss) {
-            return right.pss + right.swapPss < left.pss + left.swapPss;
-        }
-        if (right.vss != left.vss) {
-            return right.vss < left.vss;
-        }
-        if (right.rss != left.rss) {
-            return right.rss < left.rss;
-        }
-        if (right.uss != left.uss) {
-            return right.uss < left.uss;
-        }
-        return right.pid < left.pid;
-    });
+    std::sort(memUsages_.begin(), memUsages_.end(), RanksBefore);
 
     for (auto &memUsage : memUsages_) {
         MemUsageToMatrix(memUsage, result);
@@ -1569,11 +1703,16 @@ void MemoryInfo::GetMemoryByAdj(StringMatrix result)
         });
         SaveStringToFd(rawParamFd_, adjLabel + ": " + AddKbUnit(totalPss) + "\n");
 
-        std::sort(memUsages.begin(), memUsages.end(),
-            [] (MemInfoData::MemUsage &left, MemInfoData::MemUsage &right) {
+        size_t count = (topN_ > 0) ? std::min(topN_, memUsages.size()) : memUsages.size();
+        std::partial_sort(memUsages.begin(), memUsages.begin() + count, memUsages.end(),
+            [] (const MemInfoData::MemUsage &left, const MemInfoData::MemUsage &right) {
             return right.pss + right.swapPss < left.pss + left.swapPss;
         });
-        for (const auto &memUsage : memUsages) {
+        for (size_t i = 0; i < count; i++) {
+            auto &memUsage = memUsages[i];
+            if (memUsage.name.empty()) {
+                memUsage.name = GetProcName(memUsage.pid);
+            }
             string name = PRE_BLANK + memUsage.name + "(pid=" + to_string(memUsage.pid) + "): ";
             StringUtils::GetInstance().SetWidth(NAME_AND_PID_WIDTH, BLANK_, true, name);
             name += AddKbUnit(memUsage.pss + memUsage.swapPss);
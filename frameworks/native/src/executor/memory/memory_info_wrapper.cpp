@@ -14,19 +14,81 @@
  */
 #include "executor/memory/memory_info_wrapper.h"
 #include <dlfcn.h>
+#include <functional>
+#include <mutex>
 #include <vector>
 #include <string>
 #include "hilog_wrapper.h"
 
+namespace {
+constexpr size_t MAX_IDLE_OBJECTS = 2;
+
+// keeps a few warmed-up objects, plugin loaded and tables built, for the following requests.
+template <typename T>
+class ObjectPool {
+public:
+    using Ptr = std::unique_ptr<T, std::function<void(T *)>>;
+
+    Ptr Acquire()
+    {
+        std::unique_ptr<T> object;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!idle_.empty()) {
+                object = std::move(idle_.back());
+                idle_.pop_back();
+            }
+        }
+        if (object == nullptr) {
+            object = std::make_unique<T>();
+        }
+        return Ptr(object.release(), [this](T *released) { Release(std::unique_ptr<T>(released)); });
+    }
+
+    void Clear()
+    {
+        std::vector<std::unique_ptr<T>> idle;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            idle.swap(idle_);
+        }
+    }
+
+private:
+    void Release(std::unique_ptr<T> object)
+    {
+        ResetObject(*object);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (idle_.size() < MAX_IDLE_OBJECTS) {
+            idle_.push_back(std::move(object));
+        }
+    }
+    static void ResetObject(OHOS::HiviewDFX::MemoryInfo &memoryInfo)
+    {
+        memoryInfo.Reset();
+    }
+    static void ResetObject(OHOS::HiviewDFX::SmapsMemoryInfo &)
+    {
+    }
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<T>> idle_;
+};
+
+ObjectPool<OHOS::HiviewDFX::MemoryInfo> g_memoryInfoPool;
+ObjectPool<OHOS::HiviewDFX::SmapsMemoryInfo> g_smapsMemoryInfoPool;
+} // namespace
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 using StringMatrix = std::shared_ptr<std::vector<std::vector<std::string>>>;
+using ProcessFilter = OHOS::HiviewDFX::ColumnRowsQuery::ProcessFilter;
 
 int GetMemoryInfoByPid(int pid, StringMatrix data, bool showAshmem, bool showDmaBuf, bool showGpumem)
 {
-    std::unique_ptr<OHOS::HiviewDFX::MemoryInfo> memoryInfo = std::make_unique<OHOS::HiviewDFX::MemoryInfo>();
+    auto memoryInfo = g_memoryInfoPool.Acquire();
     if (!memoryInfo->GetMemoryInfoByPid(pid, data, showAshmem, showDmaBuf, showGpumem)) {
         DUMPER_HILOGE(MODULE_SERVICE, "GetMemoryInfoByPid error, pid:%{public}d", pid);
         return OHOS::HiviewDFX::DumpStatus::DUMP_FAIL;
@@ -34,24 +96,36 @@ int GetMemoryInfoByPid(int pid, StringMatrix data, bool showAshmem, bool showDma
     return OHOS::HiviewDFX::DumpStatus::DUMP_OK;
 }
 
-int GetMemoryInfoNoPid(int fd, StringMatrix data)
+int GetMemoryInfoNoPid(int fd, StringMatrix data, const ProcessFilter &filter)
 {
-    std::unique_ptr<OHOS::HiviewDFX::MemoryInfo> memoryInfo = std::make_unique<OHOS::HiviewDFX::MemoryInfo>();
+    auto memoryInfo = g_memoryInfoPool.Acquire();
+    memoryInfo->SetProcessFilter(filter);
     int ret = memoryInfo->GetMemoryInfoNoPid(fd, data);
     return ret;
 }
 
-int GetMemoryInfoPrune(int fd, StringMatrix data)
+int GetMemoryInfoPrune(int fd, StringMatrix data, const ProcessFilter &filter)
 {
-    std::unique_ptr<OHOS::HiviewDFX::MemoryInfo> memoryInfo = std::make_unique<OHOS::HiviewDFX::MemoryInfo>();
+    auto memoryInfo = g_memoryInfoPool.Acquire();
+    memoryInfo->SetProcessFilter(filter);
     int ret = memoryInfo->GetMemoryInfoPrune(fd, data);
     return ret;
 }
 
+int GetMemoryInfoTop(int fd, StringMatrix data, int topN, bool prune, const ProcessFilter &filter)
+{
+    if (topN <= 0) {
+        return OHOS::HiviewDFX::DumpStatus::DUMP_FAIL;
+    }
+    auto memoryInfo = g_memoryInfoPool.Acquire();
+    memoryInfo->SetProcessFilter(filter);
+    int ret = memoryInfo->GetMemoryInfoTop(fd, static_cast<size_t>(topN), prune, data);
+    return ret;
+}
+
 int ShowMemorySmapsByPid(int pid, StringMatrix data, bool isShowSmapsInfo)
 {
-    std::unique_ptr<OHOS::HiviewDFX::SmapsMemoryInfo> smapsMemoryInfo =
-        std::make_unique<OHOS::HiviewDFX::SmapsMemoryInfo>();
+    auto smapsMemoryInfo = g_smapsMemoryInfoPool.Acquire();
     if (!smapsMemoryInfo->ShowMemorySmapsByPid(pid, data, isShowSmapsInfo)) {
         DUMPER_HILOGE(MODULE_SERVICE, "ShowMemorySmapsByPid error, pid:%{public}d", pid);
         return OHOS::HiviewDFX::DumpStatus::DUMP_FAIL;
@@ -61,16 +135,22 @@ int ShowMemorySmapsByPid(int pid, StringMatrix data, bool isShowSmapsInfo)
 
 void GetMemoryInfoByTimeInterval(int fd, int pid, int timeInterval)
 {
-    std::unique_ptr<OHOS::HiviewDFX::MemoryInfo> memoryInfo = std::make_unique<OHOS::HiviewDFX::MemoryInfo>();
+    auto memoryInfo = g_memoryInfoPool.Acquire();
     memoryInfo->GetMemoryInfoByTimeInterval(fd, pid, timeInterval);
 }
 
 void SetReceivedSigInt(bool isReceivedSigInt)
 {
-    std::unique_ptr<OHOS::HiviewDFX::MemoryInfo> memoryInfo = std::make_unique<OHOS::HiviewDFX::MemoryInfo>();
+    auto memoryInfo = g_memoryInfoPool.Acquire();
     memoryInfo->SetReceivedSigInt(isReceivedSigInt);
 }
 
+void ReleaseMemoryInfoPool()
+{
+    g_memoryInfoPool.Clear();
+    g_smapsMemoryInfoPool.Clear();
+}
+
 #ifdef __cplusplus
 }
-#endif
\ No newline at end of file
+#endif
@@ -18,6 +18,7 @@
 #include <thread>
 #include <vector>
 #include "securec.h"
+#include "util/command_runner.h"
 #include "util/string_utils.h"
 #include "hilog_wrapper.h"
 using namespace std;
@@ -88,25 +89,10 @@ void MemoryUtil::CalcGroup(const string &group, const string &type, const uint64
 
 bool MemoryUtil::RunCMD(const string &cmd, vector<string> &result)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    FILE* fp = popen(("/system/bin/" + cmd).c_str(), "r");
-    if (fp == nullptr) {
-        return false;
-    }
-    char* buffer = nullptr;
-    size_t len = 0;
-    while (getline(&buffer, &len, fp) != -1) {
-        std::string line = buffer;
-        StringUtils::GetInstance().ReplaceAll(line, "\n", "");
+    return CommandRunner::Run("/system/bin/" + cmd, [&result](const string &line) {
         result.push_back(line);
-    }
-    // free memory
-    if (buffer != nullptr) {
-        free(buffer);
-        buffer = nullptr;
-    }
-    pclose(fp);
-    return true;
+        return true;
+    });
 }
 
 size_t MemoryUtil::GetMaxThreadNum(const size_t &threadNum)
@@ -71,7 +71,7 @@ bool ParseAshmemInfo::GetAshmemInfo(const int32_t &pid, pair<int, vector<string>
 {
     DUMPER_HILOGD(MODULE_SERVICE, "GetAshmemInfo begin, pid:%{public}d", pid);
     bool inDetailSection = false;
-    std::string path = "/proc/ashmem_process_info";
+    std::string path = FileUtils::GetInstance().GetProcPath("/proc/ashmem_process_info");
     std::string processName = "unknown";
     std::string detailTitle = "";
     std::vector<string> details;
@@ -88,7 +88,8 @@ bool ParseDmaBufInfo::GetDmaBufInfo(const int32_t &pid, std::vector<std::string>
     columnWidthsTmp_.clear();
     titlesTmp_.clear();
 
-    const std::string path = "/proc/" + std::to_string(pid) + "/mm_dmabuf_info";
+    const std::string path =
+        FileUtils::GetInstance().GetProcPath("/proc/" + std::to_string(pid) + "/mm_dmabuf_info");
 
     bool ret = FileUtils::GetInstance().LoadStringFromProcCb(path, false, true,
         [&](const std::string &line) -> void {
@@ -54,7 +54,7 @@ void ParseMeminfo::SetData(const string &str, ValueMap &result)
  */
 bool ParseMeminfo::GetMeminfo(ValueMap &result)
 {
-    string path = "/proc/meminfo";
+    string path = FileUtils::GetInstance().GetProcPath("/proc/meminfo");
     bool ret = FileUtils::GetInstance().LoadStringFromProcCb(path, false, true, [&](const string& line) -> void {
         SetData(line, result);
     });
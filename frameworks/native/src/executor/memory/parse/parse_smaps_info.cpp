@@ -91,7 +91,7 @@ bool ParseSmapsInfo::GetInfo(const MemoryFilter::MemoryType &memType, const int
                              GroupMap &nativeMap, GroupMap &result)
 {
     DUMPER_HILOGD(MODULE_SERVICE, "ParseSmapsInfo: GetInfo pid:(%{public}d) begin.\n", pid);
-    string path = "/proc/" + to_string(pid) + "/smaps";
+    string path = FileUtils::GetInstance().GetProcPath("/proc/" + to_string(pid) + "/smaps");
     bool ret = FileUtils::GetInstance().LoadStringFromProcCb(path, false, true, [&](const string& line) -> void {
         string name;
         uint64_t iNode = 0;
@@ -78,7 +78,7 @@ void ParseSmapsRollupInfo::GetValue(const string &str, MemInfoData::MemInfo &mem
 
 bool ParseSmapsRollupInfo::GetMemInfo(const int &pid, MemInfoData::MemInfo &memInfo)
 {
-    string path = "/proc/" + to_string(pid) + "/smaps_rollup";
+    string path = FileUtils::GetInstance().GetProcPath("/proc/" + to_string(pid) + "/smaps_rollup");
     bool ret = FileUtils::GetInstance().LoadStringFromProcCb(path, false, true, [&](const string& line) -> void {
         GetValue(line, memInfo);
     });
@@ -51,7 +51,7 @@ void ParseVmallocinfo::CaclVmalloclValue(const string &str, uint64_t &totalValue
 bool ParseVmallocinfo::GetVmallocinfo(uint64_t &value)
 {
     value = 0;
-    string path = "/proc/vmallocinfo";
+    string path = FileUtils::GetInstance().GetProcPath("/proc/vmallocinfo");
     bool ret = FileUtils::GetInstance().LoadStringFromProcCb(path, false, true, [&](const string& line) -> void {
         if (line.find("pages=") != string::npos) {
             CaclVmalloclValue(line, value);
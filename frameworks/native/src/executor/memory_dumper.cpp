@@ -15,6 +15,7 @@
 #include "executor/memory_dumper.h"
 #include "dump_utils.h"
 #include <dlfcn.h>
+#include <mutex>
 #include "common/dumper_constant.h"
 
 using namespace std;
@@ -22,6 +23,84 @@ namespace OHOS {
 namespace HiviewDFX {
 static const std::string MEM_LIB = "libhidumpermemory.z.so";
 
+// entry points of the memory library, resolved once when it is opened.
+struct MemoryDumper::MemoryLibrary {
+    void *handle = nullptr;
+    GetMemByPidFunc getMemByPid = nullptr;
+    GetMemNoPidFunc getMemNoPid = nullptr;
+    GetMemPruneNoPidFunc getMemPruneNoPid = nullptr;
+    GetMemTopNoPidFunc getMemTopNoPid = nullptr;
+    GetMemSmapsByPidFunc getMemSmapsByPid = nullptr;
+    GetMemByTimeIntervalFunc getMemByTimeInterval = nullptr;
+    SetReceivedSigIntFunc setReceivedSigInt = nullptr;
+    ReleaseMemoryInfoPoolFunc releaseMemoryInfoPool = nullptr;
+
+    ~MemoryLibrary()
+    {
+        if (releaseMemoryInfoPool != nullptr) {
+            releaseMemoryInfoPool();
+        }
+        if (handle != nullptr) {
+            dlclose(handle);
+        }
+    }
+};
+
+std::mutex MemoryDumper::memoryLibraryMutex_;
+std::shared_ptr<MemoryDumper::MemoryLibrary> MemoryDumper::memoryLibrary_;
+
+namespace {
+template <typename Func>
+Func LoadSymbol(void *handle, const char *name)
+{
+    Func func = reinterpret_cast<Func>(dlsym(handle, name));
+    if (func == nullptr) {
+        DUMPER_HILOGE(MODULE_SERVICE, "fail to dlsym %{public}s. errno:%{public}s", name, dlerror());
+    }
+    return func;
+}
+} // namespace
+
+std::shared_ptr<MemoryDumper::MemoryLibrary> MemoryDumper::AcquireMemoryLibrary()
+{
+    std::lock_guard<std::mutex> lock(memoryLibraryMutex_);
+    if (memoryLibrary_ != nullptr) {
+        return memoryLibrary_;
+    }
+    // the library starts detached threads of its own, so its code stays mapped after dlclose.
+    void *handle = dlopen(MEM_LIB.c_str(), RTLD_LAZY | RTLD_NODELETE);
+    if (handle == nullptr) {
+        DUMPER_HILOGE(MODULE_SERVICE, "fail to open %{public}s. errno:%{public}s", MEM_LIB.c_str(), dlerror());
+        return nullptr;
+    }
+    auto library = std::make_shared<MemoryLibrary>();
+    library->handle = handle;
+    library->getMemByPid = LoadSymbol<GetMemByPidFunc>(handle, "GetMemoryInfoByPid");
+    library->getMemNoPid = LoadSymbol<GetMemNoPidFunc>(handle, "GetMemoryInfoNoPid");
+    library->getMemPruneNoPid = LoadSymbol<GetMemPruneNoPidFunc>(handle, "GetMemoryInfoPrune");
+    library->getMemTopNoPid = LoadSymbol<GetMemTopNoPidFunc>(handle, "GetMemoryInfoTop");
+    library->getMemSmapsByPid = LoadSymbol<GetMemSmapsByPidFunc>(handle, "ShowMemorySmapsByPid");
+    library->getMemByTimeInterval = LoadSymbol<GetMemByTimeIntervalFunc>(handle, "GetMemoryInfoByTimeInterval");
+    library->setReceivedSigInt = LoadSymbol<SetReceivedSigIntFunc>(handle, "SetReceivedSigInt");
+    library->releaseMemoryInfoPool = LoadSymbol<ReleaseMemoryInfoPoolFunc>(handle, "ReleaseMemoryInfoPool");
+    DUMPER_HILOGI(MODULE_SERVICE, "open %{public}s", MEM_LIB.c_str());
+    memoryLibrary_ = library;
+    return library;
+}
+
+void MemoryDumper::ReleaseMemoryLibrary()
+{
+    std::shared_ptr<MemoryLibrary> library;
+    {
+        std::lock_guard<std::mutex> lock(memoryLibraryMutex_);
+        library.swap(memoryLibrary_);
+    }
+    if (library != nullptr) {
+        DUMPER_HILOGI(MODULE_SERVICE, "release %{public}s, users:%{public}ld", MEM_LIB.c_str(),
+            static_cast<long>(library.use_count() - 1));
+    }
+}
+
 MemoryDumper::MemoryDumper()
 {
 }
@@ -29,8 +108,12 @@ MemoryDumper::MemoryDumper()
 MemoryDumper::~MemoryDumper()
 {
     if (isZip_ && rawParamFd_ >= 0) {
-        fdsan_exchange_owner_tag(rawParamFd_, 0, FDTAG);
-        fdsan_close_with_tag(rawParamFd_, FDTAG);
+        if (stagingArea_ != nullptr) {
+            stagingArea_->CloseEntry(rawParamFd_);
+        } else {
+            fdsan_exchange_owner_tag(rawParamFd_, 0, FDTAG);
+            fdsan_close_with_tag(rawParamFd_, FDTAG);
+        }
         rawParamFd_ = -1;
     }
 }
@@ -43,10 +126,17 @@ DumpStatus MemoryDumper::PreExecute(const shared_ptr<DumperParameter> &parameter
     isShowSmapsInfo_ =  parameter->GetOpts().isShowSmapsInfo_;
     isReceivedSigInt_ = parameter->GetOpts().isReceivedSigInt_;
     dumpMemPrune_ = parameter->GetOpts().dumpMemPrune_;
+    memTopN_ = parameter->GetOpts().memTopN_;
     showAshmem_ = parameter->GetOpts().showAshmem_;
     showDmabuf_ = parameter->GetOpts().showDmaBuf_;
     showGpumem_ = parameter->GetOpts().showGpumem_;
     dumpDatas_ = dumpDatas;
+    processFilter_ = ColumnRowsQuery::ProcessFilter();
+    ColumnRowsQuery query;
+    std::string errStr;
+    if (!parameter->GetOpts().query_.empty() && query.Parse(parameter->GetOpts().query_, errStr)) {
+        processFilter_ = query.GetProcessFilter();
+    }
 
     isZip_ = parameter->GetOpts().IsDumpZip();
     auto callback = parameter->getClientCallback();
@@ -56,7 +146,9 @@ DumpStatus MemoryDumper::PreExecute(const shared_ptr<DumperParameter> &parameter
     }
     std::string logDefaultPath_ = callback->GetFolder() + "log.txt";
     if (isZip_) {
-        rawParamFd_ = DumpUtils::FdToWrite(logDefaultPath_);
+        stagingArea_ = callback->GetStagingArea();
+        rawParamFd_ = (stagingArea_ != nullptr) ? stagingArea_->OpenEntry(LOG_DEFAULT) :
+            DumpUtils::FdToWrite(logDefaultPath_);
     } else {
         rawParamFd_ = parameter->getClientCallback()->GetOutputFd();
     }
@@ -85,7 +177,9 @@ DumpStatus MemoryDumper::Execute()
             }
             GetMemByPid();
         } else {
-            if (dumpMemPrune_) {
+            if (memTopN_ > 0) {
+                GetMemTopNoPid();
+            } else if (dumpMemPrune_) {
                 GetMemPruneNoPid();
             } else {
                 GetMemNoPid();
@@ -98,120 +192,90 @@ DumpStatus MemoryDumper::Execute()
 
 void MemoryDumper::GetMemByPid()
 {
-    void *handle = dlopen(MEM_LIB.c_str(), RTLD_LAZY | RTLD_NODELETE);
-    if (handle == nullptr) {
-        DUMPER_HILOGE(MODULE_SERVICE, "fail to open %{public}s. errno:%{public}s", MEM_LIB.c_str(), dlerror());
-        return;
-    }
-    GetMemByPidFunc pfn = reinterpret_cast<GetMemByPidFunc>(dlsym(handle, "GetMemoryInfoByPid"));
-    if (pfn == nullptr) {
-        DUMPER_HILOGE(MODULE_SERVICE, "fail to dlsym GetMemoryInfoByPid. errno:%{public}s", dlerror());
-        dlclose(handle);
+    auto library = AcquireMemoryLibrary();
+    if ((library == nullptr) || (library->getMemByPid == nullptr)) {
         return;
     }
-    if (!pfn(pid_, dumpDatas_, showAshmem_, showDmabuf_, showGpumem_)) {
+    if (!library->getMemByPid(pid_, dumpDatas_, showAshmem_, showDmabuf_, showGpumem_)) {
         status_ = DumpStatus::DUMP_OK;
     } else {
         DUMPER_HILOGE(MODULE_SERVICE, "MemoryDumper Execute failed, pid:%{public}d", pid_);
         status_ = DumpStatus::DUMP_FAIL;
     }
-    dlclose(handle);
 }
 
 void MemoryDumper::GetMemNoPid()
 {
-    void* handle = dlopen(MEM_LIB.c_str(), RTLD_LAZY | RTLD_NODELETE);
-    if (handle == nullptr) {
-        DUMPER_HILOGE(MODULE_SERVICE, "fail to open %{public}s. errno:%{public}s", MEM_LIB.c_str(), dlerror());
+    auto library = AcquireMemoryLibrary();
+    if (library == nullptr) {
         return;
     }
-    GetMemNoPidFunc getMemNoPidFunc = reinterpret_cast<GetMemNoPidFunc>(dlsym(handle, "GetMemoryInfoNoPid"));
-    if (getMemNoPidFunc == nullptr) {
-        DUMPER_HILOGE(MODULE_SERVICE, "fail to dlsym GetMemoryInfoNoPid. errno:%{public}s", dlerror());
-        dlclose(handle);
+    if (library->getMemNoPid == nullptr) {
         status_ = DUMP_FAIL;
         return;
     }
-    status_ = (DumpStatus)(getMemNoPidFunc(rawParamFd_, dumpDatas_));
-    dlclose(handle);
+    status_ = (DumpStatus)(library->getMemNoPid(rawParamFd_, dumpDatas_, processFilter_));
 }
 
 void MemoryDumper::GetMemPruneNoPid()
 {
-    void* handle = dlopen(MEM_LIB.c_str(), RTLD_LAZY | RTLD_NODELETE);
-    if (handle == nullptr) {
-        DUMPER_HILOGE(MODULE_SERVICE, "fail to open %{public}s. errno:%{public}s", MEM_LIB.c_str(), dlerror());
+    auto library = AcquireMemoryLibrary();
+    if (library == nullptr) {
         return;
     }
-    GetMemPruneNoPidFunc getMemPruneNoPidFunc = reinterpret_cast<GetMemPruneNoPidFunc>(
-        dlsym(handle, "GetMemoryInfoPrune"));
-    if (getMemPruneNoPidFunc == nullptr) {
-        DUMPER_HILOGE(MODULE_SERVICE, "fail to dlsym GetMemoryInfoPrune. errno:%{public}s", dlerror());
-        dlclose(handle);
+    if (library->getMemPruneNoPid == nullptr) {
         status_ = DUMP_FAIL;
         return;
     }
-    status_ = (DumpStatus)(getMemPruneNoPidFunc(rawParamFd_, dumpDatas_));
-    dlclose(handle);
+    status_ = (DumpStatus)(library->getMemPruneNoPid(rawParamFd_, dumpDatas_, processFilter_));
 }
 
-void MemoryDumper::GetMemSmapsByPid()
+void MemoryDumper::GetMemTopNoPid()
 {
-    void *handle = dlopen(MEM_LIB.c_str(), RTLD_LAZY | RTLD_NODELETE);
-    if (handle == nullptr) {
-        DUMPER_HILOGE(MODULE_SERVICE, "fail to open %{public}s. errno:%{public}s", MEM_LIB.c_str(), dlerror());
+    auto library = AcquireMemoryLibrary();
+    if (library == nullptr) {
+        return;
+    }
+    if (library->getMemTopNoPid == nullptr) {
+        status_ = DUMP_FAIL;
         return;
     }
-    GetMemSmapsByPidFunc pfn = reinterpret_cast<GetMemSmapsByPidFunc>(dlsym(handle, "ShowMemorySmapsByPid"));
-    if (pfn == nullptr) {
-        DUMPER_HILOGE(MODULE_SERVICE, "fail to dlsym ShowMemorySmapsByPid. errno:%{public}s", dlerror());
-        dlclose(handle);
+    status_ = (DumpStatus)(library->getMemTopNoPid(rawParamFd_, dumpDatas_, memTopN_, dumpMemPrune_,
+        processFilter_));
+}
+
+void MemoryDumper::GetMemSmapsByPid()
+{
+    auto library = AcquireMemoryLibrary();
+    if ((library == nullptr) || (library->getMemSmapsByPid == nullptr)) {
         return;
     }
-    if (!pfn(pid_, dumpDatas_, isShowSmapsInfo_)) {
+    if (!library->getMemSmapsByPid(pid_, dumpDatas_, isShowSmapsInfo_)) {
         status_ = DumpStatus::DUMP_OK;
     } else {
         DUMPER_HILOGE(MODULE_SERVICE, "GetMemSmapsByPid failed, pid:%{public}d", pid_);
         status_ = DumpStatus::DUMP_FAIL;
     }
-    dlclose(handle);
 }
 
 void MemoryDumper::GetMemByTimeInterval()
 {
-    void *handle = dlopen(MEM_LIB.c_str(), RTLD_LAZY | RTLD_NODELETE);
-    if (handle == nullptr) {
-        DUMPER_HILOGE(MODULE_SERVICE, "fail to open %{public}s. errno:%{public}s", MEM_LIB.c_str(), dlerror());
+    auto library = AcquireMemoryLibrary();
+    if ((library == nullptr) || (library->getMemByTimeInterval == nullptr)) {
         return;
     }
-    GetMemByTimeIntervalFunc pfn = reinterpret_cast<GetMemByTimeIntervalFunc>(
-        dlsym(handle, "GetMemoryInfoByTimeInterval"));
-    if (pfn == nullptr) {
-        DUMPER_HILOGE(MODULE_SERVICE, "fail to dlsym GetMemoryInfoByTimeInterval. errno:%{public}s", dlerror());
-        dlclose(handle);
-        return;
-    }
-    pfn(rawParamFd_, pid_, timeInterval_);
+    library->getMemByTimeInterval(rawParamFd_, pid_, timeInterval_);
     status_ = DumpStatus::DUMP_OK;
-    dlclose(handle);
 }
 
 void MemoryDumper::SetReceivedSigInt()
 {
-    void *handle = dlopen(MEM_LIB.c_str(), RTLD_LAZY | RTLD_NODELETE);
-    if (handle == nullptr) {
-        DUMPER_HILOGE(MODULE_SERVICE, "fail to open %{public}s. errno:%{public}s", MEM_LIB.c_str(), dlerror());
-        return;
-    }
-    SetReceivedSigIntFunc pfn = reinterpret_cast<SetReceivedSigIntFunc>(dlsym(handle, "SetReceivedSigInt"));
-    if (pfn == nullptr) {
-        DUMPER_HILOGE(MODULE_SERVICE, "fail to dlsym SetReceivedSigInt. errno:%{public}s", dlerror());
-        dlclose(handle);
+    auto library = AcquireMemoryLibrary();
+    if ((library == nullptr) || (library->setReceivedSigInt == nullptr)) {
         return;
     }
-    pfn(isReceivedSigInt_);
+    library->setReceivedSigInt(isReceivedSigInt_);
     status_ = DumpStatus::DUMP_OK;
-    dlclose(handle);
 }
 
 DumpStatus MemoryDumper::AfterExecute()
@@ -40,8 +40,12 @@ SADumper::SADumper(void)
 SADumper::~SADumper(void)
 {
     if (isZip_ && outputFd_ >= 0) {
-        fdsan_exchange_owner_tag(outputFd_, 0, FDTAG);
-        fdsan_close_with_tag(outputFd_, FDTAG);
+        if (stagingArea_ != nullptr) {
+            stagingArea_->CloseEntry(outputFd_);
+        } else {
+            fdsan_exchange_owner_tag(outputFd_, 0, FDTAG);
+            fdsan_close_with_tag(outputFd_, FDTAG);
+        }
         outputFd_ = -1;
     }
 }
@@ -58,7 +62,9 @@ DumpStatus SADumper::PreExecute(const std::shared_ptr<DumperParameter> &paramete
     }
     std::string logDefaultPath_ = callback->GetFolder() + LOG_TXT;
     if (isZip_) {
-        outputFd_ = DumpUtils::FdToWrite(logDefaultPath_);
+        stagingArea_ = callback->GetStagingArea();
+        outputFd_ = (stagingArea_ != nullptr) ? stagingArea_->OpenEntry(LOG_TXT) :
+            DumpUtils::FdToWrite(logDefaultPath_);
     } else {
         outputFd_ = parameter->getClientCallback()->GetOutputFd();
     }
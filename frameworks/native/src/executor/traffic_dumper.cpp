@@ -93,29 +93,11 @@ void TrafficDumper::GetApplicationUidBytes()
         return;
     }
     uint64_t receivedStats = 0;
-#ifdef HIDUMPER_NETMANAGER_BASE_ENABLE
-    int32_t ret = DelayedSingleton<NetManagerStandard::NetStatsClient>::GetInstance()->GetUidRxBytes(
-        receivedStats, static_cast<uint32_t>(currentPidInfo.uid_));
-    if (ret != NetManagerStandard::NETMANAGER_SUCCESS) {
-        DUMPER_HILOGE(MODULE_SERVICE, "GetUidRxBytes failed, ret:%{public}d, uid:%{public}d.\n",
-            ret, currentPidInfo.uid_);
-        status_ = DumpStatus::DUMP_FAIL;
-    }
-#endif
+    uint64_t sendStats = 0;
+    GetUidBytes(static_cast<uint32_t>(currentPidInfo.uid_), receivedStats, sendStats);
     std::vector<std::string> line_vector;
     line_vector.push_back(RECEIVED_BYTES + std::to_string(receivedStats));
     result_->push_back(line_vector);
-
-    uint64_t sendStats = 0;
-#ifdef HIDUMPER_NETMANAGER_BASE_ENABLE
-    ret = DelayedSingleton<NetManagerStandard::NetStatsClient>::GetInstance()->GetUidTxBytes(
-        sendStats, static_cast<uint32_t>(currentPidInfo.uid_));
-    if (ret != NetManagerStandard::NETMANAGER_SUCCESS) {
-        DUMPER_HILOGE(MODULE_SERVICE, "GetUidTxBytes failed, ret:%{public}d, uid:%{public}d.\n",
-            ret, currentPidInfo.uid_);
-        status_ = DumpStatus::DUMP_FAIL;
-    }
-#endif
     line_vector.clear();
     line_vector.push_back(SEND_BYTES + std::to_string(sendStats));
     result_->push_back(line_vector);
@@ -123,5 +105,22 @@ void TrafficDumper::GetApplicationUidBytes()
     DUMPER_HILOGD(MODULE_SERVICE, "debug|GetApplicationUidBytes end, pid:%{public}d, uid:%{public}d.\n",
         pid_, currentPidInfo.uid_);
 }
+
+void TrafficDumper::GetUidBytes(uint32_t uid, uint64_t &receivedStats, uint64_t &sendStats)
+{
+#ifdef HIDUMPER_NETMANAGER_BASE_ENABLE
+    int32_t ret = DelayedSingleton<NetManagerStandard::NetStatsClient>::GetInstance()->GetUidRxBytes(
+        receivedStats, uid);
+    if (ret != NetManagerStandard::NETMANAGER_SUCCESS) {
+        DUMPER_HILOGE(MODULE_SERVICE, "GetUidRxBytes failed, ret:%{public}d, uid:%{public}u.\n", ret, uid);
+        status_ = DumpStatus::DUMP_FAIL;
+    }
+    ret = DelayedSingleton<NetManagerStandard::NetStatsClient>::GetInstance()->GetUidTxBytes(sendStats, uid);
+    if (ret != NetManagerStandard::NETMANAGER_SUCCESS) {
+        DUMPER_HILOGE(MODULE_SERVICE, "GetUidTxBytes failed, ret:%{public}d, uid:%{public}u.\n", ret, uid);
+        status_ = DumpStatus::DUMP_FAIL;
+    }
+#endif
+}
 }  // namespace HiviewDFX
 }  // namespace OHOS
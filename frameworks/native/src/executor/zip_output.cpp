@@ -17,6 +17,7 @@
 #include "securec.h"
 #include "dump_utils.h"
 #include "util/file_utils.h"
+#include "util/trace_recorder.h"
 #include "common/dumper_constant.h"
 namespace OHOS {
 namespace HiviewDFX {
@@ -114,8 +115,12 @@ DumpStatus ZipOutput::CompressAndWriteToFd()
     }
     DumpStatus ret = DumpStatus::DUMP_OK;
     if (srcBuffer->offset > 0) {
-        ret = compressor_.Compress(srcBuffer, destBuffer);
+        {
+            TraceSpan span("zip", "Compress");
+            ret = compressor_.Compress(srcBuffer, destBuffer);
+        }
         if (ret == DumpStatus::DUMP_OK) {
+            TraceSpan span("output", "ZipWrite");
             if (write(fd_, destBuffer->content, destBuffer->offset) < 0) {
                 ret = DumpStatus::DUMP_FAIL;
                 LOG_DEBUG("ZipOutput::CompressAndWriteToFd() Write to FD failed!\n");
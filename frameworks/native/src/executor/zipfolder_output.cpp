@@ -18,6 +18,7 @@
 #include "file_ex.h"
 #include "directory_ex.h"
 #include "hilog_wrapper.h"
+#include "util/trace_recorder.h"
 #include "util/zip_utils.h"
 #include "dump_common_utils.h"
 #include "common/dumper_constant.h"
@@ -60,10 +61,13 @@ DumpStatus ZipFolderOutput::PreExecute(const std::shared_ptr<DumperParameter>& p
             return DumpStatus::DUMP_FAIL;
         }
         logDefaultPath_ = callback->GetFolder() + LOG_DEFAULT;
-        fd_= DumpUtils::FdToWrite(logDefaultPath_);
+        stagingArea_ = callback->GetStagingArea();
+        if (stagingArea_ == nullptr) {
+            fd_= DumpUtils::FdToWrite(logDefaultPath_);
+        }
     }
 
-    if (fd_ < 0) {
+    if ((stagingArea_ == nullptr) && (fd_ < 0)) {
         DUMPER_HILOGE(MODULE_COMMON, "PreExecute error|fd has issue");
         return DumpStatus::DUMP_FAIL;
     }
@@ -75,7 +79,7 @@ DumpStatus ZipFolderOutput::PreExecute(const std::shared_ptr<DumperParameter>& p
 DumpStatus ZipFolderOutput::Execute()
 {
     DUMPER_HILOGI(MODULE_COMMON, "info|ZipFolderOutput Execute");
-    if ((dumpDatas_ == nullptr) || (fd_ < 0)) {
+    if ((dumpDatas_ == nullptr) || ((stagingArea_ == nullptr) && (fd_ < 0))) {
         DUMPER_HILOGE(MODULE_COMMON, "Execute error|dumpDatas or fd has issue");
         return DumpStatus::DUMP_FAIL;
     }
@@ -96,11 +100,18 @@ DumpStatus ZipFolderOutput::Execute()
         outstr.append(line);
         line.clear();
     }
-    if (lseek(fd_, 0, SEEK_END) == -1) {
-        DUMPER_HILOGE(MODULE_COMMON, "lseek fail fd:%{public}d, errno:%{public}d", fd_, errno);
-    }
-    if (!outstr.empty()) {
-        SaveStringToFd(fd_, outstr);
+    TraceSpan span("output", "FolderWrite");
+    if (stagingArea_ != nullptr) {
+        if (!outstr.empty() && !stagingArea_->Append(LOG_DEFAULT, outstr)) {
+            DUMPER_HILOGE(MODULE_COMMON, "Execute error|append staging entry, errno:%{public}d", errno);
+        }
+    } else {
+        if (lseek(fd_, 0, SEEK_END) == -1) {
+            DUMPER_HILOGE(MODULE_COMMON, "lseek fail fd:%{public}d, errno:%{public}d", fd_, errno);
+        }
+        if (!outstr.empty()) {
+            SaveStringToFd(fd_, outstr);
+        }
     }
     outstr.clear();
     DUMPER_HILOGI(MODULE_COMMON, "info|ZipFolderOutput Execute end");
@@ -130,13 +141,18 @@ void ZipFolderOutput::Reset()
         DUMPER_HILOGD(MODULE_COMMON, "Reset debug|ZipFolder");
         auto logZipPath = param_->GetOpts().path_;
         auto logFolder = callback->GetFolder();
+        std::vector<std::pair<int, std::string>> memoryEntries;
+        if (stagingArea_ != nullptr) {
+            memoryEntries = stagingArea_->GetMemoryEntries();
+        }
         ZipUtils::ZipFolder(logFolder, logZipPath, [callback] (int progress, int subprogress) {
             callback->UpdateProgress(0);
             return callback->IsCanceled();
-        });
+        }, memoryEntries);
     }
 
     param_ = nullptr;
+    stagingArea_ = nullptr;
 
     HidumperExecutor::Reset();
 }
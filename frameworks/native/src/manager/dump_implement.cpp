@@ -44,6 +44,7 @@
 #include "string_ex.h"
 #include "file_ex.h"
 #include "util/string_utils.h"
+#include "util/trace_recorder.h"
 #include "common/dumper_constant.h"
 #include "securec.h"
 #include "parameters.h"
@@ -52,6 +53,7 @@
 #include "hisysevent.h"
 #endif
 #include "manager/dump_manager.h"
+#include "manager/dumper_stage_pool.h"
 
 #include <unordered_set>
 namespace OHOS {
@@ -64,6 +66,9 @@ static struct option LONG_OPTIONS[] = {{"cpufreq", no_argument, 0, 0},
     {"net", no_argument, 0, 0},
     {"storage", no_argument, 0, 0},
     {"zip", no_argument, 0, 0},
+    {"machine-progress", no_argument, 0, 0},
+    {"query", required_argument, 0, 0},
+    {"trace", no_argument, 0, 0},
     {"mem-smaps", required_argument, 0, 0},
     {"mem-jsheap", required_argument, 0, 0},
     {"mem-cjheap", required_argument, 0, 0},
@@ -80,6 +85,7 @@ static struct option LONG_OPTIONS[] = {{"cpufreq", no_argument, 0, 0},
     {"raw", no_argument, 0, 0},
     {"single", no_argument, 0, 0},
     {"prune", no_argument, 0, 0},
+    {"top", required_argument, 0, 0},
     {"show-ashmem", no_argument, 0, 0},
     {"show-dmabuf", no_argument, 0, 0},
     #ifdef HIDUMPER_HIVIEWDFX_PLUGIN_ENABLE
@@ -157,6 +163,24 @@ DumpStatus DumpImplement::Main(int argc, char *argv[], const std::shared_ptr<Raw
     if (ret != DumpStatus::DUMP_OK) {
         return ret;
     }
+    if (!ptrDumperParameter->GetOpts().isTrace_) {
+        return DumpByParameter(argc, argv, reqCtl, ptrDumperParameter);
+    }
+    if (!TraceRecorder::Start()) {
+        DUMPER_HILOGW(MODULE_COMMON, "Another dump is tracing, dump without trace.");
+        return DumpByParameter(argc, argv, reqCtl, ptrDumperParameter);
+    }
+    std::string tracePath = GetTracePath(ptrDumperParameter->GetOpts());
+    ret = DumpByParameter(argc, argv, reqCtl, ptrDumperParameter);
+    if (SaveTrace(tracePath, TraceRecorder::Stop())) {
+        reqCtl->ReportTrace(tracePath);
+    }
+    return ret;
+}
+
+DumpStatus DumpImplement::DumpByParameter(int argc, char *argv[], const std::shared_ptr<RawParam> &reqCtl,
+    std::shared_ptr<DumperParameter> &ptrDumperParameter)
+{
     if (IsNewStructSupport(ptrDumperParameter)) {
         DumpContext context = DumpContext(reqCtl->GetUid(), reqCtl->GetPid(), reqCtl->GetOutputFd());
         return DumpManager::GetInstance().StartDump(argc, argv, context);
@@ -176,9 +200,18 @@ DumpStatus DumpImplement::Main(int argc, char *argv[], const std::shared_ptr<Raw
     }
 
     reqCtl->SetProgressEnabled(isZip);
-    isZip ? reqCtl->SetTitle(",The result is:" + path_) : reqCtl->SetTitle("");
+    if (ptrDumperParameter->GetOpts().isMachineProgress_) {
+        reqCtl->SetProgressMode(RawParam::ProgressMode::MACHINE);
+        reqCtl->SetTitle("result:" + path_);
+    } else {
+        isZip ? reqCtl->SetTitle(",The result is:" + path_) : reqCtl->SetTitle("");
+    }
     HidumperExecutor::StringMatrix dumpDatas = std::make_shared<std::vector<std::vector<std::string>>>();
-    ret = DumpDatas(hidumperExecutors, ptrDumperParameter, dumpDatas);
+    DumpStatus ret = DumpStatus::DUMP_OK;
+    {
+        TraceSpan span("executor", "DumpDatas");
+        ret = DumpDatas(hidumperExecutors, ptrDumperParameter, dumpDatas);
+    }
     std::lock_guard<std::mutex> lock(mutexCmdLock_); // lock for dumperSysEventParams_
     if (ret != DumpStatus::DUMP_OK) {
         DUMPER_HILOGE(MODULE_COMMON, "DUMP FAIL!!!");
@@ -191,6 +224,39 @@ DumpStatus DumpImplement::Main(int argc, char *argv[], const std::shared_ptr<Raw
     return DumpStatus::DUMP_OK;
 }
 
+std::string DumpImplement::GetTracePath(const DumperOpts &opts)
+{
+    // next to the zip of the dump, or in its folder when the dump goes to the client
+    const std::string zipSuffix = ".zip";
+    const std::string &path = opts.path_;
+    if ((path.size() > zipSuffix.size()) &&
+        (path.compare(path.size() - zipSuffix.size(), zipSuffix.size(), zipSuffix) == 0)) {
+        return path.substr(0, path.size() - zipSuffix.size()) + TRACE_SUFFIX;
+    }
+    return ZIP_FOLDER + GetTime() + TRACE_SUFFIX;
+}
+
+bool DumpImplement::SaveTrace(const std::string &path, const std::string &trace)
+{
+    if (trace.empty()) {
+        return false;
+    }
+    int fd = DumpUtils::FdToWrite(path);
+    if (fd < 0) {
+        DUMPER_HILOGE(MODULE_COMMON, "Open trace file failed, path:%{public}s", path.c_str());
+        return false;
+    }
+    fdsan_exchange_owner_tag(fd, 0, FDTAG);
+    bool saved = SaveStringToFd(fd, trace);
+    if (!saved) {
+        DUMPER_HILOGE(MODULE_COMMON, "Write trace file failed, errno:%{public}d", errno);
+    } else {
+        DUMPER_HILOGI(MODULE_COMMON, "Trace saved, path:%{public}s, size:%{public}zu", path.c_str(), trace.size());
+    }
+    fdsan_close_with_tag(fd, FDTAG);
+    return saved;
+}
+
 bool DumpImplement::IsNewStructSupport(std::shared_ptr<DumperParameter> ptrDumperParameter)
 {
     return false;
@@ -559,6 +625,12 @@ bool DumpImplement::ParseSubLongCmdOption(int argc, DumperOpts &opts, const stru
     } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "zip")) {
         path_ = ZIP_FOLDER + GetTime() + ".zip";
         opts.path_ = path_;
+    } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "machine-progress")) {
+        opts.isMachineProgress_ = true;
+    } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "query")) {
+        opts.query_ = (optarg != nullptr) ? optarg : "";
+    } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "trace")) {
+        opts.isTrace_ = true;
     } else {
         return false;
     }
@@ -612,6 +684,8 @@ DumpStatus DumpImplement::ParseLongCmdOption(int argc, DumperOpts &opts, const s
         return SetRawParam(opts);
     } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "prune")) {
         return SetMemPruneParam(opts);
+    } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "top")) {
+        return SetMemTopParam(opts);
     } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "gc")) {
         return SetGCParam(opts);
     } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "leakobj")) {
@@ -781,6 +855,18 @@ DumpStatus DumpImplement::SetMemPruneParam(DumperOpts &opt)
     return status;
 }
 
+DumpStatus DumpImplement::SetMemTopParam(DumperOpts &opt)
+{
+    if (!opt.isDumpMem_ || optarg == nullptr) {
+        return DumpStatus::DUMP_FAIL;
+    }
+    DumpStatus status = SetShowCount(optarg, opt.memTopN_);
+    if (status == DumpStatus::DUMP_OK) {
+        dumperSysEventParams_->opt = "mem";
+    }
+    return status;
+}
+
 DumpStatus DumpImplement::SetGCParam(DumperOpts &opt)
 {
     DumpStatus status = DumpStatus::DUMP_FAIL;
@@ -1001,6 +1087,7 @@ void DumpImplement::CmdHelp()
         "  --mem [pid] [--prune]       |dump memory usage of total; dump memory usage of specified"
         " pid if pid was specified; dump simplified memory information if prune is specified and not support"
         " dumped simplified memory information of specified pid\n"
+        "  --mem --top N [--prune]     |dump memory usage of the N processes using the most memory\n"
         "  --mem [pid] [--show-ashmem]   |show ashmem info when dumping memory of specified pid\n"
         "  --mem [pid] [--show-dmabuf]   |show dmabuf info when dumping memory of specified pid\n"
         #ifdef HIDUMPER_HIVIEWDFX_PLUGIN_ENABLE
@@ -1009,6 +1096,14 @@ void DumpImplement::CmdHelp()
         "  --mem [pid] -t [timeInterval]  |dump process memory change information, press Ctrl+C to stop the export."
         " detail information is stored in /data/log/hidumper/record_mem.txt.\n"
         "  --zip                       |compress output to /data/log/hidumper\n"
+        "  --zip --machine-progress    |report progress as \"progress:N\" lines and the result as \"result:path\"\n"
+        "  --query EXPR                |keep the matching rows of the section tables; EXPR is [select COL,...]"
+        " [where COL OP VALUE [and ...]] [sort COL [desc]] [limit N], OP is one of < <= > >= == != ~ in,"
+        " ~ matches a POSIX extended regex;"
+        " --mem only takes where PID ==/in, Pss >/>= and Name ==/~ predicates, applied while collecting\n"
+        "  --trace                     |write the spans of the dump as a Chrome trace to /data/log/hidumper,"
+        " next to the zip with --zip; one dump traces at a time, the spans of other dumps running meanwhile"
+        " land in its trace, and a --trace dump started meanwhile runs untraced\n"
         "  --mem-smaps pid [-v]        |display statistic in /proc/pid/smaps, use -v specify more details\n"
         "  --mem-jsheap pid [-T tid] [--gc] [--leakobj] [--raw] [--single] [--clean]  |triggerGC, dumpHeapSnapshot,"
         " dumpRawHeap and dumpLeakList under pid and tid\n"
@@ -1026,7 +1121,8 @@ void DumpImplement::CmdHelp()
 #ifdef HIDUMPER_HIVIEWDFX_HIVIEW_ENABLE
     const std::string extendedUsageStr =
         "  --cpuusage [pid]            |dump cpu usage by processes and category; if PID is specified,"
-        " dump category usage of specified pid\n";
+        " dump category usage of specified pid; the usage is averaged over the last second of samples,"
+        " the window is not selectable from the command line\n";
     std::string str = commonUsageStr + extendedUsageStr;
 #else
     std::string str = commonUsageStr;
@@ -1088,6 +1184,8 @@ DumpStatus DumpImplement::DumpDatas(const std::vector<std::shared_ptr<HidumperEx
     std::string groupName = "";
     std::vector<size_t> loopStack;
     const size_t executorSum = executors.size();
+    DumperStagePool stagePool(executors, dumpParameter);
+    stagePool.Start();
     for (size_t index = 0; index < executorSum; index++) {
         callback->UpdateProgress(executors.size(), index);
         if (callback->IsCanceled()) {
@@ -1098,6 +1196,10 @@ DumpStatus DumpImplement::DumpDatas(const std::vector<std::shared_ptr<HidumperEx
         if (dumpCfg->IsDumper() && CheckGroupName(groupName, dumpCfg->section_)) {
             AddGroupTitle(groupName, dumpDatas, dumpParameter);
         }
+        if (stagePool.IsStaged(index)) {
+            stagePool.Commit(index, dumpDatas);
+            continue;
+        }
 
         DumpStatus ret = DumpStatus::DUMP_FAIL;
         ret = executors[index]->DoPreExecute(dumpParameter, dumpDatas);
@@ -1124,6 +1226,7 @@ DumpStatus DumpImplement::DumpDatas(const std::vector<std::shared_ptr<HidumperEx
             loopStack.clear(); // clear now.
         }
     }
+    stagePool.Stop();
     for (auto executor : executors) {
         executor->Reset();
     }
@@ -1534,7 +1637,8 @@ bool DumpImplement::CheckUnableToDumpAll(int argc, DumperOpts& opt)
 {
     bool isZip = opt.IsDumpZip();
     bool noSelect = !opt.IsSelectAny();
-    bool validArgc = (argc == ARG_COUNT_NO_PARAM) || (argc == ARG_COUNT_WITH_ZIP && isZip);
+    int traceArg = opt.isTrace_ ? 1 : 0; // --trace may come with a dump of everything
+    bool validArgc = (argc == (ARG_COUNT_NO_PARAM + traceArg)) || ((argc == (ARG_COUNT_WITH_ZIP + traceArg)) && isZip);
     return noSelect && !validArgc;
 }
 
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "manager/dumper_stage_pool.h"
+#include <algorithm>
+#include <iterator>
+#include "hilog_wrapper.h"
+namespace OHOS {
+namespace HiviewDFX {
+DumperStagePool::DumperStagePool(const std::vector<std::shared_ptr<HidumperExecutor>>& executors,
+    const std::shared_ptr<DumperParameter>& parameter) : executors_(executors), parameter_(parameter)
+{
+}
+
+DumperStagePool::~DumperStagePool()
+{
+    Stop();
+}
+
+bool DumperStagePool::CanStage(int cls)
+{
+    switch (cls) {
+        case DumperConstant::FILE_DUMPER:
+        case DumperConstant::ENV_PARAM_DUMPER:
+        case DumperConstant::CMD_DUMPER:
+        case DumperConstant::PROPERTIES_DUMPER:
+        case DumperConstant::API_DUMPER:
+        case DumperConstant::VERSION_DUMPER:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void DumperStagePool::SelectStageIndexes()
+{
+    stagePos_.assign(executors_.size(), NOT_STAGED);
+    size_t chainStart = 0;
+    for (size_t index = 0; index <= executors_.size(); index++) {
+        bool isEnd = (index == executors_.size());
+        if (!isEnd) {
+            auto dumpCfg = (executors_[index] == nullptr) ? nullptr : executors_[index]->GetDumpConfig();
+            if (dumpCfg != nullptr && !dumpCfg->IsOutput() && !dumpCfg->IsGroup()) {
+                continue;
+            }
+        }
+        // a looping dumper replays its whole chain, so such a chain keeps running in place.
+        bool canLoop = std::any_of(executors_.begin() + chainStart, executors_.begin() + index,
+            [](const std::shared_ptr<HidumperExecutor>& executor) {
+                return executor != nullptr && executor->GetDumpConfig()->IsDumper() &&
+                    executor->GetDumpConfig()->CanLoop();
+            });
+        for (size_t i = chainStart; !canLoop && i < index; i++) {
+            if (executors_[i] != nullptr && CanStage(executors_[i]->GetDumpConfig()->class_)) {
+                stagePos_[i] = stageIndexes_.size();
+                stageIndexes_.push_back(i);
+            }
+        }
+        chainStart = index + 1;
+    }
+}
+
+bool DumperStagePool::Start()
+{
+    SelectStageIndexes();
+    if (stageIndexes_.size() < MIN_STAGE_COUNT) {
+        stageIndexes_.clear();
+        stagePos_.assign(executors_.size(), NOT_STAGED);
+        return false;
+    }
+    slots_.resize(stageIndexes_.size());
+    size_t threadNum = std::min(stageIndexes_.size(), MAX_THREAD_NUM);
+    size_t hardwareThreads = std::thread::hardware_concurrency();
+    if (hardwareThreads > 0) {
+        threadNum = std::min(threadNum, hardwareThreads);
+    }
+    DUMPER_HILOGD(MODULE_COMMON, "debug|stage %{public}zu dumpers on %{public}zu threads",
+        stageIndexes_.size(), threadNum);
+    for (size_t i = 0; i < threadNum; i++) {
+        workers_.emplace_back([this] { Run(); });
+    }
+    return true;
+}
+
+void DumperStagePool::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+    }
+    cond_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+}
+
+bool DumperStagePool::IsStaged(size_t index) const
+{
+    return (index < stagePos_.size()) && (stagePos_[index] != NOT_STAGED);
+}
+
+void DumperStagePool::Commit(size_t index, HidumperExecutor::StringMatrix dumpDatas)
+{
+    if (!IsStaged(index) || dumpDatas == nullptr) {
+        return;
+    }
+    size_t pos = stagePos_[index];
+    HidumperExecutor::StringMatrix staged;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this, pos] { return slots_[pos].done || stopped_; });
+        staged.swap(slots_[pos].dumpDatas);
+        committed_ = std::max(committed_, pos + 1);
+    }
+    cond_.notify_all();
+    if (staged != nullptr) {
+        dumpDatas->insert(dumpDatas->end(), std::make_move_iterator(staged->begin()),
+            std::make_move_iterator(staged->end()));
+    }
+}
+
+void DumperStagePool::Run()
+{
+    while (true) {
+        size_t pos = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this] {
+                return stopped_ || (next_ >= stageIndexes_.size()) || (next_ < committed_ + STAGE_WINDOW);
+            });
+            if (stopped_ || (next_ >= stageIndexes_.size())) {
+                return;
+            }
+            pos = next_++;
+        }
+        auto dumpDatas = std::make_shared<std::vector<std::vector<std::string>>>();
+        if (!IsCanceled()) {
+            RunDumper(executors_[stageIndexes_[pos]], dumpDatas);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            slots_[pos].dumpDatas = dumpDatas;
+            slots_[pos].done = true;
+        }
+        cond_.notify_all();
+    }
+}
+
+void DumperStagePool::RunDumper(const std::shared_ptr<HidumperExecutor>& executor,
+    HidumperExecutor::StringMatrix dumpDatas)
+{
+    executor->SetStaged(true);
+    DumpStatus ret = executor->DoPreExecute(parameter_, dumpDatas);
+    if (ret != DumpStatus::DUMP_OK) {
+        return;
+    }
+    ret = executor->DoExecute();
+    if ((ret != DumpStatus::DUMP_OK) && (ret != DumpStatus::DUMP_MORE_DATA)) {
+        return;
+    }
+    executor->DoAfterExecute();
+}
+
+bool DumperStagePool::IsCanceled() const
+{
+    auto callback = (parameter_ == nullptr) ? nullptr : parameter_->getClientCallback();
+    return (callback != nullptr) && callback->IsCanceled();
+}
+} // namespace HiviewDFX
+} // namespace OHOS
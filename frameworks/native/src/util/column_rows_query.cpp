@@ -0,0 +1,718 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/column_rows_query.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+using namespace std;
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+const string BLANKS = " \t";
+const string PUNCTUATIONS = ",()";
+const string OPERATOR_CHARS = "<>=!~";
+const string QUOTES = "'\"";
+const string SELECT_ALL = "*";
+const string PID_COLUMN = "PID";
+const string PSS_COLUMN = "Pss";
+const string NAME_COLUMN = "Name";
+
+string ToLower(const string &str)
+{
+    string lower = str;
+    transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return tolower(c); });
+    return lower;
+}
+
+bool IsName(const string &token)
+{
+    return !token.empty() && (PUNCTUATIONS.find(token[0]) == string::npos) &&
+        (OPERATOR_CHARS.find(token[0]) == string::npos);
+}
+
+bool ToOp(const string &token, ColumnRowsQuery::Op &op)
+{
+    static const vector<pair<string, ColumnRowsQuery::Op>> OPS = {
+        {"<", ColumnRowsQuery::Op::LESS}, {"<=", ColumnRowsQuery::Op::LESS_EQUAL},
+        {">", ColumnRowsQuery::Op::GREATER}, {">=", ColumnRowsQuery::Op::GREATER_EQUAL},
+        {"=", ColumnRowsQuery::Op::EQUAL}, {"==", ColumnRowsQuery::Op::EQUAL},
+        {"!=", ColumnRowsQuery::Op::NOT_EQUAL}, {"~", ColumnRowsQuery::Op::MATCH},
+        {"in", ColumnRowsQuery::Op::IN},
+    };
+    string lower = ToLower(token);
+    for (const auto &item : OPS) {
+        if (item.first == lower) {
+            op = item.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool IsNumericOp(ColumnRowsQuery::Op op)
+{
+    return (op == ColumnRowsQuery::Op::LESS) || (op == ColumnRowsQuery::Op::LESS_EQUAL) ||
+        (op == ColumnRowsQuery::Op::GREATER) || (op == ColumnRowsQuery::Op::GREATER_EQUAL);
+}
+
+bool ToPid(const string &str, int32_t &pid)
+{
+    char *end = nullptr;
+    errno = 0;
+    long value = strtol(str.c_str(), &end, 10); // 10: decimal
+    if (str.empty() || (*end != '\0') || (errno != 0) || (value < 0) || (value > numeric_limits<int32_t>::max())) {
+        return false;
+    }
+    pid = static_cast<int32_t>(value);
+    return true;
+}
+} // namespace
+
+bool ColumnRowsQuery::ProcessFilter::IsEmpty() const
+{
+    return pids.empty() && (minPss == 0) && !HasName();
+}
+
+bool ColumnRowsQuery::ProcessFilter::HasName() const
+{
+    return !name.empty() || !nameRegexes.empty();
+}
+
+ColumnRowsQuery::Regex::~Regex()
+{
+    if (compiled_) {
+        regfree(&regex_);
+    }
+}
+
+bool ColumnRowsQuery::Regex::Compile(const string &pattern)
+{
+    if (compiled_) {
+        regfree(&regex_);
+    }
+    compiled_ = (regcomp(&regex_, pattern.c_str(), REG_EXTENDED | REG_NOSUB) == 0);
+    return compiled_;
+}
+
+bool ColumnRowsQuery::Regex::Search(const string &str) const
+{
+    return compiled_ && (regexec(&regex_, str.c_str(), 0, nullptr, 0) == 0);
+}
+
+bool ColumnRowsQuery::ProcessFilter::MatchPid(int32_t pid) const
+{
+    return pids.empty() || (pids.find(pid) != pids.end());
+}
+
+bool ColumnRowsQuery::ProcessFilter::MatchName(const string &processName) const
+{
+    if (!name.empty() && (name != processName)) {
+        return false;
+    }
+    return all_of(nameRegexes.begin(), nameRegexes.end(),
+        [&processName](const shared_ptr<Regex> &nameRegex) { return nameRegex->Search(processName); });
+}
+
+bool ColumnRowsQuery::Parse(const string &expr, string &errStr)
+{
+    *this = ColumnRowsQuery();
+    expr_ = expr;
+    set<string> clauses;
+    string token;
+    while (NextToken(token)) {
+        string clause = ToLower(token);
+        if (clauses.find(clause) != clauses.end()) {
+            errStr = "duplicated " + clause + " in query";
+            return false;
+        }
+        bool ret = false;
+        if (clause == "select") {
+            ret = ParseSelect(errStr);
+        } else if (clause == "where") {
+            ret = ParsePredicate(errStr);
+            while (ret && PeekToken(token) && (ToLower(token) == "and")) {
+                NextToken(token);
+                ret = ParsePredicate(errStr);
+            }
+        } else if (clause == "sort") {
+            ret = ParseSort(errStr);
+        } else if (clause == "limit") {
+            ret = ParseLimit(errStr);
+        } else {
+            errStr = "unknown clause " + token + " in query";
+        }
+        if (!ret) {
+            return false;
+        }
+        clauses.insert(clause);
+    }
+    if (GetReferencedColumns().empty()) {
+        // the header of a table is found by the columns, a query without them matches no table.
+        errStr = "query names no column: " + expr;
+        return false;
+    }
+    return true;
+}
+
+bool ColumnRowsQuery::IsEmpty() const
+{
+    return GetReferencedColumns().empty();
+}
+
+bool ColumnRowsQuery::IsProcessFilterOnly() const
+{
+    return columns_.empty() && sortColumn_.empty() && (limit_ == 0) &&
+        all_of(predicates_.begin(), predicates_.end(), IsPushedDown);
+}
+
+bool ColumnRowsQuery::IsPushedDown(const Predicate &predicate)
+{
+    if (IsSameColumn(predicate.column, PID_COLUMN)) {
+        return (predicate.op == Op::EQUAL) || (predicate.op == Op::IN);
+    }
+    if (IsSameColumn(predicate.column, PSS_COLUMN)) {
+        return (predicate.op == Op::GREATER) || (predicate.op == Op::GREATER_EQUAL);
+    }
+    if (IsSameColumn(predicate.column, NAME_COLUMN)) {
+        return (predicate.op == Op::EQUAL) || (predicate.op == Op::MATCH);
+    }
+    return false;
+}
+
+ColumnRowsQuery::ProcessFilter ColumnRowsQuery::GetProcessFilter() const
+{
+    ProcessFilter filter;
+    bool hasPids = false;
+    for (const auto &predicate : predicates_) {
+        if (IsSameColumn(predicate.column, PID_COLUMN) &&
+            ((predicate.op == Op::EQUAL) || (predicate.op == Op::IN))) {
+            set<int32_t> pids;
+            int32_t pid = 0;
+            for (const auto &value : predicate.values) {
+                if (ToPid(value, pid)) {
+                    pids.insert(pid);
+                }
+            }
+            if (hasPids) {
+                set<int32_t> both;
+                set_intersection(filter.pids.begin(), filter.pids.end(), pids.begin(), pids.end(),
+                    inserter(both, both.begin()));
+                pids.swap(both);
+            }
+            filter.pids.swap(pids);
+            hasPids = true;
+        } else if (IsSameColumn(predicate.column, PSS_COLUMN) &&
+            ((predicate.op == Op::GREATER) || (predicate.op == Op::GREATER_EQUAL))) {
+            double pss = 0;
+            ToNumber(predicate.values[0], pss, true);
+            double minPss = (predicate.op == Op::GREATER) ? (floor(pss) + 1) : ceil(pss);
+            if (minPss > 0) {
+                filter.minPss = max(filter.minPss, static_cast<uint64_t>(minPss));
+            }
+        } else if (IsSameColumn(predicate.column, NAME_COLUMN) && (predicate.op == Op::EQUAL)) {
+            if (!filter.name.empty() && (filter.name != predicate.values[0])) {
+                hasPids = true;
+                filter.pids.clear();
+            }
+            filter.name = predicate.values[0];
+        } else if (IsSameColumn(predicate.column, NAME_COLUMN) && (predicate.op == Op::MATCH)) {
+            filter.nameRegexes.push_back(predicate.regex);
+        }
+    }
+    if (hasPids && filter.pids.empty()) {
+        filter.pids.insert(ProcessFilter::NO_PID);
+    }
+    return filter;
+}
+
+size_t ColumnRowsQuery::Apply(vector<vector<string>> &datas) const
+{
+    if (IsEmpty()) {
+        return 0;
+    }
+    vector<vector<string>> result;
+    result.reserve(datas.size());
+    size_t tables = 0;
+    size_t index = 0;
+    while (index < datas.size()) {
+        bool guessed = false;
+        vector<string> header = SplitRow(datas[index], {}, 0, guessed);
+        if (!IsHeader(header)) {
+            result.push_back(move(datas[index]));
+            index++;
+            continue;
+        }
+        vector<size_t> offsets = GetColumnOffsets(datas[index]);
+        vector<Row> table;
+        table.push_back({index, header});
+        for (index++; index < datas.size(); index++) {
+            vector<string> cells = SplitRow(datas[index], offsets, header.size(), guessed);
+            if (cells.size() < header.size()) {
+                break;
+            }
+            table.push_back({index, move(cells), guessed});
+        }
+        ApplyTable(datas, table, result);
+        tables++;
+    }
+    datas.swap(result);
+    return tables;
+}
+
+bool ColumnRowsQuery::ParseSelect(string &errStr)
+{
+    string token;
+    do {
+        if (!NextToken(token) || !IsName(token)) {
+            errStr = "expected a column after select in query";
+            return false;
+        }
+        if (token != SELECT_ALL) {
+            columns_.push_back(token);
+        }
+    } while (ExpectToken(","));
+    return true;
+}
+
+bool ColumnRowsQuery::ParsePredicate(string &errStr)
+{
+    Predicate predicate;
+    string token;
+    if (!NextToken(predicate.column) || !IsName(predicate.column)) {
+        errStr = "expected a column in where of query";
+        return false;
+    }
+    if (!NextToken(token) || !ToOp(token, predicate.op)) {
+        errStr = "expected an operator after " + predicate.column + " in query";
+        return false;
+    }
+    if (predicate.op == Op::IN) {
+        bool parenthesized = ExpectToken("(");
+        do {
+            if (!NextToken(token) || !IsName(token)) {
+                errStr = "expected a value list after " + predicate.column + " in in query";
+                return false;
+            }
+            predicate.values.push_back(token);
+        } while (ExpectToken(","));
+        if (parenthesized && !ExpectToken(")")) {
+            errStr = "expected ) after the values of " + predicate.column + " in query";
+            return false;
+        }
+    } else {
+        // a pattern is taken up to the next blank, so it needs no quotes for its own operators.
+        if (!NextToken(token, predicate.op == Op::MATCH)) {
+            errStr = "expected a value after " + predicate.column + " in query";
+            return false;
+        }
+        predicate.values.push_back(token);
+    }
+    double number = 0;
+    if (IsNumericOp(predicate.op) && !ToNumber(predicate.values[0], number, true)) {
+        errStr = predicate.values[0] + " is not a number in query";
+        return false;
+    }
+    if (predicate.op == Op::MATCH) {
+        predicate.regex = make_shared<Regex>();
+        if (!predicate.regex->Compile(predicate.values[0])) {
+            errStr = predicate.values[0] + " is not a regular expression in query";
+            return false;
+        }
+    }
+    predicates_.push_back(move(predicate));
+    return true;
+}
+
+bool ColumnRowsQuery::ParseSort(string &errStr)
+{
+    string token;
+    if (PeekToken(token) && (ToLower(token) == "by")) {
+        NextToken(token);
+    }
+    if (!NextToken(sortColumn_) || !IsName(sortColumn_)) {
+        errStr = "expected a column after sort in query";
+        return false;
+    }
+    if (PeekToken(token) && ((ToLower(token) == "asc") || (ToLower(token) == "desc"))) {
+        sortDesc_ = (ToLower(token) == "desc");
+        NextToken(token);
+    }
+    return true;
+}
+
+bool ColumnRowsQuery::ParseLimit(string &errStr)
+{
+    string token;
+    double number = 0;
+    if (!NextToken(token) || !ToNumber(token, number, true) || (number < 1) || (number != floor(number)) ||
+        (number > static_cast<double>(numeric_limits<int32_t>::max()))) {
+        errStr = "expected a positive count after limit in query";
+        return false;
+    }
+    limit_ = static_cast<size_t>(number);
+    return true;
+}
+
+bool ColumnRowsQuery::NextToken(string &token, bool raw)
+{
+    size_t start = expr_.find_first_not_of(BLANKS, pos_);
+    if (start == string::npos) {
+        pos_ = expr_.size();
+        return false;
+    }
+    size_t end = start + 1;
+    char c = expr_[start];
+    if (QUOTES.find(c) != string::npos) {
+        end = expr_.find(c, start + 1);
+        if (end == string::npos) {
+            end = expr_.size();
+        }
+        token = expr_.substr(start + 1, end - start - 1);
+        pos_ = min(end + 1, expr_.size());
+        return true;
+    }
+    if (raw) {
+        end = expr_.find_first_of(BLANKS, start);
+    } else if (OPERATOR_CHARS.find(c) != string::npos) {
+        end = ((end < expr_.size()) && (expr_[end] == '=')) ? (end + 1) : end;
+    } else if (PUNCTUATIONS.find(c) == string::npos) {
+        end = expr_.find_first_of(BLANKS + PUNCTUATIONS + OPERATOR_CHARS + QUOTES, start);
+    }
+    end = (end == string::npos) ? expr_.size() : end;
+    token = expr_.substr(start, end - start);
+    pos_ = end;
+    return true;
+}
+
+bool ColumnRowsQuery::PeekToken(string &token)
+{
+    size_t pos = pos_;
+    bool ret = NextToken(token);
+    pos_ = pos;
+    return ret;
+}
+
+bool ColumnRowsQuery::ExpectToken(const string &token)
+{
+    string next;
+    if (PeekToken(next) && (next == token)) {
+        NextToken(next);
+        return true;
+    }
+    return false;
+}
+
+vector<string> ColumnRowsQuery::GetReferencedColumns() const
+{
+    vector<string> columns = columns_;
+    for (const auto &predicate : predicates_) {
+        columns.push_back(predicate.column);
+    }
+    if (!sortColumn_.empty()) {
+        columns.push_back(sortColumn_);
+    }
+    return columns;
+}
+
+bool ColumnRowsQuery::IsHeader(const vector<string> &cells) const
+{
+    if (cells.empty()) {
+        return false;
+    }
+    vector<string> columns = GetReferencedColumns();
+    return all_of(columns.begin(), columns.end(),
+        [&cells](const string &column) { return IndexOf(cells, column) < cells.size(); });
+}
+
+bool ColumnRowsQuery::MatchRow(const vector<string> &cells, const vector<size_t> &indexes) const
+{
+    for (size_t i = 0; i < predicates_.size(); i++) {
+        if (!MatchCell(cells[indexes[i]], predicates_[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ColumnRowsQuery::IsComparable(const vector<string> &cells, const vector<size_t> &indexes) const
+{
+    double number = 0;
+    for (size_t i = 0; i < predicates_.size(); i++) {
+        Op op = predicates_[i].op;
+        bool numeric = (op == Op::LESS) || (op == Op::LESS_EQUAL) || (op == Op::GREATER) || (op == Op::GREATER_EQUAL);
+        if (numeric && !ToNumber(cells[indexes[i]], number, false)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ColumnRowsQuery::ApplyTable(const vector<vector<string>> &datas, const vector<Row> &table,
+    vector<vector<string>> &result) const
+{
+    const vector<string> &header = table.front().cells;
+    vector<size_t> indexes;
+    for (const auto &predicate : predicates_) {
+        indexes.push_back(IndexOf(header, predicate.column));
+    }
+    vector<const Row *> rows;
+    vector<const Row *> guessedRows;
+    for (size_t i = 1; i < table.size(); i++) {
+        // a guess that puts words in a numeric column was wrong, the row is not dropped for it.
+        if (table[i].guessed && !IsComparable(table[i].cells, indexes)) {
+            guessedRows.push_back(&table[i]);
+        } else if (MatchRow(table[i].cells, indexes)) {
+            rows.push_back(&table[i]);
+        }
+    }
+    if (!sortColumn_.empty()) {
+        size_t sortIndex = IndexOf(header, sortColumn_);
+        bool desc = sortDesc_;
+        stable_sort(rows.begin(), rows.end(), [sortIndex, desc](const Row *first, const Row *second) {
+            int ret = CompareCells(first->cells[sortIndex], second->cells[sortIndex]);
+            return desc ? (ret > 0) : (ret < 0);
+        });
+    }
+    if ((limit_ > 0) && (rows.size() > limit_)) {
+        rows.resize(limit_);
+    }
+    rows.insert(rows.begin(), &table.front());
+    if (columns_.empty()) {
+        for (const Row *row : rows) {
+            result.push_back(datas[row->index]);
+        }
+    } else {
+        ProjectRows(datas, header, rows, result);
+    }
+    // the query can not tell what the cells of these rows are, so it leaves them to the reader.
+    for (const Row *row : guessedRows) {
+        result.push_back(datas[row->index]);
+    }
+}
+
+void ColumnRowsQuery::ProjectRows(const vector<vector<string>> &datas, const vector<string> &header,
+    const vector<const Row *> &rows, vector<vector<string>> &result) const
+{
+    vector<size_t> selected;
+    vector<size_t> widths;
+    for (const auto &column : columns_) {
+        size_t index = IndexOf(header, column);
+        size_t width = 0;
+        for (const Row *row : rows) {
+            width = max(width, row->cells[index].size());
+        }
+        selected.push_back(index);
+        widths.push_back(width);
+    }
+    for (const Row *row : rows) {
+        result.push_back(ProjectRow(datas[row->index], row->cells, selected, widths));
+    }
+}
+
+vector<string> ColumnRowsQuery::ProjectRow(const vector<string> &row, const vector<string> &cells,
+    const vector<size_t> &selected, const vector<size_t> &widths) const
+{
+    vector<string> projected;
+    if (row.size() > 1) {
+        // the cells keep their own padding.
+        for (size_t index : selected) {
+            projected.push_back(row[index]);
+        }
+        return projected;
+    }
+    string line;
+    for (size_t i = 0; i < selected.size(); i++) {
+        const string &cell = cells[selected[i]];
+        line += cell;
+        if (i + 1 < selected.size()) {
+            line.append(widths[i] - cell.size() + 2, ' '); // 2: blanks between the columns
+        }
+    }
+    projected.push_back(line);
+    return projected;
+}
+
+size_t ColumnRowsQuery::IndexOf(const vector<string> &header, const string &column)
+{
+    for (size_t i = 0; i < header.size(); i++) {
+        if (IsSameColumn(header[i], column)) {
+            return i;
+        }
+    }
+    return header.size();
+}
+
+vector<size_t> ColumnRowsQuery::GetColumnOffsets(const vector<string> &header)
+{
+    vector<size_t> offsets;
+    if (header.size() == 1) {
+        for (const auto &field : SplitFields(header.front(), 1)) {
+            offsets.push_back(field.first);
+        }
+    }
+    return offsets;
+}
+
+vector<string> ColumnRowsQuery::SplitRow(const vector<string> &row, const vector<size_t> &offsets,
+    size_t columnCount, bool &guessed)
+{
+    guessed = false;
+    vector<string> cells;
+    if (row.size() > 1) {
+        for (const auto &cell : row) {
+            cells.push_back(Trim(cell));
+        }
+        return cells;
+    }
+    if (row.empty()) {
+        return cells;
+    }
+    const string &line = row.front();
+    vector<pair<size_t, size_t>> fields = SplitFields(line, 1);
+    if ((columnCount > 0) && (fields.size() > columnCount)) {
+        // a cell with blanks, such as a name or a command line, is usually set apart by wider gaps.
+        vector<pair<size_t, size_t>> wideFields = SplitFields(line, 2); // 2: blanks between the columns
+        if (wideFields.size() == columnCount) {
+            fields.swap(wideFields);
+        }
+    }
+    if ((columnCount == 0) || (fields.size() <= columnCount)) {
+        for (const auto &field : fields) {
+            cells.push_back(line.substr(field.first, field.second - field.first));
+        }
+        return cells;
+    }
+    // a column takes the next field too while the field ends before the next column of the header starts,
+    // without the offsets the last column, such as a command line, takes the rest of the row.
+    guessed = true;
+    vector<pair<size_t, size_t>> columns(columnCount, {string::npos, 0});
+    size_t column = 0;
+    for (const auto &field : fields) {
+        bool underColumn = (column + 1 < offsets.size()) && (field.second < offsets[column + 1]);
+        if ((columns[column].first != string::npos) && (column + 1 < columnCount) && !underColumn) {
+            column++;
+        }
+        columns[column].first = min(columns[column].first, field.first);
+        columns[column].second = field.second;
+    }
+    for (const auto &cell : columns) {
+        cells.push_back(line.substr(cell.first, cell.second - cell.first));
+    }
+    return cells;
+}
+
+vector<pair<size_t, size_t>> ColumnRowsQuery::SplitFields(const string &line, size_t minGap)
+{
+    const string blanks = BLANKS + "\r\n";
+    vector<pair<size_t, size_t>> fields;
+    size_t start = line.find_first_not_of(blanks);
+    while (start != string::npos) {
+        size_t end = line.find_first_of(blanks, start);
+        size_t next = (end == string::npos) ? end : line.find_first_not_of(blanks, end);
+        while ((next != string::npos) && (next - end < minGap)) {
+            end = line.find_first_of(blanks, next);
+            next = (end == string::npos) ? end : line.find_first_not_of(blanks, end);
+        }
+        fields.emplace_back(start, (end == string::npos) ? line.size() : end);
+        start = next;
+    }
+    return fields;
+}
+
+bool ColumnRowsQuery::MatchCell(const string &cell, const Predicate &predicate)
+{
+    switch (predicate.op) {
+        case Op::MATCH:
+            return predicate.regex->Search(cell);
+        case Op::EQUAL:
+        case Op::IN:
+            return any_of(predicate.values.begin(), predicate.values.end(),
+                [&cell](const string &value) { return IsSameCell(cell, value); });
+        case Op::NOT_EQUAL:
+            return !IsSameCell(cell, predicate.values[0]);
+        default:
+            break;
+    }
+    double number = 0;
+    double value = 0;
+    if (!ToNumber(cell, number, false) || !ToNumber(predicate.values[0], value, true)) {
+        return false;
+    }
+    switch (predicate.op) {
+        case Op::LESS:
+            return number < value;
+        case Op::LESS_EQUAL:
+            return number <= value;
+        case Op::GREATER:
+            return number > value;
+        default:
+            return number >= value;
+    }
+}
+
+bool ColumnRowsQuery::IsSameCell(const string &cell, const string &value)
+{
+    double number = 0;
+    double cellNumber = 0;
+    if (ToNumber(value, number, true) && ToNumber(cell, cellNumber, false)) {
+        return number == cellNumber;
+    }
+    return cell == value;
+}
+
+int ColumnRowsQuery::CompareCells(const string &first, const string &second)
+{
+    double firstNumber = 0;
+    double secondNumber = 0;
+    if (ToNumber(first, firstNumber, false) && ToNumber(second, secondNumber, false)) {
+        return (firstNumber < secondNumber) ? -1 : ((firstNumber > secondNumber) ? 1 : 0);
+    }
+    return first.compare(second);
+}
+
+bool ColumnRowsQuery::ToNumber(const string &str, double &number, bool whole)
+{
+    // a cell such as "1024(12 in SwapPss) kB" or "3.5%" reads as its leading number.
+    if (str.empty() || !(isdigit(static_cast<unsigned char>(str[0])) || (str[0] == '-') || (str[0] == '+') ||
+        (str[0] == '.'))) {
+        return false;
+    }
+    char *end = nullptr;
+    number = strtod(str.c_str(), &end);
+    if (end == str.c_str()) {
+        return false;
+    }
+    return !whole || (*end == '\0');
+}
+
+bool ColumnRowsQuery::IsSameColumn(const string &first, const string &second)
+{
+    return (first.size() == second.size()) && (ToLower(first) == ToLower(second));
+}
+
+string ColumnRowsQuery::Trim(const string &str)
+{
+    size_t start = str.find_first_not_of(BLANKS + "\r\n");
+    if (start == string::npos) {
+        return "";
+    }
+    size_t end = str.find_last_not_of(BLANKS + "\r\n");
+    return str.substr(start, end - start + 1);
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/command_runner.h"
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <glob.h>
+#include <poll.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "hilog_wrapper.h"
+
+extern char **environ;
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr size_t READ_BUFFER_SIZE = 64 * 1024;
+const std::string SHELL_OPERATORS = "|;&<>`$";
+
+int64_t GetNowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ExpandToken(const std::string& token, bool needGlob, std::vector<std::string>& args)
+{
+    if (!needGlob) {
+        args.push_back(token);
+        return;
+    }
+    glob_t globResult = {};
+    if (glob(token.c_str(), GLOB_NOCHECK, nullptr, &globResult) == 0) {
+        for (size_t i = 0; i < globResult.gl_pathc; i++) {
+            args.emplace_back(globResult.gl_pathv[i]);
+        }
+    } else {
+        args.push_back(token);
+    }
+    globfree(&globResult);
+}
+} // namespace
+
+CommandRunner::CommandRunner(const std::string& cmd, int timeoutMs) : cmd_(cmd), timeoutMs_(timeoutMs)
+{
+}
+
+CommandRunner::~CommandRunner()
+{
+    if (pid_ > 0 && !eof_) {
+        Kill();
+    }
+    Release();
+    Wait();
+}
+
+bool CommandRunner::ParseCommand(const std::string& cmd, std::vector<std::string>& args)
+{
+    std::string token;
+    bool inToken = false;
+    bool needGlob = false;
+    char quote = '\0';
+    for (size_t i = 0; i < cmd.size(); i++) {
+        char c = cmd[i];
+        if (quote != '\0') {
+            if (c == quote) {
+                quote = '\0';
+            } else {
+                token += c;
+            }
+            continue;
+        }
+        if (c == '\'' || c == '"') {
+            quote = c;
+            inToken = true;
+        } else if (c == '\\' && (i + 1) < cmd.size()) {
+            token += cmd[++i];
+            inToken = true;
+        } else if (isspace(static_cast<unsigned char>(c))) {
+            if (inToken) {
+                ExpandToken(token, needGlob, args);
+            }
+            token.clear();
+            inToken = false;
+            needGlob = false;
+        } else if (SHELL_OPERATORS.find(c) != std::string::npos) {
+            DUMPER_HILOGE(MODULE_COMMON, "shell operator is not supported, cmd=%{public}s", cmd.c_str());
+            return false;
+        } else {
+            needGlob = needGlob || (c == '*') || (c == '?') || (c == '[');
+            token += c;
+            inToken = true;
+        }
+    }
+    if (quote != '\0') {
+        DUMPER_HILOGE(MODULE_COMMON, "unterminated quote, cmd=%{public}s", cmd.c_str());
+        return false;
+    }
+    if (inToken) {
+        ExpandToken(token, needGlob, args);
+    }
+    return !args.empty();
+}
+
+bool CommandRunner::Start()
+{
+    std::vector<std::string> args;
+    if (pid_ > 0 || !ParseCommand(cmd_, args)) {
+        return false;
+    }
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+    int pipeFds[2] = {-1, -1};
+    if (pipe2(pipeFds, O_CLOEXEC) != 0) {
+        DUMPER_HILOGE(MODULE_COMMON, "pipe2 failed, errno=%{public}d", errno);
+        return false;
+    }
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_adddup2(&actions, pipeFds[1], STDOUT_FILENO);
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    sigset_t defaultSignals;
+    sigemptyset(&defaultSignals);
+    sigaddset(&defaultSignals, SIGPIPE);
+    posix_spawnattr_setsigdefault(&attr, &defaultSignals);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGDEF);
+
+    int ret = posix_spawnp(&pid_, argv[0], &actions, &attr, argv.data(), environ);
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+    close(pipeFds[1]);
+    if (ret != 0) {
+        DUMPER_HILOGE(MODULE_COMMON, "spawn failed, ret=%{public}d, cmd=%{public}s", ret, cmd_.c_str());
+        close(pipeFds[0]);
+        pid_ = -1;
+        return false;
+    }
+    readFd_ = pipeFds[0];
+    eof_ = false;
+    buffer_.resize(READ_BUFFER_SIZE);
+    return true;
+}
+
+DumpStatus CommandRunner::ReadLines(const LineHandler& func, bool keepNewLine)
+{
+    if (readFd_ < 0) {
+        return eof_ ? DumpStatus::DUMP_OK : DumpStatus::DUMP_FAIL;
+    }
+    // an idle timeout, the time the caller spends on the lines between two reads does not count.
+    deadline_ = (timeoutMs_ < 0) ? 0 : (GetNowMs() + timeoutMs_);
+    struct pollfd pollFd = {readFd_, POLLIN, 0};
+    int ret = -1;
+    do {
+        ret = poll(&pollFd, 1, GetRemainTime());
+    } while (ret < 0 && errno == EINTR);
+    if (ret == 0) {
+        DUMPER_HILOGE(MODULE_COMMON, "cmd timeout, cmd=%{public}s", cmd_.c_str());
+        Kill();
+        return DumpStatus::DUMP_TIMEOUT;
+    }
+    if (ret < 0) {
+        DUMPER_HILOGE(MODULE_COMMON, "poll failed, errno=%{public}d", errno);
+        Kill();
+        return DumpStatus::DUMP_FAIL;
+    }
+    ssize_t readLen = TEMP_FAILURE_RETRY(read(readFd_, buffer_.data(), buffer_.size()));
+    if (readLen < 0) {
+        DUMPER_HILOGE(MODULE_COMMON, "read failed, errno=%{public}d", errno);
+        Kill();
+        return DumpStatus::DUMP_FAIL;
+    }
+    if (readLen == 0) {
+        eof_ = true;
+        Release();
+        if (!pending_.empty()) {
+            std::string lastLine;
+            lastLine.swap(pending_);
+            func(lastLine);
+        }
+        return DumpStatus::DUMP_OK;
+    }
+    if (!DispatchLines(buffer_.data(), static_cast<size_t>(readLen), func, keepNewLine)) {
+        Kill();
+        return DumpStatus::DUMP_OK;
+    }
+    return DumpStatus::DUMP_MORE_DATA;
+}
+
+DumpStatus CommandRunner::ReadAll(const LineHandler& func, bool keepNewLine, const CancelChecker& isCanceled)
+{
+    DumpStatus ret = DumpStatus::DUMP_MORE_DATA;
+    while (ret == DumpStatus::DUMP_MORE_DATA) {
+        if (isCanceled != nullptr && isCanceled()) {
+            Kill();
+            return DumpStatus::DUMP_OK;
+        }
+        ret = ReadLines(func, keepNewLine);
+    }
+    return ret;
+}
+
+bool CommandRunner::DispatchLines(const char* data, size_t size, const LineHandler& func, bool keepNewLine)
+{
+    size_t start = 0;
+    while (start < size) {
+        const char* newLine = static_cast<const char*>(memchr(data + start, '\n', size - start));
+        if (newLine == nullptr) {
+            pending_.append(data + start, size - start);
+            break;
+        }
+        size_t lineEnd = static_cast<size_t>(newLine - data);
+        size_t len = lineEnd - start + (keepNewLine ? 1 : 0);
+        bool goOn = true;
+        if (pending_.empty()) {
+            goOn = func(std::string(data + start, len));
+        } else {
+            pending_.append(data + start, len);
+            goOn = func(pending_);
+            pending_.clear();
+        }
+        start = lineEnd + 1;
+        if (!goOn) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CommandRunner::Kill()
+{
+    if (pid_ > 0 && kill(pid_, SIGKILL) != 0) {
+        DUMPER_HILOGD(MODULE_COMMON, "kill failed, errno=%{public}d", errno);
+    }
+    Release();
+}
+
+int CommandRunner::Wait()
+{
+    if (pid_ <= 0) {
+        return -1;
+    }
+    int status = 0;
+    pid_t ret = TEMP_FAILURE_RETRY(waitpid(pid_, &status, 0));
+    pid_ = -1;
+    if (ret < 0 || !WIFEXITED(status)) {
+        return -1;
+    }
+    return WEXITSTATUS(status);
+}
+
+bool CommandRunner::Run(const std::string& cmd, const LineHandler& func, bool keepNewLine, int timeoutMs)
+{
+    CommandRunner runner(cmd, timeoutMs);
+    if (!runner.Start()) {
+        return false;
+    }
+    DumpStatus ret = runner.ReadAll(func, keepNewLine);
+    runner.Wait();
+    return ret == DumpStatus::DUMP_OK;
+}
+
+int CommandRunner::GetRemainTime() const
+{
+    if (timeoutMs_ < 0) {
+        return NO_TIMEOUT;
+    }
+    int64_t remain = deadline_ - GetNowMs();
+    return (remain > 0) ? static_cast<int>(remain) : 0;
+}
+
+void CommandRunner::Release()
+{
+    if (readFd_ >= 0) {
+        close(readFd_);
+        readFd_ = -1;
+    }
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -13,10 +13,19 @@
  * limitations under the License.
  */
 #include "util/config_data.h"
+#include <unordered_map>
 #include <pubdef.h>
 #include "common/dumper_constant.h"
 namespace OHOS {
 namespace HiviewDFX {
+namespace {
+int FindIndex(const std::unordered_map<std::string, int> &index, const std::string &name)
+{
+    auto it = index.find(name);
+    return (it == index.end()) ? -1 : it->second;
+}
+} // namespace
+
 const std::string ConfigData::CONFIG_NAME_SPLIT = "_";
 const std::string ConfigData::CONFIG_GROUP = "group";
 const std::string ConfigData::CONFIG_GROUP_ = ConfigData::CONFIG_GROUP + ConfigData::CONFIG_NAME_SPLIT;
@@ -1436,6 +1445,65 @@ ConfigData::ConfigData()
 {
 }
 
+struct ConfigData::ConfigIndex {
+    std::unordered_map<std::string, int> dumpers;
+    std::unordered_map<std::string, int> groups;
+    std::vector<std::vector<GroupMember>> groupMembers;
+};
+
+const ConfigData::ConfigIndex &ConfigData::GetConfigIndex()
+{
+    static const ConfigIndex index = [] {
+        ConfigIndex result;
+        for (int i = 0; i < dumperSum_; i++) {
+            if (!dumpers_[i].name_.empty()) {
+                result.dumpers.emplace(dumpers_[i].name_, i); // keep the first one, as a linear scan would
+            }
+        }
+        for (int i = 0; i < groupSum_; i++) {
+            if (!groups_[i].name_.empty()) {
+                result.groups.emplace(groups_[i].name_, i);
+            }
+        }
+        result.groupMembers.resize(groupSum_);
+        for (int i = 0; i < groupSum_; i++) {
+            auto &members = result.groupMembers[i];
+            for (int j = 0; (groups_[i].list_ != nullptr) && (j < groups_[i].size_); j++) {
+                const std::string &name = groups_[i].list_[j];
+                if (name.empty()) {
+                    continue;
+                }
+                if (name.compare(0, CONFIG_DUMPER_.length(), CONFIG_DUMPER_) == 0) {
+                    members.push_back({MemberType::DUMPER, FindIndex(result.dumpers, name)});
+                } else if (name.compare(0, CONFIG_MINIGROUP_.length(), CONFIG_MINIGROUP_) == 0) {
+                    members.push_back({MemberType::MINIGROUP, FindIndex(result.groups, name)});
+                } else {
+                    members.push_back({MemberType::INVALID, -1});
+                }
+            }
+        }
+        return result;
+    }();
+    return index;
+}
+
+int ConfigData::FindDumperIndex(const std::string &name)
+{
+    return FindIndex(GetConfigIndex().dumpers, name);
+}
+
+int ConfigData::FindGroupIndex(const std::string &name)
+{
+    return FindIndex(GetConfigIndex().groups, name);
+}
+
+const std::vector<ConfigData::GroupMember> &ConfigData::GetGroupMembers(int index)
+{
+    static const std::vector<GroupMember> empty;
+    const auto &groupMembers = GetConfigIndex().groupMembers;
+    return ((index < 0) || (static_cast<size_t>(index) >= groupMembers.size())) ? empty : groupMembers[index];
+}
+
 ConfigData::~ConfigData()
 {
 }
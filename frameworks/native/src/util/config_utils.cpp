@@ -13,12 +13,18 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <thread>
+#include <unistd.h>
 #include "util/config_utils.h"
 #include "directory_ex.h"
 #include "file_ex.h"
 #include "hilog_wrapper.h"
 #include "dump_common_utils.h"
 #include "dump_utils.h"
+#include "util/file_utils.h"
 #include "parameter.h"
 #include "common/dumper_constant.h"
 #include "parameters.h"
@@ -31,6 +37,7 @@ constexpr int APP_FIRST_UID = 10000;
 static const std::string SMAPS_PATH = "smaps/";
 static const std::string SMAPS_PATH_START = "/proc/";
 static const std::string SMAPS_PATH_END = "/smaps";
+constexpr size_t SMAPS_THREAD_MAX = 4;
 } // namespace
 
 ConfigUtils::ConfigUtils(const std::shared_ptr<DumperParameter> &param) : dumperParam_(param)
@@ -96,6 +103,7 @@ DumpStatus ConfigUtils::GetDumperConfigs()
     HandleDumpFaultLog(dumpCfgs);
     HandleDumpAppendix(dumpCfgs);
     HandleDumpIpcStat(dumpCfgs);
+    HandleQueryFilter(dumpCfgs);
     DUMPER_HILOGD(MODULE_COMMON, "debug|dumpCfgs=%{public}zu", dumpCfgs.size());
     dumperParam_->SetExecutorConfigList(dumpCfgs);
     DUMPER_HILOGD(MODULE_COMMON, "leave|");
@@ -706,29 +714,20 @@ DumpStatus ConfigUtils::GetDumper(const std::string &name, std::vector<std::shar
                                   std::shared_ptr<OptionArgs> args, int level)
 {
     DumpStatus ret = DumpStatus::DUMP_FAIL;
-    int index = -1;
-    for (int i = 0; i < dumperSum_; i++) {
-        if (dumpers_[i].name_.empty()) {
-            continue;
-        }
-        if (name != dumpers_[i].name_) {
-            continue;
-        }
-        index = i;
-        break;
-    }
+    int index = FindDumperIndex(name);
     if (index > -1) {
         ret = GetDumper(index, result, args, level);
     }
     return ret;
 }
 
-DumpStatus ConfigUtils::GetGroupSimple(const GroupCfg &groupCfg, std::vector<std::shared_ptr<DumpCfg>> &result,
+DumpStatus ConfigUtils::GetGroupSimple(int index, std::vector<std::shared_ptr<DumpCfg>> &result,
                                        std::shared_ptr<OptionArgs> args, int level, int nest)
 {
     if (nest > NEST_MAX) {
         return DumpStatus::DUMP_INVALID_ARG;
     }
+    const GroupCfg &groupCfg = groups_[index];
     if ((groupCfg.list_ == nullptr) || (groupCfg.size_ < 1)) {
         return DumpStatus::DUMP_OK;
     }
@@ -744,14 +743,13 @@ DumpStatus ConfigUtils::GetGroupSimple(const GroupCfg &groupCfg, std::vector<std
     }
     auto &outlist = (groupCfg.expand_) ? dumpGroup->childs_ : result;
 
-    for (int i = 0; i < groupCfg.size_; i++) {
-        if (groupCfg.list_[i].empty()) {
-            continue;
-        }
-        if (DumpCommonUtils::StartWith(groupCfg.list_[i], CONFIG_DUMPER_)) {
-            GetDumper(groupCfg.list_[i], outlist, args, level);
-        } else if (DumpCommonUtils::StartWith(groupCfg.list_[i], CONFIG_MINIGROUP_)) {
-            GetGroup(groupCfg.list_[i], outlist, args, level, nest + 1);
+    for (const auto &member : GetGroupMembers(index)) {
+        if (member.type_ == MemberType::DUMPER) {
+            GetDumper(member.index_, outlist, args, level);
+        } else if (member.type_ == MemberType::MINIGROUP) {
+            if (member.index_ > -1) {
+                GetGroup(member.index_, outlist, args, level, nest + 1);
+            }
         } else {
             DUMPER_HILOGE(MODULE_COMMON, "error|name=%{public}s", groupCfg.name_.c_str());
             return DumpStatus::DUMP_INVALID_ARG;
@@ -782,27 +780,27 @@ DumpStatus ConfigUtils::GetGroup(int index, std::vector<std::shared_ptr<DumpCfg>
             }
             auto newArgs = OptionArgs::Clone(args);
             newArgs->SetPid(pidInfo.pid_, pidInfo.uid_);
-            GetGroupSimple(groups_[index], dumpGroup->childs_, newArgs, newLevel, nest);
+            GetGroupSimple(index, dumpGroup->childs_, newArgs, newLevel, nest);
         }
     } else if (dumpGroup->expand_ && (dumpGroup->type_ == DumperConstant::GROUPTYPE_CPUID)) {
         for (auto cpuInfo : cpuInfos_) {
             auto newArgs = OptionArgs::Clone(args);
             newArgs->SetCpuId(cpuInfo.id_);
-            GetGroupSimple(groups_[index], dumpGroup->childs_, newArgs, level, nest);
+            GetGroupSimple(index, dumpGroup->childs_, newArgs, level, nest);
         }
     } else if (dumpGroup->type_ == DumperConstant::GROUPTYPE_PID) {
         int newLevel = GetDumpLevelByPid(dumperParam_->GetUid(), currentPidInfo_);
         if (newLevel != DumperConstant::LEVEL_NONE) {
             auto newArgs = OptionArgs::Clone(args);
             newArgs->SetPid(currentPidInfo_.pid_, currentPidInfo_.uid_);
-            GetGroupSimple(groups_[index], dumpGroup->childs_, newArgs, level, nest);
+            GetGroupSimple(index, dumpGroup->childs_, newArgs, level, nest);
         }
     } else if (dumpGroup->type_ == DumperConstant::GROUPTYPE_CPUID) {
         auto newArgs = OptionArgs::Clone(args);
         newArgs->SetCpuId(-1);
-        GetGroupSimple(groups_[index], dumpGroup->childs_, newArgs, level, nest);
+        GetGroupSimple(index, dumpGroup->childs_, newArgs, level, nest);
     } else if (dumpGroup->type_ == DumperConstant::NONE) {
-        GetGroupSimple(groups_[index], dumpGroup->childs_, args, level, nest);
+        GetGroupSimple(index, dumpGroup->childs_, args, level, nest);
     } else {
         DUMPER_HILOGE(MODULE_COMMON, "error|type=%{public}d", dumpGroup->type_);
         return DumpStatus::DUMP_INVALID_ARG;
@@ -817,18 +815,7 @@ DumpStatus ConfigUtils::GetGroup(const std::string &name, std::vector<std::share
         return DumpStatus::DUMP_INVALID_ARG;
     }
     DumpStatus ret = DumpStatus::DUMP_FAIL;
-    int index = -1;
-    // find group
-    for (int i = 0; i < groupSum_; i++) {
-        if (groups_[i].name_.empty()) {
-            continue;
-        }
-        if (name != groups_[i].name_) {
-            continue;
-        }
-        index = i;
-        break;
-    }
+    int index = FindGroupIndex(name);
 
     // add dump config to tmpUse
     std::vector<std::shared_ptr<DumpCfg>> tmpUse;
@@ -847,6 +834,32 @@ DumpStatus ConfigUtils::GetGroup(const std::string &name, std::vector<std::share
     return ret;
 }
 
+bool ConfigUtils::HandleQueryFilter(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs)
+{
+    const DumperOpts &dumperOpts = dumperParam_->GetOpts();
+    if (dumperOpts.query_.empty()) {
+        return false;
+    }
+
+    // the query runs on the rows of a chain right before its output writes them.
+    std::vector<std::shared_ptr<DumpCfg>> result;
+    for (auto dumpCfg : dumpCfgs) {
+        if ((dumpCfg != nullptr) && dumpCfg->IsOutput()) {
+            auto filterCfg = DumpCfg::Create();
+            filterCfg->section_ = dumpCfg->section_;
+            filterCfg->class_ = DumperConstant::COLUMN_ROWS_FILTER;
+            filterCfg->level_ = DumperConstant::LEVEL_ALL;
+            filterCfg->loop_ = DumperConstant::NONE;
+            filterCfg->parent_ = dumpCfg->parent_;
+            result.push_back(filterCfg);
+        }
+        result.push_back(dumpCfg);
+    }
+    DUMPER_HILOGD(MODULE_COMMON, "debug|query filters=%{public}zu", result.size() - dumpCfgs.size());
+    dumpCfgs.swap(result);
+    return true;
+}
+
 void ConfigUtils::ConvertTreeToList(std::vector<std::shared_ptr<DumpCfg>> &tree,
                                     std::vector<std::shared_ptr<DumpCfg>> &list, int nest)
 {
@@ -906,24 +919,73 @@ bool ConfigUtils::CopySmaps()
     callback->SetProgressEnabled(true);
     std::string logFolder = callback->GetFolder();
     int uid = dumperParam_->GetUid();
+    std::vector<std::pair<std::string, std::string>> jobs; // source file, destination folder
     for (auto &pidInfo : currentPidInfos_) {
         int newLevel = GetDumpLevelByPid(uid, pidInfo);
         if (newLevel == DumperConstant::LEVEL_NONE) {
             continue;
         }
-        if (callback->IsCanceled()) {
-            DUMPER_HILOGD(MODULE_COMMON, "CopySmaps debug|Canceled");
-            break;
-        }
-        callback->UpdateProgress(0);
         std::string pid = std::to_string(pidInfo.pid_);
-        std::string desfolder = logFolder + SMAPS_PATH + pidInfo.name_ + "-" + pid;
-        std::string src = SMAPS_PATH_START + pid + SMAPS_PATH_END;
-        std::string des = desfolder + SMAPS_PATH_END;
-        ForceCreateDirectory(IncludeTrailingPathDelimiter(desfolder));
-        DumpUtils::CopyFile(src, des);
+        jobs.emplace_back(SMAPS_PATH_START + pid + SMAPS_PATH_END,
+            logFolder + SMAPS_PATH + pidInfo.name_ + "-" + pid);
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::atomic<size_t> next {0};
+    std::atomic<size_t> staged {0};
+    std::atomic<uint64_t> stagedBytes {0};
+    auto stageSmaps = [&jobs, &next, &staged, &stagedBytes, &callback](bool updateProgress) {
+        std::vector<char> buffer;
+        for (size_t i = next++; i < jobs.size(); i = next++) {
+            if (callback->IsCanceled()) {
+                DUMPER_HILOGD(MODULE_COMMON, "CopySmaps debug|Canceled");
+                break;
+            }
+            if (updateProgress) {
+                callback->UpdateProgress(0);
+            }
+            const std::string &desFolder = jobs[i].second;
+            ForceCreateDirectory(IncludeTrailingPathDelimiter(desFolder));
+            int64_t bytes = FileUtils::GetInstance().CopyProcFile(jobs[i].first, desFolder + SMAPS_PATH_END, buffer);
+            if (bytes < 0) {
+                rmdir(desFolder.c_str()); // the process is gone, skip it
+                continue;
+            }
+            staged++;
+            stagedBytes += static_cast<uint64_t>(bytes);
+        }
+    };
+    size_t hardwareThreads = std::thread::hardware_concurrency();
+    size_t threadNum = std::min(jobs.size(), (hardwareThreads == 0) ? SMAPS_THREAD_MAX :
+        std::min(hardwareThreads, SMAPS_THREAD_MAX));
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threadNum; i++) {
+        workers.emplace_back(stageSmaps, false);
+    }
+    stageSmaps(true); // progress is only reported from the request thread
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    auto costMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    DUMPER_HILOGI(MODULE_COMMON, "CopySmaps staged %{public}zu/%{public}zu, %{public}" PRIu64 " bytes, "
+        "%{public}lld ms, %{public}zu threads", staged.load(), jobs.size(), stagedBytes.load(),
+        static_cast<long long>(costMs), threadNum);
+    // the same line goes into the log of the zip, so the cost of the staging is visible to whoever reads it.
+    std::string summary = "smaps staged " + std::to_string(staged.load()) + "/" + std::to_string(jobs.size()) +
+        ", " + std::to_string(stagedBytes.load()) + " bytes, " + std::to_string(costMs) + " ms, " +
+        std::to_string(threadNum) + " threads\n";
+    std::shared_ptr<DumpStagingArea> stagingArea = callback->GetStagingArea();
+    if (stagingArea != nullptr) {
+        stagingArea->Append(LOG_DEFAULT, summary);
+    } else {
+        int fd = DumpUtils::FdToWrite(logFolder + LOG_DEFAULT);
+        if (fd >= 0) {
+            SaveStringToFd(fd, summary);
+            fdsan_exchange_owner_tag(fd, 0, FDTAG);
+            fdsan_close_with_tag(fd, FDTAG);
+        }
     }
-
     DUMPER_HILOGD(MODULE_COMMON, "CopySmaps leave|true");
     return true;
 }
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/dump_staging_area.h"
+#include <cerrno>
+#include <fcntl.h>
+#include <linux/magic.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+#include "common/dumper_constant.h"
+#include "directory_ex.h"
+#include "dump_utils.h"
+#include "hilog_wrapper.h"
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static constexpr size_t SPILL_BUF_SIZE = 256 * 1024;
+
+bool WriteAll(int fd, const char *data, size_t size)
+{
+    size_t written = 0;
+    while (written < size) {
+        ssize_t ret = TEMP_FAILURE_RETRY(write(fd, data + written, size - written));
+        if (ret <= 0) {
+            return false;
+        }
+        written += static_cast<size_t>(ret);
+    }
+    return true;
+}
+} // namespace
+
+DumpStagingArea::DumpStagingArea(const std::string &diskFolder, Backend backend, int64_t memoryLimit,
+    const std::string &tmpfsFolder)
+    : diskFolder_(IncludeTrailingPathDelimiter(diskFolder)), backend_(backend), memoryLimit_(memoryLimit)
+{
+    if (backend_ != Backend::TMPFS) {
+        return;
+    }
+    tmpfsFolder_ = tmpfsFolder.empty() ? "" : IncludeTrailingPathDelimiter(tmpfsFolder);
+    struct statfs fsInfo = {};
+    if (tmpfsFolder_.empty() || !ForceCreateDirectory(tmpfsFolder_) || (statfs(tmpfsFolder_.c_str(), &fsInfo) != 0) ||
+        (fsInfo.f_type != TMPFS_MAGIC)) {
+        DUMPER_HILOGE(MODULE_COMMON, "tmpfs folder [%{public}s] unusable, stage on disk", tmpfsFolder_.c_str());
+        tmpfsFolder_.clear();
+        backend_ = Backend::DISK;
+    }
+}
+
+DumpStagingArea::~DumpStagingArea()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &item : entries_) {
+        CloseFd(item.second.fd);
+    }
+    entries_.clear();
+    if (!tmpfsFolder_.empty()) {
+        ForceRemoveDirectory(tmpfsFolder_);
+    }
+}
+
+DumpStagingArea::Backend DumpStagingArea::GetBackend() const
+{
+    return backend_;
+}
+
+const std::string &DumpStagingArea::GetDiskFolder() const
+{
+    return diskFolder_;
+}
+
+bool DumpStagingArea::Append(const std::string &name, const std::string &data)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry &entry = GetEntry(name, true);
+    if ((entry.fd >= 0) && (memoryUsage_ + static_cast<int64_t>(data.size()) > memoryLimit_)) {
+        Spill(name, entry);
+    }
+    if (entry.fd >= 0) {
+        if ((lseek(entry.fd, 0, SEEK_END) == -1) || !WriteAll(entry.fd, data.data(), data.size())) {
+            return false;
+        }
+        entry.size += static_cast<int64_t>(data.size());
+        memoryUsage_ += static_cast<int64_t>(data.size());
+        return true;
+    }
+    int fd = OpenDiskFile(name);
+    if (fd < 0) {
+        return false;
+    }
+    bool ret = WriteAll(fd, data.data(), data.size());
+    CloseFd(fd);
+    return ret;
+}
+
+int DumpStagingArea::OpenEntry(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry &entry = GetEntry(name, false);
+    if ((entry.fd >= 0) && !Spill(name, entry)) {
+        return -1;
+    }
+    return OpenDiskFile(name);
+}
+
+void DumpStagingArea::CloseEntry(int fd)
+{
+    CloseFd(fd);
+}
+
+std::vector<std::pair<int, std::string>> DumpStagingArea::GetMemoryEntries()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::pair<int, std::string>> memoryEntries;
+    for (const auto &item : entries_) {
+        if (item.second.fd >= 0) {
+            memoryEntries.emplace_back(item.second.fd, item.first);
+        }
+    }
+    return memoryEntries;
+}
+
+int64_t DumpStagingArea::GetMemoryUsage()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memoryUsage_;
+}
+
+DumpStagingArea::Entry &DumpStagingArea::GetEntry(const std::string &name, bool inMemory)
+{
+    auto found = entries_.find(name);
+    if (found != entries_.end()) {
+        return found->second;
+    }
+    Entry entry;
+    // nested names keep their folders on disk, so only flat names are held in memory.
+    if (inMemory && (backend_ != Backend::DISK) && (name.find('/') == std::string::npos) &&
+        (memoryUsage_ < memoryLimit_)) {
+        entry.fd = CreateMemoryFile(name);
+    }
+    return entries_.emplace(name, entry).first->second;
+}
+
+int DumpStagingArea::CreateMemoryFile(const std::string &name)
+{
+    int fd = -1;
+    if (backend_ == Backend::MEMFD) {
+        fd = memfd_create(name.c_str(), MFD_CLOEXEC);
+    } else {
+        std::string path = tmpfsFolder_ + name;
+        fd = TEMP_FAILURE_RETRY(open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC | O_NOFOLLOW,
+            S_IRUSR | S_IWUSR));
+        if (fd >= 0) {
+            // the fd keeps the data alive, nothing is left behind if the service dies.
+            (void)unlink(path.c_str());
+        }
+    }
+    if (fd < 0) {
+        DUMPER_HILOGE(MODULE_COMMON, "create memory file failed, errno=%{public}d, stage on disk", errno);
+        return -1;
+    }
+    return fd;
+}
+
+int DumpStagingArea::OpenDiskFile(const std::string &name)
+{
+    int fd = DumpUtils::FdToWrite(diskFolder_ + name);
+    // several fds and Append may write one entry, each write has to land at the end whatever fd it goes through.
+    int flags = (fd >= 0) ? fcntl(fd, F_GETFL) : -1;
+    if ((flags != -1) && (fcntl(fd, F_SETFL, flags | O_APPEND) == -1)) {
+        DUMPER_HILOGE(MODULE_COMMON, "set append on [%{public}s] failed, errno=%{public}d", name.c_str(), errno);
+    }
+    return fd;
+}
+
+bool DumpStagingArea::CopyToDisk(int diskFd, const Entry &entry)
+{
+    std::vector<char> buffer(SPILL_BUF_SIZE);
+    off_t offset = 0;
+    while (true) {
+        ssize_t readLen = TEMP_FAILURE_RETRY(pread(entry.fd, buffer.data(), buffer.size(), offset));
+        if (readLen == 0) {
+            return true;
+        }
+        if ((readLen < 0) || !WriteAll(diskFd, buffer.data(), static_cast<size_t>(readLen))) {
+            return false;
+        }
+        offset += readLen;
+    }
+}
+
+bool DumpStagingArea::Spill(const std::string &name, Entry &entry)
+{
+    int fd = OpenDiskFile(name);
+    if (fd < 0) {
+        return false;
+    }
+    if (!CopyToDisk(fd, entry)) {
+        DUMPER_HILOGE(MODULE_COMMON, "spill [%{public}s] failed, errno=%{public}d", name.c_str(), errno);
+        CloseFd(fd);
+        (void)unlink((diskFolder_ + name).c_str());
+        return false;
+    }
+    CloseFd(fd);
+    DUMPER_HILOGI(MODULE_COMMON, "spill [%{public}s] to disk, size=%{public}lld", name.c_str(),
+        static_cast<long long>(entry.size));
+    CloseFd(entry.fd);
+    entry.fd = -1;
+    memoryUsage_ -= entry.size;
+    entry.size = 0;
+    return true;
+}
+
+void DumpStagingArea::CloseFd(int fd)
+{
+    if (fd < 0) {
+        return;
+    }
+    fdsan_exchange_owner_tag(fd, 0, FDTAG);
+    fdsan_close_with_tag(fd, FDTAG);
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -12,7 +12,10 @@
 * See the License for the specific language governing permissions and
 * limitations under the License.
 */
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <fcntl.h>
 #include <filesystem>
 #include <unistd.h>
 #include <sys/stat.h>
@@ -25,6 +28,22 @@ namespace OHOS {
 namespace HiviewDFX {
 static const std::string UNKNOWN = "unknown";
 constexpr int VALUES_MIN_LEN = 1;
+constexpr size_t PROC_COPY_MIN_BUFFER = 64 * 1024;
+constexpr size_t PROC_COPY_MAX_BUFFER = 1024 * 1024;
+
+static bool WriteAll(int fd, const char* data, size_t size)
+{
+    size_t written = 0;
+    while (written < size) {
+        ssize_t ret = TEMP_FAILURE_RETRY(write(fd, data + written, size - written));
+        if (ret <= 0) {
+            return false;
+        }
+        written += static_cast<size_t>(ret);
+    }
+    return true;
+}
+
 FileUtils::FileUtils()
 {
 }
@@ -147,5 +166,79 @@ bool FileUtils::GetLastWriteTime(const std::string &path, time_t& lastWriteTime)
     lastWriteTime = std::chrono::system_clock::to_time_t(convertStandardTime);
     return true;
 }
+
+int64_t FileUtils::CopyProcFile(const std::string& src, const std::string& des, std::vector<char>& buffer)
+{
+    int srcFd = TEMP_FAILURE_RETRY(open(src.c_str(), O_RDONLY | O_CLOEXEC));
+    if (srcFd < 0) {
+        DUMPER_HILOGD(MODULE_COMMON, "open %{public}s failed, errno=%{public}d", src.c_str(), errno);
+        return -1;
+    }
+    int desFd = TEMP_FAILURE_RETRY(open(des.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC | O_NOFOLLOW,
+        S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH));
+    if (desFd < 0) {
+        DUMPER_HILOGE(MODULE_COMMON, "open %{public}s failed, errno=%{public}d", des.c_str(), errno);
+        close(srcFd);
+        return -1;
+    }
+    if (buffer.size() < PROC_COPY_MIN_BUFFER) {
+        buffer.resize(PROC_COPY_MIN_BUFFER);
+    }
+    int64_t total = 0;
+    bool success = true;
+    while (true) {
+        ssize_t readLen = TEMP_FAILURE_RETRY(read(srcFd, buffer.data(), buffer.size()));
+        if (readLen <= 0) {
+            success = (readLen == 0);
+            break;
+        }
+        if (!WriteAll(desFd, buffer.data(), static_cast<size_t>(readLen))) {
+            success = false;
+            break;
+        }
+        total += readLen;
+        if ((static_cast<size_t>(readLen) == buffer.size()) && (buffer.size() < PROC_COPY_MAX_BUFFER)) {
+            buffer.resize(buffer.size() * 2); // a full read means more is pending, read more per call
+        }
+    }
+    close(srcFd);
+    close(desFd);
+    if (!success) {
+        unlink(des.c_str());
+        return -1;
+    }
+    return total;
+}
+
+void FileUtils::SetProcRoot(const std::string& root)
+{
+    std::string procRoot = root;
+    while (!procRoot.empty() && procRoot.back() == '/') {
+        procRoot.pop_back();
+    }
+    std::lock_guard<std::mutex> lock(procRootMutex_);
+    if (procRoot.empty()) {
+        procRoot_.store(nullptr, std::memory_order_release);
+        return;
+    }
+    auto iter = std::find_if(procRoots_.begin(), procRoots_.end(),
+        [&procRoot](const std::unique_ptr<std::string> &kept) { return *kept == procRoot; });
+    if (iter == procRoots_.end()) {
+        iter = procRoots_.insert(procRoots_.end(), std::make_unique<std::string>(procRoot));
+    }
+    procRoot_.store(iter->get(), std::memory_order_release);
+}
+
+std::string FileUtils::GetProcRoot()
+{
+    const std::string *procRoot = procRoot_.load(std::memory_order_acquire);
+    return (procRoot == nullptr) ? "" : *procRoot;
+}
+
+std::string FileUtils::GetProcPath(const std::string& path)
+{
+    const std::string *procRoot = procRoot_.load(std::memory_order_acquire);
+    return (procRoot == nullptr) ? path : *procRoot + path;
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
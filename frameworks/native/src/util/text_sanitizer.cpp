@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/text_sanitizer.h"
+#include <cstdint>
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+const char ASCII_CR = '\r';
+const char ASCII_LF = '\n';
+const char ASCII_ESC = '\033';
+const char ASCII_OB = '[';
+const char ASCII_UA = 'A';
+const char ASCII_LA = 'a';
+const char ASCII_UZ = 'Z';
+const char ASCII_LZ = 'z';
+#if defined(__SSE2__)
+constexpr size_t BLOCK_SIZE = 16;
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+constexpr size_t BLOCK_SIZE = 32;
+constexpr size_t HALF_BLOCK_SIZE = 16;
+#else
+constexpr size_t BLOCK_SIZE = sizeof(uint64_t);
+constexpr uint64_t LOW_BITS = 0x0101010101010101ULL;
+constexpr uint64_t HIGH_BITS = 0x8080808080808080ULL;
+#endif
+
+inline bool IsDirty(char c)
+{
+    return (c == ASCII_CR) || (c == ASCII_LF) || (c == ASCII_ESC);
+}
+
+inline bool IsLetter(char c)
+{
+    return ((c >= ASCII_UA) && (c <= ASCII_UZ)) || ((c >= ASCII_LA) && (c <= ASCII_LZ));
+}
+
+#if defined(__SSE2__)
+inline int DirtyMask(const char *block)
+{
+    const __m128i cr = _mm_set1_epi8(ASCII_CR);
+    const __m128i lf = _mm_set1_epi8(ASCII_LF);
+    const __m128i esc = _mm_set1_epi8(ASCII_ESC);
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block));
+    __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, cr), _mm_cmpeq_epi8(bytes, lf)),
+        _mm_cmpeq_epi8(bytes, esc));
+    return _mm_movemask_epi8(hits);
+}
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+inline uint8x16_t DirtyLanes(const char *block)
+{
+    uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t *>(block));
+    return vorrq_u8(vorrq_u8(vceqq_u8(bytes, vdupq_n_u8(ASCII_CR)), vceqq_u8(bytes, vdupq_n_u8(ASCII_LF))),
+        vceqq_u8(bytes, vdupq_n_u8(ASCII_ESC)));
+}
+
+inline bool HasDirty(const char *block)
+{
+    uint64x2_t lanes = vreinterpretq_u64_u8(vorrq_u8(DirtyLanes(block), DirtyLanes(block + HALF_BLOCK_SIZE)));
+    return (vgetq_lane_u64(lanes, 0) | vgetq_lane_u64(lanes, 1)) != 0;
+}
+#else
+// a word with a zero byte has the high bit of that byte set, the words are compared against each dirty byte.
+inline bool HasZeroByte(uint64_t word)
+{
+    return ((word - LOW_BITS) & ~word & HIGH_BITS) != 0;
+}
+
+inline bool HasDirty(const char *block)
+{
+    uint64_t word = 0;
+    memcpy(&word, block, sizeof(word));
+    return HasZeroByte(word ^ (LOW_BITS * static_cast<uint8_t>(ASCII_CR))) ||
+        HasZeroByte(word ^ (LOW_BITS * static_cast<uint8_t>(ASCII_LF))) ||
+        HasZeroByte(word ^ (LOW_BITS * static_cast<uint8_t>(ASCII_ESC)));
+}
+#endif
+
+// data[0, pos) is clean and already emitted, data[pos] is dirty. Every clean run after it is passed to emit.
+template<typename Emit>
+void ScrubFrom(const char *data, size_t size, size_t pos, Emit &&emit)
+{
+    while (pos < size) {
+        char c = data[pos];
+        if ((c == ASCII_ESC) && ((pos + 1) < size) && (data[pos + 1] == ASCII_OB)) {
+            pos += 2; // ESC '['
+            while ((pos < size) && !IsLetter(data[pos])) {
+                pos++;
+            }
+        } else if (c == ASCII_ESC) {
+            emit(data + pos, 1); // an ESC out of a sequence is kept
+        }
+        if (pos < size) {
+            pos++;
+        }
+        size_t clean = TextSanitizer::FindDirty(data + pos, size - pos);
+        if (clean > 0) {
+            emit(data + pos, clean);
+            pos += clean;
+        }
+    }
+}
+} // namespace
+
+size_t TextSanitizer::FindDirty(const char *data, size_t size)
+{
+    size_t pos = 0;
+    for (; (pos + BLOCK_SIZE) <= size; pos += BLOCK_SIZE) {
+#if defined(__SSE2__)
+        int mask = DirtyMask(data + pos);
+        if (mask != 0) {
+            return pos + static_cast<size_t>(__builtin_ctz(static_cast<unsigned int>(mask)));
+        }
+#else
+        if (HasDirty(data + pos)) {
+            break;
+        }
+#endif
+    }
+    for (; pos < size; pos++) {
+        if (IsDirty(data[pos])) {
+            return pos;
+        }
+    }
+    return size;
+}
+
+bool TextSanitizer::IsClean(const std::string &str)
+{
+    return FindDirty(str.data(), str.size()) == str.size();
+}
+
+void TextSanitizer::Sanitize(std::string &str)
+{
+    const size_t size = str.size();
+    size_t first = FindDirty(str.data(), size);
+    if (first == size) {
+        return;
+    }
+    char *begin = &str[0];
+    char *out = begin + first;
+    ScrubFrom(begin, size, first, [&out](const char *run, size_t len) {
+        if (out != run) {
+            memmove(out, run, len);
+        }
+        out += len;
+    });
+    str.resize(static_cast<size_t>(out - begin));
+}
+
+void TextSanitizer::SanitizeAppend(const char *data, size_t size, std::string &out)
+{
+    size_t first = FindDirty(data, size);
+    out.append(data, first);
+    if (first == size) {
+        return;
+    }
+    ScrubFrom(data, size, first, [&out](const char *run, size_t len) {
+        out.append(run, len);
+    });
+}
+} // namespace HiviewDFX
+} // namespace OHOS
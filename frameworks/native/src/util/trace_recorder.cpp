@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/trace_recorder.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <sys/prctl.h>
+#include <unistd.h>
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr size_t DETAIL_SIZE = 48;
+constexpr size_t THREAD_NAME_SIZE = 16;
+constexpr size_t CHUNK_EVENTS = 256;
+constexpr size_t MAX_CHUNKS = 64; // 16384 events a buffer and session, the rest is counted as dropped
+constexpr unsigned char UTF8_CONTINUATION_MASK = 0xC0;
+constexpr unsigned char UTF8_CONTINUATION = 0x80;
+constexpr unsigned char JSON_CONTROL_END = 0x20;
+
+struct TraceEvent {
+    const char *category; // nullptr for the thread name metadata
+    const char *name;
+    uint64_t beginUs;
+    uint64_t durUs;
+    int32_t tid;
+    char detail[DETAIL_SIZE];
+};
+
+struct TraceChunk {
+    TraceEvent events[CHUNK_EVENTS];
+    std::atomic<TraceChunk *> next {nullptr};
+};
+
+// written by the thread holding it, read by Stop up to count. a buffer released by an exited thread is taken over
+// by the next new thread, so every event carries its own tid.
+struct TraceBuffer {
+    std::atomic<TraceBuffer *> next {nullptr};
+    std::atomic<bool> owned {true};
+    std::atomic<uint64_t> generation {0};
+    std::atomic<size_t> count {0};
+    std::atomic<size_t> dropped {0};
+    TraceChunk head;
+    TraceChunk *tail {&head};
+};
+
+struct BufferLease {
+    TraceBuffer *buffer {nullptr};
+    int32_t tid {0};
+    uint64_t namedGeneration {0};
+    ~BufferLease()
+    {
+        if (buffer != nullptr) {
+            buffer->owned.store(false, std::memory_order_release);
+        }
+    }
+};
+
+thread_local BufferLease g_lease;
+std::atomic<TraceBuffer *> g_buffers {nullptr}; // never shrinks, one buffer per thread traced at the same time
+std::atomic<uint64_t> g_generation {0};
+std::atomic<uint64_t> g_sessionBeginUs {0};
+std::atomic<bool> g_sessionActive {false};
+
+TraceBuffer *AcquireBuffer()
+{
+    for (TraceBuffer *buffer = g_buffers.load(std::memory_order_acquire); buffer != nullptr;
+        buffer = buffer->next.load(std::memory_order_acquire)) {
+        bool expected = false;
+        if (!buffer->owned.load(std::memory_order_relaxed) &&
+            buffer->owned.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            return buffer;
+        }
+    }
+    TraceBuffer *buffer = new (std::nothrow) TraceBuffer();
+    if (buffer == nullptr) {
+        return nullptr;
+    }
+    TraceBuffer *head = g_buffers.load(std::memory_order_relaxed);
+    do {
+        buffer->next.store(head, std::memory_order_relaxed);
+    } while (!g_buffers.compare_exchange_weak(head, buffer, std::memory_order_release, std::memory_order_relaxed));
+    return buffer;
+}
+
+void ResetBuffer(TraceBuffer &buffer, uint64_t generation)
+{
+    buffer.count.store(0, std::memory_order_relaxed);
+    buffer.dropped.store(0, std::memory_order_relaxed);
+    buffer.tail = &buffer.head;
+    buffer.generation.store(generation, std::memory_order_release);
+}
+
+TraceEvent *NextSlot(TraceBuffer &buffer, size_t count)
+{
+    size_t index = count % CHUNK_EVENTS;
+    if ((index == 0) && (count > 0)) {
+        if (count >= (CHUNK_EVENTS * MAX_CHUNKS)) {
+            return nullptr;
+        }
+        TraceChunk *next = buffer.tail->next.load(std::memory_order_relaxed);
+        if (next == nullptr) {
+            next = new (std::nothrow) TraceChunk();
+            if (next == nullptr) {
+                return nullptr;
+            }
+            buffer.tail->next.store(next, std::memory_order_release);
+        }
+        buffer.tail = next;
+    }
+    return &buffer.tail->events[index];
+}
+
+// copies at most DETAIL_SIZE - 1 bytes, a cut never splits a UTF-8 sequence.
+void CopyDetail(char (&dest)[DETAIL_SIZE], const char *src, size_t size)
+{
+    size_t len = std::min(size, DETAIL_SIZE - 1);
+    if (len < size) {
+        while ((len > 0) && ((static_cast<unsigned char>(src[len]) & UTF8_CONTINUATION_MASK) == UTF8_CONTINUATION)) {
+            len--;
+        }
+    }
+    if (len > 0) {
+        memcpy(dest, src, len);
+    }
+    dest[len] = '\0';
+}
+
+void Append(TraceBuffer &buffer, const TraceEvent &event, const char *detail, size_t detailSize)
+{
+    size_t count = buffer.count.load(std::memory_order_relaxed);
+    TraceEvent *slot = NextSlot(buffer, count);
+    if (slot == nullptr) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    *slot = event;
+    CopyDetail(slot->detail, detail, detailSize);
+    buffer.count.store(count + 1, std::memory_order_release);
+}
+
+void AppendEscaped(std::string &out, const char *str)
+{
+    for (; *str != '\0'; str++) {
+        unsigned char c = static_cast<unsigned char>(*str);
+        if ((c == '"') || (c == '\\')) {
+            out.push_back('\\');
+            out.push_back(static_cast<char>(c));
+        } else if (c < JSON_CONTROL_END) {
+            char escaped[sizeof("\\u0000")] = {0};
+            (void)snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out.append(escaped);
+        } else {
+            out.push_back(static_cast<char>(c));
+        }
+    }
+}
+
+void AppendEvent(std::string &out, const TraceEvent &event, const std::string &pid, uint64_t sessionBeginUs)
+{
+    if (event.category == nullptr) {
+        out.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":").append(pid);
+        out.append(",\"tid\":").append(std::to_string(event.tid)).append(",\"args\":{\"name\":\"");
+        AppendEscaped(out, event.detail);
+        out.append("\"}},\n");
+        return;
+    }
+    out.append("{\"name\":\"");
+    AppendEscaped(out, event.name);
+    out.append("\",\"cat\":\"");
+    AppendEscaped(out, event.category);
+    out.append("\",\"ph\":\"X\",\"ts\":").append(std::to_string(event.beginUs - sessionBeginUs));
+    out.append(",\"dur\":").append(std::to_string(event.durUs));
+    out.append(",\"pid\":").append(pid).append(",\"tid\":").append(std::to_string(event.tid));
+    if (event.detail[0] != '\0') {
+        out.append(",\"args\":{\"detail\":\"");
+        AppendEscaped(out, event.detail);
+        out.append("\"}");
+    }
+    out.append("},\n");
+}
+} // namespace
+
+std::atomic<bool> TraceRecorder::enabled_ {false};
+
+bool TraceRecorder::Start()
+{
+    bool expected = false;
+    if (!g_sessionActive.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        return false;
+    }
+    g_sessionBeginUs.store(NowUs(), std::memory_order_relaxed);
+    g_generation.fetch_add(1, std::memory_order_acq_rel);
+    enabled_.store(true, std::memory_order_release);
+    return true;
+}
+
+std::string TraceRecorder::Stop()
+{
+    if (!g_sessionActive.load(std::memory_order_acquire)) {
+        return "";
+    }
+    enabled_.store(false, std::memory_order_relaxed);
+    const uint64_t generation = g_generation.load(std::memory_order_acquire);
+    const uint64_t sessionBeginUs = g_sessionBeginUs.load(std::memory_order_relaxed);
+    const std::string pid = std::to_string(getpid());
+    std::string json = "{\"traceEvents\":[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" + pid +
+        ",\"args\":{\"name\":\"hidumper_service\"}},\n";
+    size_t dropped = 0;
+    for (TraceBuffer *buffer = g_buffers.load(std::memory_order_acquire); buffer != nullptr;
+        buffer = buffer->next.load(std::memory_order_acquire)) {
+        if (buffer->generation.load(std::memory_order_acquire) != generation) {
+            continue;
+        }
+        // spans still open keep appending, only the events published so far are read.
+        size_t count = buffer->count.load(std::memory_order_acquire);
+        const TraceChunk *chunk = &buffer->head;
+        for (size_t i = 0; (i < count) && (chunk != nullptr); i++) {
+            if ((i > 0) && ((i % CHUNK_EVENTS) == 0)) {
+                chunk = chunk->next.load(std::memory_order_acquire);
+                if (chunk == nullptr) {
+                    break;
+                }
+            }
+            const TraceEvent &event = chunk->events[i % CHUNK_EVENTS];
+            // a span begun before Start may end in this session, it is left out.
+            if ((event.category == nullptr) || (event.beginUs >= sessionBeginUs)) {
+                AppendEvent(json, event, pid, sessionBeginUs);
+            }
+        }
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    json.pop_back(); // the ",\n" after the last event
+    json.pop_back();
+    json.append("\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":").append(std::to_string(dropped));
+    json.append("}}\n");
+    g_sessionActive.store(false, std::memory_order_release);
+    return json;
+}
+
+uint64_t TraceRecorder::NowUs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void TraceRecorder::Record(const char *category, const char *name, const std::string *detail, uint64_t beginUs,
+    uint64_t endUs)
+{
+    BufferLease &lease = g_lease;
+    if (lease.buffer == nullptr) {
+        lease.buffer = AcquireBuffer();
+        if (lease.buffer == nullptr) {
+            return;
+        }
+        lease.tid = static_cast<int32_t>(gettid());
+        lease.namedGeneration = 0;
+    }
+    TraceBuffer &buffer = *lease.buffer;
+    const uint64_t generation = g_generation.load(std::memory_order_acquire);
+    if (buffer.generation.load(std::memory_order_relaxed) != generation) {
+        ResetBuffer(buffer, generation);
+    }
+    if (lease.namedGeneration != generation) {
+        char threadName[THREAD_NAME_SIZE + 1] = {0};
+        (void)prctl(PR_GET_NAME, threadName);
+        Append(buffer, TraceEvent {nullptr, nullptr, beginUs, 0, lease.tid, {}}, threadName, strlen(threadName));
+        lease.namedGeneration = generation;
+    }
+    TraceEvent event {category, name, beginUs, endUs - beginUs, lease.tid, {}};
+    if (detail != nullptr) {
+        Append(buffer, event, detail->data(), detail->size());
+    } else {
+        Append(buffer, event, "", 0);
+    }
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -13,17 +13,213 @@
  * limitations under the License.
  */
 #include "util/zip/zip_writer.h"
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <mutex>
+#include <strings.h>
+#include <thread>
+#include <unistd.h>
+#include <sys/stat.h>
 #include "directory_ex.h"
 #include "dump_utils.h"
 #include "hilog_wrapper.h"
+#include "util/trace_recorder.h"
 namespace OHOS {
 namespace HiviewDFX {
 namespace {
 static const int PROCENT100 = 100;
-static const int ZIP_BUF_SIZE = 8192;
+static const size_t ZIP_BUF_SIZE = 256 * 1024;
+static const size_t READ_AHEAD_CHUNKS = 4;
+static const int64_t FAST_LEVEL_SIZE = 1024 * 1024;
 static const int BASE_YEAR = 1900;
 static const uLong LANGUAGE_ENCODING_FLAG = 0x1 << 11;
+// inputs that are compressed already, deflating them again only costs time.
+static const char *const STORED_SUFFIXES[] = {".gz", ".zip", ".rawheap"};
+
+bool HasSuffix(const std::string &path, const char *suffix)
+{
+    size_t len = strlen(suffix);
+    return (path.size() >= len) && (strcasecmp(path.c_str() + path.size() - len, suffix) == 0);
+}
+
+int OpenForRead(const std::string &path)
+{
+    int fd = TEMP_FAILURE_RETRY(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (fd >= 0) {
+        (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+    return fd;
+}
+
+// fills buffer up to its capacity, at *offset when it is given, returns the size read or -1.
+ssize_t ReadFull(int fd, std::vector<char> &buffer, off_t *offset = nullptr)
+{
+    size_t total = 0;
+    while (total < buffer.size()) {
+        ssize_t readLen = (offset == nullptr) ?
+            TEMP_FAILURE_RETRY(read(fd, buffer.data() + total, buffer.size() - total)) :
+            TEMP_FAILURE_RETRY(pread(fd, buffer.data() + total, buffer.size() - total, *offset + total));
+        if (readLen < 0) {
+            return -1;
+        }
+        if (readLen == 0) {
+            break;
+        }
+        total += static_cast<size_t>(readLen);
+    }
+    if (offset != nullptr) {
+        *offset += static_cast<off_t>(total);
+    }
+    return static_cast<ssize_t>(total);
+}
+
+struct ZipChunk {
+    size_t item {0};
+    int64_t fileSize {0};
+    std::vector<char> data;
+    bool last {false};
+    bool failed {false};
+};
+
+// reads the files of the items in order on its own thread, at most READ_AHEAD_CHUNKS chunks ahead of
+// the writer, so the next entry is already in memory when the current one is compressed.
+class ZipReadAhead {
+public:
+    explicit ZipReadAhead(const std::vector<ZipWriter::ZipSource> &zipItems) : zipItems_(zipItems)
+    {
+        thread_ = std::thread([this] { Run(); });
+    }
+    ~ZipReadAhead()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = true;
+        }
+        cond_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+    ZipReadAhead(const ZipReadAhead &) = delete;
+    ZipReadAhead &operator=(const ZipReadAhead &) = delete;
+
+    bool Pop(ZipChunk &chunk)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this] { return !chunks_.empty() || done_; });
+        if (chunks_.empty()) {
+            return false;
+        }
+        chunk = std::move(chunks_.front());
+        chunks_.pop_front();
+        cond_.notify_all();
+        return true;
+    }
+    // hands a consumed buffer back, so the reader does not allocate per chunk.
+    void Recycle(std::vector<char> &&buffer)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffers_.push_back(std::move(buffer));
+    }
+    uint64_t GetReadBytes() const
+    {
+        return readBytes_;
+    }
+
+private:
+    void Run()
+    {
+        for (size_t i = 0; i < zipItems_.size(); i++) {
+            if (!ReadItem(i)) {
+                break;
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_ = true;
+        cond_.notify_all();
+    }
+    bool ReadItem(size_t item)
+    {
+        const ZipWriter::ZipSource &source = zipItems_[item];
+        TraceSpan span("zip", "ZipRead", &source.relativePath); // includes the waits for a free chunk
+        ZipChunk chunk;
+        chunk.item = item;
+        // an fd source is shared with its owner, it is read with pread and left open.
+        bool ownFd = (source.fd < 0);
+        int fd = source.fd;
+        if (ownFd) {
+            fd = DumpUtils::PathIsValid(source.absolutePath) ? OpenForRead(source.absolutePath) : -1;
+        }
+        if (fd < 0) {
+            DUMPER_HILOGE(MODULE_COMMON, "ReadItem error|open, errno=%{public}d", errno);
+            chunk.last = true;
+            chunk.failed = true;
+            return Push(std::move(chunk));
+        }
+        struct stat st = {};
+        chunk.fileSize = (fstat(fd, &st) == 0) ? static_cast<int64_t>(st.st_size) : 0;
+        off_t offset = 0;
+        bool ret = true;
+        bool last = false;
+        while (ret && !last) {
+            ZipChunk next;
+            next.item = item;
+            next.fileSize = chunk.fileSize;
+            next.data = TakeBuffer();
+            ssize_t readLen = ReadFull(fd, next.data, ownFd ? nullptr : &offset);
+            next.failed = (readLen < 0);
+            next.data.resize(std::max<ssize_t>(readLen, 0));
+            next.last = next.failed || (next.data.size() < ZIP_BUF_SIZE);
+            last = next.last;
+            readBytes_ += next.data.size();
+            ret = Push(std::move(next));
+        }
+        if (ownFd) {
+            (void)close(fd);
+        }
+        return ret;
+    }
+    std::vector<char> TakeBuffer()
+    {
+        std::vector<char> buffer;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!buffers_.empty()) {
+                buffer = std::move(buffers_.back());
+                buffers_.pop_back();
+            }
+        }
+        buffer.resize(ZIP_BUF_SIZE);
+        return buffer;
+    }
+    bool Push(ZipChunk &&chunk)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this] { return stopped_ || chunks_.size() < READ_AHEAD_CHUNKS; });
+        if (stopped_) {
+            return false;
+        }
+        chunks_.push_back(std::move(chunk));
+        cond_.notify_all();
+        return true;
+    }
+
+private:
+    const std::vector<ZipWriter::ZipSource> &zipItems_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<ZipChunk> chunks_;
+    std::vector<std::vector<char>> buffers_;
+    uint64_t readBytes_ {0}; // only touched by the reader thread until it is joined
+    bool stopped_ {false};
+    bool done_ {false};
+    std::thread thread_;
+};
 } // namespace
 
 ZipWriter::ZipWriter(const std::string &zipFilePath) : zipFilePath_(zipFilePath), zipFile_(nullptr)
@@ -65,6 +261,7 @@ bool ZipWriter::Close()
     int res = ZIP_OK;
 
     if (zipFile_ != nullptr) {
+        TraceSpan span("zip", "ZipClose");
         res = zipClose(zipFile_, nullptr);
     }
     zipFile_ = nullptr;
@@ -76,6 +273,12 @@ bool ZipWriter::Close()
 }
 
 bool ZipWriter::Write(const std::vector<std::pair<std::string, std::string>> &zipItems, const ZipTickNotify notify)
+{
+    return Write(zipItems, {}, notify);
+}
+
+bool ZipWriter::Write(const std::vector<std::pair<std::string, std::string>> &zipItems,
+    const std::vector<std::pair<int, std::string>> &fdItems, const ZipTickNotify notify)
 {
     DUMPER_HILOGD(MODULE_COMMON, "Write enter|");
 
@@ -84,7 +287,12 @@ bool ZipWriter::Write(const std::vector<std::pair<std::string, std::string>> &zi
         return false;
     }
 
-    zipItems_.insert(zipItems_.end(), zipItems.begin(), zipItems.end());
+    for (const auto &item : zipItems) {
+        zipItems_.push_back({item.first, -1, item.second});
+    }
+    for (const auto &item : fdItems) {
+        zipItems_.push_back({"", item.first, item.second});
+    }
 
     bool ret = FlushItems(notify);
     DUMPER_HILOGD(MODULE_COMMON, "Write debug|FlushItems, ret=%{public}d", ret);
@@ -101,35 +309,80 @@ bool ZipWriter::FlushItems(const ZipTickNotify notify)
 {
     DUMPER_HILOGD(MODULE_COMMON, "FlushItems enter|");
 
-    std::vector<std::pair<std::string, std::string>> zipItems;
-    zipItems.assign(zipItems_.begin(), zipItems_.end());
-    zipItems_.clear();
+    std::vector<ZipSource> zipItems;
+    zipItems.swap(zipItems_);
 
+    auto startTime = std::chrono::steady_clock::now();
+    uint64_t readBytes = 0;
     bool ret = true;
-    for (size_t i = 0; i < zipItems.size(); i++) {
-        if ((notify != nullptr) && (notify(((PROCENT100 * i) / zipItems.size()), UNSET_PROGRESS))) {
-            DUMPER_HILOGE(MODULE_COMMON, "FlushItems error|notify");
-            ret = false;
-            break;
-        }
-
-        auto item = zipItems[i];
-        std::string absolutePath = item.first; // first:absolutePath
-        std::string relativePath = item.second; // second:relativePath
-        DUMPER_HILOGD(MODULE_COMMON, "FlushItems debug|relativePath=[%{public}s], absolutePath=[%{public}s]",
-            relativePath.c_str(), absolutePath.c_str());
-
-        if (!AddFileEntryToZip(zipFile_, relativePath, absolutePath)) {
-            DUMPER_HILOGE(MODULE_COMMON, "FlushItems error|false, failed to write file");
-            ret = false;
-            break;
+    {
+        ZipReadAhead readAhead(zipItems);
+        for (size_t i = 0; i < zipItems.size(); i++) {
+            if ((notify != nullptr) && (notify(((PROCENT100 * i) / zipItems.size()), UNSET_PROGRESS))) {
+                DUMPER_HILOGE(MODULE_COMMON, "FlushItems error|notify");
+                ret = false;
+                break;
+            }
+
+            std::string &absolutePath = zipItems[i].absolutePath;
+            std::string &relativePath = zipItems[i].relativePath;
+            TraceSpan span("zip", "ZipEntry", &relativePath);
+            DUMPER_HILOGD(MODULE_COMMON, "FlushItems debug|relativePath=[%{public}s], absolutePath=[%{public}s]",
+                relativePath.c_str(), absolutePath.c_str());
+
+            ZipChunk chunk;
+            if (!readAhead.Pop(chunk) || (chunk.item != i)) {
+                DUMPER_HILOGE(MODULE_COMMON, "FlushItems error|false, failed to read file");
+                ret = false;
+                break;
+            }
+            const std::string &policyPath = absolutePath.empty() ? relativePath : absolutePath;
+            if (!OpenNewFileEntry(zipFile_, relativePath, GetEntryPolicy(policyPath, chunk.fileSize))) {
+                DUMPER_HILOGE(MODULE_COMMON, "FlushItems error|false, open");
+                ret = false;
+                break;
+            }
+            bool content = true;
+            while (true) {
+                content = !chunk.failed && (chunk.data.empty() ||
+                    zipWriteInFileInZip(zipFile_, chunk.data.data(), chunk.data.size()) == ZIP_OK);
+                bool last = chunk.last;
+                readAhead.Recycle(std::move(chunk.data));
+                if (!content || last || !readAhead.Pop(chunk)) {
+                    break;
+                }
+            }
+            if (!CloseNewFileEntry(zipFile_) || !content) {
+                DUMPER_HILOGE(MODULE_COMMON, "FlushItems error|false, failed to write file");
+                ret = false;
+                break;
+            }
         }
+        readBytes = ret ? readAhead.GetReadBytes() : 0;
     }
 
+    auto costMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    DUMPER_HILOGI(MODULE_COMMON, "FlushItems|items=%{public}zu, bytes=%{public}llu, cost=%{public}lld ms",
+        zipItems.size(), static_cast<unsigned long long>(readBytes), static_cast<long long>(costMs));
     DUMPER_HILOGD(MODULE_COMMON, "FlushItems leave|ret=%{public}d", ret);
     return ret;
 }
 
+ZipWriter::EntryPolicy ZipWriter::GetEntryPolicy(const std::string &path, int64_t size)
+{
+    for (auto suffix : STORED_SUFFIXES) {
+        if (HasSuffix(path, suffix)) {
+            return {0, 0}; // method 0: stored
+        }
+    }
+    // large logs are mostly text, the fast level keeps most of the ratio at a fraction of the cost.
+    if (size >= FAST_LEVEL_SIZE) {
+        return {Z_DEFLATED, Z_BEST_SPEED};
+    }
+    return {Z_DEFLATED, Z_DEFAULT_COMPRESSION};
+}
+
 bool ZipWriter::SetTimeToZipFileInfo(zip_fileinfo &zipInfo)
 {
     auto nowTime = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
@@ -153,15 +406,16 @@ zipFile ZipWriter::OpenForZipping(const std::string &fileName, int append)
     return zipOpen2(fileName.c_str(), append, nullptr, nullptr);
 }
 
-bool ZipWriter::ZipOpenNewFileInZip(zipFile zip_file, const std::string &strPath)
+bool ZipWriter::ZipOpenNewFileInZip(zipFile zip_file, const std::string &strPath, const EntryPolicy &policy)
 {
-    DUMPER_HILOGD(MODULE_COMMON, "ZipOpenNewFileInZip enter|strPath=[%{public}s]", strPath.c_str());
+    DUMPER_HILOGD(MODULE_COMMON, "ZipOpenNewFileInZip enter|strPath=[%{public}s], method=%{public}d, level=%{public}d",
+        strPath.c_str(), policy.method, policy.level);
 
     zip_fileinfo fileInfo = {};
     SetTimeToZipFileInfo(fileInfo);
 
     int res = zipOpenNewFileInZip4(zip_file, strPath.c_str(), &fileInfo,
-        nullptr, 0u, nullptr, 0u, nullptr, Z_DEFLATED, Z_DEFAULT_COMPRESSION,
+        nullptr, 0u, nullptr, 0u, nullptr, policy.method, policy.level,
         0, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY, nullptr, 0, 0, LANGUAGE_ENCODING_FLAG);
 
     bool ret = (res == ZIP_OK);
@@ -170,48 +424,11 @@ bool ZipWriter::ZipOpenNewFileInZip(zipFile zip_file, const std::string &strPath
     return ret;
 }
 
-bool ZipWriter::AddFileContentToZip(zipFile zip_file, std::string &file_path)
-{
-    DUMPER_HILOGD(MODULE_COMMON, "AddFileContentToZip enter|file_path=[%{public}s]", file_path.c_str());
-
-    if (!DumpUtils::PathIsValid(file_path)) {
-        DUMPER_HILOGE(MODULE_COMMON, "AddFileContentToZip leave|false, PathIsValid");
-        return false;
-    }
-
-    auto fp = fopen(file_path.c_str(), "rb");
-    if (fp == nullptr) {
-        DUMPER_HILOGE(MODULE_COMMON, "AddFileContentToZip leave|false, fopen");
-        return false;
-    }
-
-    bool ret = true;
-    char buf[ZIP_BUF_SIZE];
-    while (!feof(fp)) {
-        size_t readSum = fread(buf, 1, ZIP_BUF_SIZE, fp);
-        if (readSum < 1) {
-            continue;
-        }
-
-        if (zipWriteInFileInZip(zip_file, buf, readSum) != ZIP_OK) {
-            DUMPER_HILOGE(MODULE_COMMON, "AddFileContentToZip error|could not write data to zip");
-            ret = false;
-            break;
-        }
-    }
-
-    (void)fclose(fp);
-    fp = nullptr;
-
-    DUMPER_HILOGD(MODULE_COMMON, "AddFileContentToZip leave|ret=%{public}d", ret);
-    return ret;
-}
-
-bool ZipWriter::OpenNewFileEntry(zipFile zip_file, std::string &path)
+bool ZipWriter::OpenNewFileEntry(zipFile zip_file, std::string &path, const EntryPolicy &policy)
 {
     DUMPER_HILOGD(MODULE_COMMON, "OpenNewFileEntry enter|path=[%{public}s]", path.c_str());
 
-    bool ret = ZipOpenNewFileInZip(zip_file, path);
+    bool ret = ZipOpenNewFileInZip(zip_file, path, policy);
 
     DUMPER_HILOGD(MODULE_COMMON, "OpenNewFileEntry leave|ret=%{public}d", ret);
     return ret;
@@ -227,26 +444,5 @@ bool ZipWriter::CloseNewFileEntry(zipFile zip_file)
     DUMPER_HILOGD(MODULE_COMMON, "CloseNewFileEntry leave|ret=%{public}d, res=%{public}d", ret, res);
     return ret;
 }
-
-bool ZipWriter::AddFileEntryToZip(zipFile zip_file, std::string &relativePath, std::string &absolutePath)
-{
-    DUMPER_HILOGD(MODULE_COMMON, "AddFileEntryToZip enter|relativePath=[%{public}s], absolutePath=[%{public}s]",
-        relativePath.c_str(), absolutePath.c_str());
-
-    if (!OpenNewFileEntry(zip_file, relativePath)) {
-        DUMPER_HILOGE(MODULE_COMMON, "AddFileEntryToZip leave|false, open");
-        return false;
-    }
-
-    bool ret = AddFileContentToZip(zip_file, absolutePath);
-
-    if (!CloseNewFileEntry(zip_file)) {
-        DUMPER_HILOGE(MODULE_COMMON, "AddFileEntryToZip leave|false, close");
-        return false;
-    }
-
-    DUMPER_HILOGD(MODULE_COMMON, "AddFileEntryToZip leave|ret=%{public}d", ret);
-    return ret;
-}
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -23,7 +23,7 @@
 namespace OHOS {
 namespace HiviewDFX {
 
-int64_t ZipFileCleaner::GetDirTotalSize(const std::string &dirPath, std::vector<FileInfo>& files)
+int64_t ZipFileCleaner::GetDirTotalSize(const std::string &dirPath, std::vector<FileInfo>& files, bool isTrace)
 {
     if (!DumpUtils::DirectoryExists(dirPath)) {
         DUMPER_HILOGE(MODULE_COMMON, "Directory not exists: %{public}s", dirPath.c_str());
@@ -42,7 +42,8 @@ int64_t ZipFileCleaner::GetDirTotalSize(const std::string &dirPath, std::vector<
             "str=[%{public}s], filePath=[%{public}s], fileName=[%{public}s], fileExt=[%{public}s]",
             str.c_str(), filePath.c_str(), fileName.c_str(), fileExt.c_str());
 
-        if ((filePath != dirPath) || (fileExt != ZIP_FILEEXT)) {
+        bool matched = isTrace ? IsTraceFile(fileName) : (fileExt == ZIP_FILEEXT);
+        if ((filePath != dirPath) || !matched) {
             DUMPER_HILOGD(MODULE_COMMON, "EraseLogs debug|skip, str=[%{public}s]", str.c_str());
             continue;
         }
@@ -64,7 +65,7 @@ int64_t ZipFileCleaner::GetDirTotalSize(const std::string &dirPath, std::vector<
     return totalSize;
 }
 
-bool ZipFileCleaner::DeleteOldestFiles(int64_t totalSize, std::vector<FileInfo>& files)
+bool ZipFileCleaner::DeleteOldestFiles(int64_t totalSize, std::vector<FileInfo>& files, bool isTrace)
 {
     if (files.empty()) {
         return true;
@@ -75,18 +76,20 @@ bool ZipFileCleaner::DeleteOldestFiles(int64_t totalSize, std::vector<FileInfo>&
             return a.name < b.name;
         });
 
+    int64_t targetSize = isTrace ? TRACE_TARGET_SIZE : ZIP_TARGET_SIZE;
+    int32_t maxCount = isTrace ? TRACEFILE_MAX : LOGFILE_MAX;
     int64_t currentSize = totalSize;
     int32_t fileCount = static_cast<int32_t>(files.size());
     int deletedCount = 0;
     for (const auto& file : files) {
-        if (currentSize <= ZIP_TARGET_SIZE && fileCount <= LOGFILE_MAX) {
+        if (currentSize <= targetSize && fileCount <= maxCount) {
             break;
         }
         if (RemoveFile(file.path)) {
             currentSize -= file.size;
             fileCount--;
             deletedCount++;
-            DUMPER_HILOGI(MODULE_COMMON, "Deleted old zip file: %{public}s, size: %{public}lld",
+            DUMPER_HILOGI(MODULE_COMMON, "Deleted old file: %{public}s, size: %{public}lld",
                 file.path.c_str(), (long long)file.size);
         } else {
             DUMPER_HILOGE(MODULE_COMMON, "Failed to delete file: %{public}s, errno: %{public}d",
@@ -101,20 +104,35 @@ bool ZipFileCleaner::DeleteOldestFiles(int64_t totalSize, std::vector<FileInfo>&
 
 bool ZipFileCleaner::CleanOldFiles(const std::string &dirPath)
 {
-    DUMPER_HILOGD(MODULE_COMMON, "Start cleaning old zip files in: %{public}s", dirPath.c_str());
+    bool zipCleaned = CleanFiles(dirPath, false);
+    bool traceCleaned = CleanFiles(dirPath, true);
+    return zipCleaned && traceCleaned;
+}
+
+bool ZipFileCleaner::CleanFiles(const std::string &dirPath, bool isTrace)
+{
+    const char *kind = isTrace ? "trace" : "zip";
+    DUMPER_HILOGD(MODULE_COMMON, "Start cleaning old %{public}s files in: %{public}s", kind, dirPath.c_str());
 
     std::vector<FileInfo> files;
-    int64_t totalSize = GetDirTotalSize(dirPath, files);
+    int64_t totalSize = GetDirTotalSize(dirPath, files, isTrace);
+    int64_t maxSize = isTrace ? TRACE_MAX_SIZE : ZIP_MAX_SIZE;
+    size_t maxCount = static_cast<size_t>(isTrace ? TRACEFILE_MAX : LOGFILE_MAX);
 
-    DUMPER_HILOGD(MODULE_COMMON, "Total zip files size: %{public}lldMB, max size: %{public}lldMB",
-        (long long)(totalSize / BYTES_PER_MB),
-        (long long)(ZIP_MAX_SIZE / BYTES_PER_MB));
+    DUMPER_HILOGD(MODULE_COMMON, "Total %{public}s files size: %{public}lldMB, max size: %{public}lldMB",
+        kind, (long long)(totalSize / BYTES_PER_MB), (long long)(maxSize / BYTES_PER_MB));
 
-    if (totalSize <= ZIP_MAX_SIZE && files.size() <= LOGFILE_MAX) {
+    if (totalSize <= maxSize && files.size() <= maxCount) {
         DUMPER_HILOGD(MODULE_COMMON, "No need to clean, total size is under threshold");
         return true;
     }
-    return DeleteOldestFiles(totalSize, files);
+    return DeleteOldestFiles(totalSize, files, isTrace);
+}
+
+bool ZipFileCleaner::IsTraceFile(const std::string &fileName)
+{
+    return (fileName.size() > TRACE_SUFFIX.size()) &&
+        (fileName.compare(fileName.size() - TRACE_SUFFIX.size(), TRACE_SUFFIX.size(), TRACE_SUFFIX) == 0);
 }
 
 } // namespace HiviewDFX
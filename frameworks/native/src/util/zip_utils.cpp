@@ -15,14 +15,17 @@
 #include "util/zip_utils.h"
 #include "directory_ex.h"
 #include "dump_utils.h"
+#include "util/trace_recorder.h"
 #include "util/zip/zip_writer.h"
 #include "hilog_wrapper.h"
 namespace OHOS {
 namespace HiviewDFX {
-bool ZipUtils::ZipFolder(const std::string &srcPath, const std::string &dstFile, const ZipTickNotify notify)
+bool ZipUtils::ZipFolder(const std::string &srcPath, const std::string &dstFile, const ZipTickNotify notify,
+    const std::vector<std::pair<int, std::string>> &fdItems)
 {
     DUMPER_HILOGD(MODULE_COMMON, "enter|srcPath=[%{public}s], dstFile=[%{public}s]",
         srcPath.c_str(), dstFile.c_str());
+    TraceSpan span("zip", "ZipFolder", &dstFile);
 
     std::string srcFolder = IncludeTrailingPathDelimiter(srcPath);
 
@@ -36,7 +39,10 @@ bool ZipUtils::ZipFolder(const std::string &srcPath, const std::string &dstFile,
     DUMPER_HILOGD(MODULE_COMMON, "debug|GetDirFiles, srcFolder=[%{public}s]", srcFolder.c_str());
 
     std::vector<std::string> allFiles;
-    GetDirFiles(srcFolder, allFiles);
+    {
+        TraceSpan scanSpan("zip", "ScanFolder");
+        GetDirFiles(srcFolder, allFiles);
+    }
 
     if ((notify != nullptr) && (notify(UNSET_PROGRESS, UNSET_PROGRESS))) {
         DUMPER_HILOGE(MODULE_COMMON, "leave|notify");
@@ -64,7 +70,7 @@ bool ZipUtils::ZipFolder(const std::string &srcPath, const std::string &dstFile,
 
     ZipWriter zipWriter(dstFile);
     zipWriter.Open();
-    bool ret = zipWriter.Write(zipItems, notify);
+    bool ret = zipWriter.Write(zipItems, fdItems, notify);
 
     DUMPER_HILOGD(MODULE_COMMON, "leave|ret=%{public}d", ret);
     return ret;
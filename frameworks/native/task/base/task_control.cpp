@@ -26,6 +26,7 @@
 #include "hilog_wrapper.h"
 #include "task/base/task_register.h"
 #include "task/base/task_enable_config.h"
+#include "util/trace_recorder.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -95,6 +96,7 @@ DumpStatus TaskControl::HandleTaskRetry(TaskId taskId, const RegTaskInfo& taskIn
                                         const DumpContext& dumpContext)
 {
     DUMPER_HILOGW(MODULE_COMMON, "Task %{public}s failed first time, retrying...", taskInfo.taskName.c_str());
+    TraceSpan span("task", "TaskRetry", &taskInfo.taskName);
     
     auto task = taskInfo.creator();
     if (task == nullptr) {
@@ -272,13 +274,17 @@ void TaskControl::BuildTaskTopo(TaskId rootTaskId, TaskCollection& taskTopo)
 DumpStatus TaskControl::ExecuteTaskInner(DataInventory& dataInventory, TaskCollection& tasks,
                                          const DumpContext& dumpContext)
 {
+    TraceSpan span("task", "ExecuteTask");
     std::vector<LevelStat> allLevelStats;
     auto taskCopy = tasks;
     auto runnableTasks = SelectRunnableTasks(tasks);
     while (!runnableTasks.empty()) {
         std::vector<TaskStatistcs> stat(runnableTasks.size());
         SubmitRunnableTasks(runnableTasks, dataInventory, dumpContext, stat);
-        ffrt::wait();
+        {
+            TraceSpan waitSpan("task", "ffrt::wait");
+            ffrt::wait();
+        }
         FillStatistcsDependence(taskCopy, stat);
         auto ret = GetTaskResult(std::move(stat), allLevelStats);
         if (!ret) {
@@ -312,6 +318,7 @@ void TaskControl::SubmitRunnableTasks(TaskCollection& tasks, DataInventory& data
     for (auto& taskInfo : tasks) {
         ffrt::submit([&taskInfo, &dataInventory, dumpContext, concurrentIndex, &stat, this]() {
             auto startTime = std::chrono::steady_clock::now();
+            TraceSpan span("task", "Task", &taskInfo.second.taskName);
             auto dumpStatus = ExecuteSingleTask(taskInfo.first, taskInfo.second, dataInventory, dumpContext);
             
             stat[concurrentIndex].dumpStatus = dumpStatus;
@@ -26,7 +26,6 @@ class IoTopInfoTask : public Task {
 public:
     IoTopInfoTask() = default;
     ~IoTopInfoTask() override = default;
-    void FilterControlChar(std::string &str);
 
 private:
     DumpStatus TaskEntry(DataInventory& dataInventory, const DumpContext& dumpContext) override;
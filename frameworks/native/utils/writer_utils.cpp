@@ -21,6 +21,8 @@
 
 #include "file_ex.h"
 #include "hilog_wrapper.h"
+#include "util/command_runner.h"
+#include "util/trace_recorder.h"
 
 
 namespace OHOS {
@@ -36,6 +38,7 @@ void WriteStringIntoFd(const std::string& str, int fd)
         DUMPER_HILOGW(MODULE_COMMON, "str is empty");
         return;
     }
+    TraceSpan span("output", "WriteStringIntoFd");
     std::string outputStr = str;
     if (outputStr.back() != '\n') {
         outputStr += '\n';
@@ -82,25 +85,10 @@ bool HandleStringFromFile(const std::string& path, const DataHandler& func)
 
 bool HandleStringFromCommand(const std::string& command, const DataHandler& func)
 {
-    auto pipe = std::unique_ptr<FILE, decltype(&pclose)>{popen(command.c_str(), "r"), pclose};
-    if (pipe == nullptr) {
-        DUMPER_HILOGE(MODULE_COMMON, "popen failed, errno=%{public}d, command=%{public}s", errno, command.c_str());
+    if (!CommandRunner::Run(command, func, true)) {
+        DUMPER_HILOGE(MODULE_COMMON, "run command failed, command=%{public}s", command.c_str());
         return false;
     }
-    char *lineBuf = nullptr;
-    ssize_t lineLen;
-    size_t lineAlloc = 0;
-    while ((lineLen = getline(&lineBuf, &lineAlloc, pipe.get())) > 0) {
-        lineBuf[lineLen] = '\0';
-        const std::string content = lineBuf;
-        if (!func(content)) {
-            break;
-        }
-    }
-    if (lineBuf != nullptr) {
-        free(lineBuf);
-        lineBuf = nullptr;
-    }
     return true;
 }
 
@@ -13,6 +13,10 @@
 * limitations under the License.
 */
 #include "include/dump_usage.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
 #include "dump_manager_cpu_client.h"
 #include "executor/memory/parse/parse_smaps_rollup_info.h"
 #include "executor/memory/memory_util.h"
@@ -21,6 +25,29 @@
 using namespace std;
 namespace OHOS {
 namespace HiviewDFX {
+namespace {
+constexpr size_t MAX_USAGE_THREADS = 4;
+
+void FillMemUsageRecord(const MemInfoData::MemInfo &info, uint32_t fieldMask, DumpUsage::MemUsageRecord &record)
+{
+    if ((fieldMask & DumpUsage::USAGE_FIELD_PSS) != 0) {
+        record.pss = info.pss + info.swapPss;
+    }
+    if ((fieldMask & DumpUsage::USAGE_FIELD_PRIVATE_DIRTY) != 0) {
+        record.privateDirty = info.privateDirty;
+    }
+    if ((fieldMask & DumpUsage::USAGE_FIELD_SHARED_DIRTY) != 0) {
+        record.sharedDirty = info.sharedDirty;
+    }
+    if ((fieldMask & DumpUsage::USAGE_FIELD_RSS) != 0) {
+        record.rss = info.rss;
+    }
+    if ((fieldMask & DumpUsage::USAGE_FIELD_SWAP) != 0) {
+        record.swap = info.swap;
+    }
+}
+} // namespace
+
 DumpUsage::DumpUsage()
 {
 }
@@ -54,6 +81,48 @@ uint64_t DumpUsage::GetSharedDirty(const int &pid)
     return GetMemInfo(pid, info) ? info.sharedDirty : 0;
 }
 
+size_t DumpUsage::GetMemUsages(const int pids[], size_t pidCount, uint32_t fieldMask, MemUsageRecord records[])
+{
+    if ((pids == nullptr) || (records == nullptr) || (pidCount == 0)) {
+        return 0;
+    }
+    std::atomic<size_t> next {0};
+    std::atomic<size_t> readCount {0};
+    auto worker = [&]() {
+        for (size_t index = next++; index < pidCount; index = next++) {
+            MemUsageRecord &record = records[index];
+            record = MemUsageRecord();
+            record.pid = pids[index];
+            MemInfoData::MemInfo info;
+            if (!GetMemInfo(record.pid, info)) {
+                continue;
+            }
+            FillMemUsageRecord(info, fieldMask, record);
+            record.success = true;
+            readCount++;
+        }
+    };
+    size_t threadNum = 1;
+    if (pidCount >= PARALLEL_MIN_PIDS) {
+        threadNum = std::min(pidCount / PARALLEL_MIN_PIDS + 1, MAX_USAGE_THREADS);
+        size_t hardwareThreads = std::thread::hardware_concurrency();
+        if (hardwareThreads > 0) {
+            threadNum = std::min(threadNum, hardwareThreads);
+        }
+    }
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadNum; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    DUMPER_HILOGD(MODULE_COMMON, "GetMemUsages end, pids:%{public}zu, read:%{public}zu, threads:%{public}zu",
+        pidCount, readCount.load(), threadNum);
+    return readCount.load();
+}
+
 double DumpUsage::GetCpuUsage(const int &pid)
 {
     double cpuUsage = 0.00;
@@ -14,6 +14,8 @@
  */
 #ifndef DUMP_USAGE_H
 #define DUMP_USAGE_H
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include "executor/memory/parse/meminfo_data.h"
 namespace OHOS {
@@ -23,6 +25,29 @@ public:
     DumpUsage();
     ~DumpUsage();
 
+    enum UsageField : uint32_t {
+        USAGE_FIELD_PSS = 1 << 0, // Pss with SwapPss, the same as GetPss
+        USAGE_FIELD_PRIVATE_DIRTY = 1 << 1,
+        USAGE_FIELD_SHARED_DIRTY = 1 << 2,
+        USAGE_FIELD_RSS = 1 << 3,
+        USAGE_FIELD_SWAP = 1 << 4,
+        USAGE_FIELD_ALL = 0xFFFFFFFF,
+    };
+    struct MemUsageRecord {
+        int pid = 0;
+        bool success = false; // false if the smaps_rollup of pid can not be read, the values stay 0
+        uint64_t pss = 0;
+        uint64_t privateDirty = 0;
+        uint64_t sharedDirty = 0;
+        uint64_t rss = 0;
+        uint64_t swap = 0;
+    };
+    static constexpr size_t PARALLEL_MIN_PIDS = 32;
+
+    // reads smaps_rollup once for each pid and fills the fields in fieldMask into records, which has pidCount
+    // entries owned by the caller. large batches are read in parallel. returns the number of pids read.
+    size_t GetMemUsages(const int pids[], size_t pidCount, uint32_t fieldMask, MemUsageRecord records[]);
+
     bool GetMemInfo(const int &pid, MemInfoData::MemInfo &info);
     uint64_t GetPss(const int &pid);
     uint64_t GetPrivateDirty(const int &pid);
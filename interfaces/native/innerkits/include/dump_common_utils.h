@@ -14,6 +14,7 @@
  */
 #ifndef HIDUMPER_ZIDL_COMMON_UTILS_H
 #define HIDUMPER_ZIDL_COMMON_UTILS_H
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "common/dumper_constant.h"
@@ -44,8 +45,14 @@ public:
     // get subDir information by pid.
     static bool IsDirectory(const std::string &path);
     static std::vector<std::string> GetSubDir(const std::string &path, bool digit);
+    // read /proc and /sys under root instead, see FileUtils::SetProcRoot.
+    static void SetProcRoot(const std::string &root);
     // get all pids in device.
     static std::vector<int32_t> GetAllPids();
+    // get all thread ids of pid.
+    static std::vector<int32_t> GetAllTids(int32_t pid);
+    // get the numeric sub directories of folder, such as /proc or /proc/pid/task, in ascending order.
+    static bool GetIdsInFolder(const std::string &folder, std::vector<int32_t> &ids);
     // get all process information in device.
     static bool GetPidInfos(std::vector<PidInfo> &infos, bool all = false);
     // get process name by pid.
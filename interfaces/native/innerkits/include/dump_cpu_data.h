@@ -14,6 +14,7 @@
  */
 #ifndef DUMP_CPU_DATA_H
 #define DUMP_CPU_DATA_H
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "parcel.h"
@@ -37,9 +38,23 @@ namespace HiviewDFX {
         } \
     } while (0)
 
+// Fixed-size per-process record, the name lives in DumpCpuData::commPool_.
+struct CpuProcRecord {
+    int32_t pid = 0;
+    uint32_t commOffset = 0;
+    uint32_t commLength = 0;
+    uint32_t reserved = 0;
+    uint64_t minflt = 0;
+    uint64_t majflt = 0;
+    double totalUsage = 0;
+    double userSpaceUsage = 0;
+    double sysSpaceUsage = 0;
+};
+
 class DumpCpuData : public Parcelable {
 public:
     using StringCpuMatrix = std::vector<std::vector<std::string>>;
+    static constexpr uint32_t DEFAULT_WINDOW_SEC = 1;
     DumpCpuData();
     DumpCpuData(std::string& startTime, std::string& endTime, int cpuUsagePid, StringCpuMatrix dumpCPUDatas);
     ~DumpCpuData();
@@ -48,11 +63,20 @@ public:
     bool ReadFromParcel(Parcel &parcel);
     bool WriteStringMatrix(const std::vector<std::vector<std::string>> &martrixVec, Parcel &data) const;
     bool ReadStringMatrix(std::vector<std::vector<std::string>> &martrixVec, Parcel &data);
+    bool WriteProcRecords(Parcel &data) const;
+    bool ReadProcRecords(Parcel &data);
+    void AddProcRecord(CpuProcRecord record, const std::string &comm);
+    // Append the rows of the process table, formatted on the caller side, to lines. the header is in dumpCPUDatas_.
+    void FormatProcRecords(std::vector<std::vector<std::string>> &lines) const;
 public:
     std::string startTime_;
     std::string endTime_;
     int cpuUsagePid_ = -1;
+    // usage is averaged over the last windowSec_ seconds when the service has background samples.
+    uint32_t windowSec_ = DEFAULT_WINDOW_SEC;
     StringCpuMatrix dumpCPUDatas_;
+    std::vector<CpuProcRecord> procRecords_;
+    std::string commPool_;
 private:
     friend DumpDelayedSpSingleton<DumpCpuData>;
 };
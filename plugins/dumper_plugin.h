@@ -18,8 +18,10 @@
 
 #include <dlfcn.h>
 #include <cstdio>
+#include <cstdint>
 #include <cstdlib>
 #include <string>
+#include <vector>
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -35,11 +37,32 @@ const char CREATE_PLUGIN[] = "OnCreatePlugin";
 const int PLUGIN_ENABLE = 0;
 const int PLUGIN_DISABLE = -1;
 
+// optional, exported by plugins with the batched entry point, it returns a PluginBatch.
+// it is looked up on its own, so the Plugin object and its version keep their meaning for every plugin.
+const char CREATE_PLUGIN_BATCH[] = "OnCreatePluginBatch";
+// PluginBatch::abiVersion the host understands, a plugin built for another one is not used.
+const uint32_t PLUGIN_BATCH_ABI_VERSION = 1;
+
+const int PLUGIN_RECORD_LABEL_LEN = 32;
+
+// cmdType of the batched entry point for the graphics memory of processes, values are in kB.
+const uint32_t PLUGIN_BATCH_GRAPHICS_MEMORY = 1;
+const uint32_t PLUGIN_RECORD_GL = 0;
+const uint32_t PLUGIN_RECORD_GRAPH = 1;
+
 struct DumpMeminfo {
     int pid = 0;
     int size = 0;
 };
 
+// one value of one process, reported by the batched entry point.
+struct DumpPluginRecord {
+    int pid = 0;
+    uint32_t type = 0;
+    uint64_t value = 0;
+    char label[PLUGIN_RECORD_LABEL_LEN] = {0};
+};
+
 struct Plugin {
     uint32_t version;
     const char *pluginName;
@@ -47,10 +70,20 @@ struct Plugin {
     std::string (*collectGpumem)(uint32_t pid, uint32_t cmdType, uint32_t infoType, uint32_t dfxLimit);
 };
 
+struct PluginBatch {
+    uint32_t abiVersion;
+    // collects cmdType data of all pids in one call into records, at most capacity of them.
+    // returns the number of records the data needs, the host calls again with a larger buffer when it is
+    // over capacity, or -1 on failure.
+    int (*collectBatch)(const int pids[], int pidCount, uint32_t cmdType, DumpPluginRecord records[], int capacity);
+};
+
 int32_t LoadPlugin(void);
 void UnloadPlugin(void);
 bool QueryMemInfo(DumpMeminfo infos[], int& realSize);
 std::string CollectGpumem(uint32_t pid, uint32_t cmdType, uint32_t infoType, uint32_t dfxLimit);
+// false if no plugin is loaded or it has no batched entry point, then callers fall back to the per-pid calls.
+bool CollectBatch(const std::vector<int>& pids, uint32_t cmdType, std::vector<DumpPluginRecord>& records);
 
 } // namespace HiviewDFX
 } // namespace OHOS
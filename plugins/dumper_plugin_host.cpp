@@ -20,11 +20,44 @@
 namespace OHOS {
 namespace HiviewDFX {
 using OnCreatePluginFuncPtr = Plugin* (*)();
+using OnCreatePluginBatchFuncPtr = PluginBatch* (*)();
+static constexpr size_t RECORDS_PER_PID = 4;
 static std::mutex g_pluginMutex;
 static void *g_handle = nullptr;
-static OnCreatePluginFuncPtr g_createPluginFn = nullptr;
+// created once when the library is loaded, plugins keep their setup until it is unloaded.
+static Plugin *g_plugin = nullptr;
+static PluginBatch *g_pluginBatch = nullptr;
 static int g_refCount = 0;
 
+static Plugin *GetPlugin()
+{
+    std::lock_guard<std::mutex> lock(g_pluginMutex);
+    return g_plugin;
+}
+
+static PluginBatch *GetPluginBatch()
+{
+    std::lock_guard<std::mutex> lock(g_pluginMutex);
+    return g_pluginBatch;
+}
+
+// the batched entry point is optional, a plugin without it or built for another abi keeps the per-pid calls.
+static PluginBatch *CreatePluginBatch(void *handle)
+{
+    union { void* raw; OnCreatePluginBatchFuncPtr fn; } u;
+    u.raw = dlsym(handle, CREATE_PLUGIN_BATCH);
+    if (u.raw == nullptr) {
+        return nullptr;
+    }
+    PluginBatch *batch = u.fn();
+    if (batch == nullptr || batch->abiVersion != PLUGIN_BATCH_ABI_VERSION) {
+        DUMPER_HILOGE(MODULE_SERVICE, "batch plugin abi %u unsupported.",
+            (batch == nullptr) ? 0 : batch->abiVersion);
+        return nullptr;
+    }
+    return batch;
+}
+
 int32_t LoadPlugin()
 {
     std::lock_guard<std::mutex> lock(g_pluginMutex);
@@ -52,9 +85,17 @@ int32_t LoadPlugin()
 
     union { void* raw; OnCreatePluginFuncPtr fn; } u;
     u.raw = sym;
-    g_createPluginFn = u.fn;
+    g_plugin = u.fn();
+    if (g_plugin == nullptr) {
+        DUMPER_HILOGE(MODULE_SERVICE, "create plugin failed.");
+        dlclose(g_handle);
+        g_handle = nullptr;
+        return PLUGIN_DISABLE;
+    }
+    g_pluginBatch = CreatePluginBatch(g_handle);
     g_refCount = 1;
-    DUMPER_HILOGI(MODULE_SERVICE, "load plugin success.");
+    DUMPER_HILOGI(MODULE_SERVICE, "load plugin success, version=%u, batch=%d.", g_plugin->version,
+        g_pluginBatch != nullptr);
     return PLUGIN_ENABLE;
 }
 
@@ -64,9 +105,10 @@ void UnloadPlugin()
     if (g_refCount > 0) {
         g_refCount--;
         if (g_refCount == 0) {
+            g_plugin = nullptr;
+            g_pluginBatch = nullptr;
             dlclose(g_handle);
             g_handle = nullptr;
-            g_createPluginFn = nullptr;
             DUMPER_HILOGI(MODULE_SERVICE, "unload plugin success.");
         } else {
             DUMPER_HILOGI(MODULE_SERVICE, "plugin still in use, refCount=%d", g_refCount);
@@ -77,16 +119,15 @@ void UnloadPlugin()
 bool QueryMemInfo(DumpMeminfo infos[], int& realSize)
 {
     std::lock_guard<std::mutex> lock(g_pluginMutex);
-    if (g_createPluginFn == nullptr) {
+    if (g_plugin == nullptr) {
         DUMPER_HILOGE(MODULE_SERVICE, "QueryMemInfo plugin not loaded.");
         realSize = 0;
         return false;
     }
 
     DUMPER_HILOGI(MODULE_SERVICE, "QueryMemInfo get plugin.");
-    Plugin* plugin = g_createPluginFn();
-    if (plugin != nullptr && plugin->queryMemInfo != nullptr) {
-        plugin->queryMemInfo(infos, realSize);
+    if (g_plugin->queryMemInfo != nullptr) {
+        g_plugin->queryMemInfo(infos, realSize);
         return true;
     } else {
         DUMPER_HILOGE(MODULE_SERVICE, "QueryMemInfo default do nothing.");
@@ -97,11 +138,8 @@ bool QueryMemInfo(DumpMeminfo infos[], int& realSize)
 
 std::string CollectGpumem(uint32_t pid, uint32_t cmdType, uint32_t infoType, uint32_t dfxLimit)
 {
-    Plugin* plugin = nullptr;
-    if (g_createPluginFn != nullptr) {
-        DUMPER_HILOGI(MODULE_SERVICE, "CollectGpumem get plugin.");
-        plugin = g_createPluginFn();
-    }
+    // callers hold a reference from LoadPlugin, so the plugin stays loaded during the call.
+    Plugin* plugin = GetPlugin();
     if (plugin != nullptr && plugin->collectGpumem != nullptr) {
         std::string tempResult = plugin->collectGpumem(pid, cmdType, infoType, dfxLimit);
         return tempResult;
@@ -110,5 +148,29 @@ std::string CollectGpumem(uint32_t pid, uint32_t cmdType, uint32_t infoType, uin
         return "";
     }
 }
+
+bool CollectBatch(const std::vector<int>& pids, uint32_t cmdType, std::vector<DumpPluginRecord>& records)
+{
+    records.clear();
+    PluginBatch* batchPlugin = GetPluginBatch();
+    if (batchPlugin == nullptr || batchPlugin->collectBatch == nullptr) {
+        return false;
+    }
+    records.resize(pids.size() * RECORDS_PER_PID);
+    int count = batchPlugin->collectBatch(pids.data(), static_cast<int>(pids.size()), cmdType,
+        records.data(), static_cast<int>(records.size()));
+    if (count > static_cast<int>(records.size())) {
+        records.resize(count);
+        count = batchPlugin->collectBatch(pids.data(), static_cast<int>(pids.size()), cmdType,
+            records.data(), static_cast<int>(records.size()));
+    }
+    if (count < 0 || count > static_cast<int>(records.size())) {
+        DUMPER_HILOGE(MODULE_SERVICE, "CollectBatch failed, count=%d", count);
+        records.clear();
+        return false;
+    }
+    records.resize(count);
+    return true;
+}
 } // namespace HiviewDFX
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_SERVICES_CPU_USAGE_SAMPLER_H
+#define HIDUMPER_SERVICES_CPU_USAGE_SAMPLER_H
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace HiviewDFX {
+struct CPUInfo {
+    double userUsage; // user space usage
+    double niceUsage; // adjust process priority cpu usage
+    double systemUsage; // kernel space cpu usage
+    double idleUsage; // idle cpu usage
+    double ioWaitUsage; // io wait cpu usage
+    double irqUsage; // hard interrupt cpu usage
+    double softIrqUsage; // soft interrupt cpu usage
+};
+
+struct ProcInfo {
+    double userSpaceUsage;
+    double sysSpaceUsage;
+    double totalUsage;
+    std::string pid;
+    std::string comm;
+    std::string minflt;
+    std::string majflt;
+};
+
+struct CpuUsageSample {
+    uint64_t startTime = 0; // ms
+    uint64_t endTime = 0; // ms
+    double avgLoad1 = 0;
+    double avgLoad5 = 0;
+    double avgLoad15 = 0;
+    CPUInfo cpuInfo = {};
+    std::vector<ProcInfo> procInfos;
+};
+
+/**
+ * Samples system and per-process cpu usage on a background thread into a ring buffer,
+ * so a request can be answered from the samples that cover its window without collecting again.
+ * The thread stops by itself when no request has been seen for IDLE_STOP_MS.
+ */
+class CpuUsageSampler {
+public:
+    static constexpr uint32_t DEFAULT_PERIOD_MS = 1000;
+    static constexpr uint32_t MAX_WINDOW_SEC = 60;
+    static constexpr uint32_t IDLE_STOP_MS = 5 * 60 * 1000;
+    static constexpr uint32_t STALE_PERIODS = 2; // the newest sample may be this many periods old
+
+    explicit CpuUsageSampler(uint32_t periodMs = DEFAULT_PERIOD_MS);
+    ~CpuUsageSampler();
+    CpuUsageSampler(const CpuUsageSampler&) = delete;
+    CpuUsageSampler& operator=(const CpuUsageSampler&) = delete;
+
+    // start the thread if needed and mark the sampler as in use.
+    void Start();
+    void Stop();
+    // merge the samples ending within the last windowSec seconds before now,
+    // false if there is no sample or the newest one is older than STALE_PERIODS periods.
+    bool GetWindow(uint32_t windowSec, CpuUsageSample& result) const;
+    void AddSample(const std::shared_ptr<const CpuUsageSample>& sample);
+
+private:
+    void Run();
+    bool IsIdle() const;
+
+private:
+    uint32_t periodMs_;
+    size_t capacity_;
+    mutable std::shared_mutex ringMutex_;
+    std::vector<std::shared_ptr<const CpuUsageSample>> ring_;
+    size_t next_ = 0;
+    std::mutex threadMutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool running_ = false;
+    std::atomic<int64_t> lastUseMs_{0};
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_SERVICES_CPU_USAGE_SAMPLER_H
@@ -14,7 +14,9 @@
  */
 #ifndef HIDUMPER_SERVICES_DUMP_LOG_MANAGER_H
 #define HIDUMPER_SERVICES_DUMP_LOG_MANAGER_H
+#include <memory>
 #include <string>
+#include "util/dump_staging_area.h"
 namespace OHOS {
 namespace HiviewDFX {
 class DumpLogManager {
@@ -27,6 +29,8 @@ public:
     static void EraseLogs();
     static std::string CreateTmpFolder(uint32_t id);
     static bool EraseTmpFolder(uint32_t id);
+    // staging area of a zip request, folder is the one returned by CreateTmpFolder.
+    static std::shared_ptr<DumpStagingArea> CreateStagingArea(const std::string &folder);
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -15,6 +15,7 @@
 #ifndef HIDUMPER_SERVICES_CPU_MANAGER_SERVICE_H
 #define HIDUMPER_SERVICES_CPU_MANAGER_SERVICE_H
 #include <map>
+#include <memory>
 #include <mutex>
 #include <vector>
 #include <system_ability.h>
@@ -23,29 +24,11 @@
 #include "dump_common_utils.h"
 #include "dump_cpu_data.h"
 #include "common.h"
+#include "cpu_usage_sampler.h"
 #include "hidumper_cpu_service_stub.h"
 
 namespace OHOS {
 namespace HiviewDFX {
-struct CPUInfo {
-    double userUsage; // user space usage
-    double niceUsage; // adjust process priority cpu usage
-    double systemUsage; // kernel space cpu usage
-    double idleUsage; // idle cpu usage
-    double ioWaitUsage; // io wait cpu usage
-    double irqUsage; // hard interrupt cpu usage
-    double softIrqUsage; // soft interrupt cpu usage
-};
-
-struct ProcInfo {
-    double userSpaceUsage;
-    double sysSpaceUsage;
-    double totalUsage;
-    std::string pid;
-    std::string comm;
-    std::string minflt;
-    std::string majflt;
-};
 class DumpCpuData;
 class DumpManagerCpuService final : public SystemAbility, public HidumperCpuServiceStub {
     DECLARE_SYSTEM_ABILITY(DumpManagerCpuService)
@@ -67,12 +50,17 @@ private:
     friend DumpDelayedSpSingleton<DumpManagerCpuService>;
 private:
     DumpStatus ReadLoadAvgInfo(std::string& info);
+    static void FormatLoadAvgInfo(double avgLoad1, double avgLoad5, double avgLoad15, std::string& info);
+    bool DumpFromSampler(DumpCpuData &dumpCpuData);
     void CreateDumpTimeString(const std::string& startTime, const std::string& endTime,
         std::string& timeStr);
     void AddStrLineToDumpInfo(const std::string& strLine);
     void CreateCPUStatString(std::string& str);
+    static void CreateCPUStatString(const CPUInfo& cpuInfo, std::string& str);
     void DumpProcInfo();
+    static void AddProcRecord(const ProcInfo &info, DumpCpuData &dumpCpuData);
     static bool SortProcInfo(std::shared_ptr<ProcInfo> &left, std::shared_ptr<ProcInfo> &right);
+    static bool CompareProcInfo(const ProcInfo &left, const ProcInfo &right);
     bool SubscribeAppStateEvent();
     bool SubscribeCommonEvent();
 
@@ -92,6 +80,8 @@ private:
     std::vector<std::shared_ptr<ProcInfo>> curProcs_;
     int cpuUsagePid_{-1};
     StringMatrix dumpCPUDatas_{nullptr};
+    std::shared_ptr<DumpCpuData> procData_{nullptr};
+    std::unique_ptr<CpuUsageSampler> sampler_{nullptr};
 };
 } // namespace HiviewDFX
 } // namespace OHOS
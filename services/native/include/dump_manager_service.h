@@ -15,7 +15,9 @@
 #ifndef HIDUMPER_SERVICES_DUMP_MANAGER_SERVICE_H
 #define HIDUMPER_SERVICES_DUMP_MANAGER_SERVICE_H
 #include <atomic>
+#include <condition_variable>
 #include <map>
+#include <set>
 #include <vector>
 #include <system_ability.h>
 #include "event_runner.h"
@@ -28,6 +30,7 @@ namespace OHOS {
 namespace HiviewDFX {
 
 class RawParam;
+class OutputFanout;
 #ifdef DUMP_TEST_MODE // for mock test
 using DumpManagerServiceTestMainFunc = std::function<void(int argc, char *argv[],
     const std::shared_ptr<RawParam>& reqCtl)>;
@@ -68,6 +71,8 @@ public:
         return started_;
     }
     void DelayUnloadTask() override;
+    // wakes the requests waiting for a run slot, so a canceled one leaves the queue.
+    void NotifyRequestCanceled();
 #ifdef DUMP_TEST_MODE // for mock test
     void SetTestMainFunc(DumpManagerServiceTestMainFunc testMainFunc);
 #endif // for mock test
@@ -83,6 +88,14 @@ private:
     uint32_t GetRequestId();
     int32_t StartRequest(const std::shared_ptr<RawParam> rawParam);
     void RequestMain(const std::shared_ptr<RawParam> rawParam);
+    static std::string GetRequestFingerprint(const std::vector<std::u16string> &args);
+    static int GetRequestPriority(int argc, char *argv[]);
+    // status is the one the leader finished with, set when true is returned.
+    bool AttachToInflightRequest(const std::string &fingerprint, int outfd, int32_t &status);
+    std::shared_ptr<OutputFanout> LeadInflightRequest(const std::string &fingerprint, int &outfd);
+    void EndInflightRequest(const std::shared_ptr<RawParam> rawParam, int32_t status);
+    bool AcquireRunSlot(const std::shared_ptr<RawParam> rawParam, int priority);
+    void ReleaseRunSlot(int priority);
     bool HasDumpPermission() const;
     uint32_t GetFileDescriptorNums(int32_t pid, std::string requestType) const;
     std::string GetFdLink(const std::string &linkPath) const;
@@ -108,6 +121,16 @@ private:
     std::atomic<bool> blockRequest_ = false;
     uint32_t requestIndex_ {0};
     std::map<uint32_t, std::shared_ptr<RawParam>> requestRawParamMap_;
+    // identical requests in flight, keyed by fingerprint, and the request id leading each of them.
+    std::map<std::string, std::shared_ptr<OutputFanout>> inflightRequests_;
+    std::map<uint32_t, std::string> inflightLeaders_;
+    int followerCount_ {0}; // attached requests, counted against REQUEST_MAX with the ones in requestRawParamMap_
+    // requests waiting for a run slot, ordered by priority then arrival.
+    std::set<std::pair<int, uint64_t>> waitingRequests_;
+    std::condition_variable runSlotCond_;
+    uint64_t waitingSeq_ {0};
+    int runningCount_ {0};
+    int runningLowCount_ {0};
 #ifdef DUMP_TEST_MODE // for mock test
     DumpManagerServiceTestMainFunc testMainFunc_ {nullptr};
 #endif // for mock test
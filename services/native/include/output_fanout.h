@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_SERVICES_OUTPUT_FANOUT_H
+#define HIDUMPER_SERVICES_OUTPUT_FANOUT_H
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Copies the output of one running request to every client fd attached to it.
+ * The request writes into GetInputFd(), a relay thread forwards each block to all clients
+ * and keeps a bounded replay copy so that a client attaching late still gets the whole output.
+ * The relay never blocks on a follower, each one has its own bounded queue written from its own thread
+ * and is dropped with DUMP_FAIL once it falls further behind than the replay limit.
+ */
+class OutputFanout {
+public:
+    static constexpr size_t DEFAULT_REPLAY_LIMIT = 4 * 1024 * 1024;
+
+    explicit OutputFanout(size_t replayLimit = DEFAULT_REPLAY_LIMIT);
+    ~OutputFanout();
+    OutputFanout(const OutputFanout&) = delete;
+    OutputFanout& operator=(const OutputFanout&) = delete;
+
+    // takes the ownership of clientFd, returns false if the relay can not be created.
+    bool Start(int clientFd);
+    // write end for the request, owned by the caller after Start and must be closed before Finish.
+    int GetInputFd() const;
+    // takes the ownership of clientFd on success, fails once the output is finished or the replay is dropped.
+    // the whole output is written from the calling thread, which blocks until the leader finishes.
+    // status is the leader's one, or DUMP_FAIL if the client was dropped before it got everything.
+    bool Attach(int clientFd, int32_t &status);
+    // waits until the input is closed and the output is queued for every client, then closes the leader fd.
+    // the followers close their own fd once their queue is written.
+    void Finish(int32_t status);
+
+private:
+    struct Follower {
+        std::string pending; // output not written to the client yet, at most replayLimit_
+        bool dropped = false;
+    };
+
+    void Run();
+    void Forward(const char* data, size_t size);
+    static bool WriteAll(int fd, const char* data, size_t size);
+    static void CloseFd(int fd);
+
+private:
+    size_t replayLimit_;
+    int readFd_ = -1;
+    int writeFd_ = -1;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    int leaderFd_ = -1;
+    std::vector<std::shared_ptr<Follower>> followers_;
+    std::string replay_;
+    bool replayDropped_ = false;
+    bool finished_ = false;
+    int32_t status_ = 0;
+    std::thread relay_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_SERVICES_OUTPUT_FANOUT_H
@@ -14,17 +14,23 @@
  */
 #ifndef HIDUMPER_SERVICES_DUMP_RAW_PARAM_H
 #define HIDUMPER_SERVICES_DUMP_RAW_PARAM_H
+#include <chrono>
 #include <set>
 #include <string_ex.h>
 #include <vector>
 #include "dump_controller.h"
 #include "idump_broker.h"
+#include "util/dump_staging_area.h"
 namespace OHOS {
 namespace HiviewDFX {
 class DumpManagerService;
 class DumpManagerServiceClient;
 class RawParam {
 public:
+    enum class ProgressMode {
+        TERMINAL, // a percentage with a spinner, redrawn in place
+        MACHINE, // one "progress:N" line each time the percentage changes, for scripts
+    };
     RawParam(int calllingUid, int calllingPid, uint32_t reqId, std::vector<std::u16string>& args, int outfd);
     ~RawParam();
     int GetArgc();
@@ -41,8 +47,11 @@ public:
     void UpdateStatus(uint32_t status, bool force = false);
     void SetProgressEnabled(bool enable);
     bool IsProgressEnabled() const;
+    void SetProgressMode(ProgressMode mode);
     void UpdateProgress(uint32_t total, uint32_t current);
     void UpdateProgress(uint64_t progress);
+    // reports where the trace of the dump was saved, after the result.
+    void ReportTrace(const std::string &tracePath);
     int& GetOutputFd();
     void CloseOutputFd();
     bool Init(std::vector<std::u16string>& args);
@@ -50,9 +59,14 @@ public:
     void SetTitle(const std::string &path);
     void SetFolder(const std::string &folder);
     std::string GetFolder();
+    void SetStagingArea(const std::shared_ptr<DumpStagingArea> &stagingArea);
+    std::shared_ptr<DumpStagingArea> GetStagingArea();
 private:
     void Dump() const;
     void SetCallerPpid(const std::string &ppid);
+    bool ShouldReportProgress(bool finished, std::chrono::steady_clock::time_point now) const;
+    std::string RenderProgress(bool finished);
+    bool WriteProgress(const std::string &frame, bool wait);
     class ClientDeathRecipient : public IRemoteObject::DeathRecipient {
     public:
         ClientDeathRecipient(uint32_t reqId, bool& deathed);
@@ -80,10 +94,17 @@ private:
     int outfd_ {-1};
     sptr<IRemoteObject::DeathRecipient> deathRecipient_;
     bool progressEnabled_ {false};
+    ProgressMode progressMode_ {ProgressMode::TERMINAL};
+    std::mutex progressMutex_;
     uint32_t progressTick_ {0};
     uint64_t progress_ {0};
+    uint64_t reportedProgress_ {0};
+    bool progressReported_ {false};
+    bool finishReported_ {false};
+    std::chrono::steady_clock::time_point reportTime_;
     std::string path_;
     std::string folder_;
+    std::shared_ptr<DumpStagingArea> stagingArea_;
     const uint64_t FINISH = 100;
 };
 } // namespace HiviewDFX
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "cpu_usage_sampler.h"
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+#include "cpu_collector.h"
+#include "hilog_wrapper.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static constexpr double HUNDRED_PERCENT_VALUE = 100.00;
+static constexpr uint32_t MIN_PERIOD_MS = 100;
+static constexpr uint64_t MS_PER_SECOND = 1000;
+
+int64_t GetNowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// the collector stamps the samples with the wall clock, the window is measured on the same clock.
+uint64_t GetWallNowMs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+bool TakeSample(const std::shared_ptr<UCollectUtil::CpuCollector>& collector, CpuUsageSample& sample)
+{
+    CollectResult<SysCpuUsage> sysResult = collector->CollectSysCpuUsage(true);
+    if (sysResult.retCode != UCollect::UcError::SUCCESS || sysResult.data.cpuInfos.empty()) {
+        DUMPER_HILOGE(MODULE_CPU_SERVICE, "sample system cpu usage error, ret:%{public}d", sysResult.retCode);
+        return false;
+    }
+    sample.startTime = sysResult.data.startTime;
+    sample.endTime = sysResult.data.endTime;
+    const auto& total = sysResult.data.cpuInfos.front();
+    sample.cpuInfo.userUsage = total.userUsage;
+    sample.cpuInfo.niceUsage = total.niceUsage;
+    sample.cpuInfo.systemUsage = total.systemUsage;
+    sample.cpuInfo.idleUsage = total.idleUsage;
+    sample.cpuInfo.ioWaitUsage = total.ioWaitUsage;
+    sample.cpuInfo.irqUsage = total.irqUsage;
+    sample.cpuInfo.softIrqUsage = total.softIrqUsage;
+
+    auto procResult = collector->CollectProcessCpuStatInfos(true);
+    if (procResult.retCode != UCollect::UcError::SUCCESS || procResult.data.empty()) {
+        DUMPER_HILOGE(MODULE_CPU_SERVICE, "sample process cpu stat info error");
+        return false;
+    }
+    sample.procInfos.reserve(procResult.data.size());
+    for (const auto& cpuInfo : procResult.data) {
+        ProcInfo procInfo;
+        procInfo.pid = std::to_string(cpuInfo.pid);
+        procInfo.comm = cpuInfo.procName;
+        procInfo.minflt = std::to_string(cpuInfo.minFlt);
+        procInfo.majflt = std::to_string(cpuInfo.majFlt);
+        procInfo.userSpaceUsage = cpuInfo.uCpuUsage * HUNDRED_PERCENT_VALUE;
+        procInfo.sysSpaceUsage = cpuInfo.sCpuUsage * HUNDRED_PERCENT_VALUE;
+        procInfo.totalUsage = cpuInfo.cpuUsage * HUNDRED_PERCENT_VALUE;
+        sample.procInfos.push_back(std::move(procInfo));
+    }
+
+    CollectResult<SysCpuLoad> loadResult = collector->CollectSysCpuLoad();
+    if (loadResult.retCode == UCollect::UcError::SUCCESS) {
+        sample.avgLoad1 = loadResult.data.avgLoad1;
+        sample.avgLoad5 = loadResult.data.avgLoad5;
+        sample.avgLoad15 = loadResult.data.avgLoad15;
+    }
+    return true;
+}
+
+void AccumulateCpuInfo(const CPUInfo& from, double weight, CPUInfo& to)
+{
+    to.userUsage += from.userUsage * weight;
+    to.niceUsage += from.niceUsage * weight;
+    to.systemUsage += from.systemUsage * weight;
+    to.idleUsage += from.idleUsage * weight;
+    to.ioWaitUsage += from.ioWaitUsage * weight;
+    to.irqUsage += from.irqUsage * weight;
+    to.softIrqUsage += from.softIrqUsage * weight;
+}
+} // namespace
+
+CpuUsageSampler::CpuUsageSampler(uint32_t periodMs) : periodMs_(std::max(periodMs, MIN_PERIOD_MS))
+{
+    capacity_ = (MAX_WINDOW_SEC * MS_PER_SECOND + periodMs_ - 1) / periodMs_ + 1;
+    ring_.resize(capacity_);
+}
+
+CpuUsageSampler::~CpuUsageSampler()
+{
+    Stop();
+}
+
+void CpuUsageSampler::Start()
+{
+    lastUseMs_ = GetNowMs();
+    std::lock_guard<std::mutex> lock(threadMutex_);
+    if (running_) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    running_ = true;
+    thread_ = std::thread([this] { Run(); });
+}
+
+void CpuUsageSampler::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(threadMutex_);
+        running_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool CpuUsageSampler::IsIdle() const
+{
+    return GetNowMs() - lastUseMs_.load() > static_cast<int64_t>(IDLE_STOP_MS);
+}
+
+void CpuUsageSampler::Run()
+{
+    DUMPER_HILOGI(MODULE_CPU_SERVICE, "cpu sampler start, period:%{public}u ms", periodMs_);
+    std::shared_ptr<UCollectUtil::CpuCollector> collector = UCollectUtil::CpuCollector::Create();
+    // the first sample of a fresh collector covers the time since boot, it only primes the collector.
+    bool primed = false;
+    auto deadline = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(threadMutex_);
+    while (running_) {
+        lock.unlock();
+        // sample at a fixed rate, so the newest sample is never more than one period behind.
+        deadline += std::chrono::milliseconds(periodMs_);
+        auto sample = std::make_shared<CpuUsageSample>();
+        if (collector != nullptr && TakeSample(collector, *sample)) {
+            if (primed) {
+                AddSample(sample);
+            }
+            primed = true;
+        }
+        lock.lock();
+        cv_.wait_until(lock, deadline, [this] { return !running_; });
+        if (running_ && IsIdle()) {
+            running_ = false;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (deadline < now) {
+            deadline = now;
+        }
+    }
+    lock.unlock();
+    {
+        // a restarted sampler must not answer from the samples taken before it stopped.
+        std::unique_lock<std::shared_mutex> ringLock(ringMutex_);
+        std::fill(ring_.begin(), ring_.end(), nullptr);
+        next_ = 0;
+    }
+    DUMPER_HILOGI(MODULE_CPU_SERVICE, "cpu sampler stop");
+}
+
+void CpuUsageSampler::AddSample(const std::shared_ptr<const CpuUsageSample>& sample)
+{
+    std::unique_lock<std::shared_mutex> lock(ringMutex_);
+    ring_[next_] = sample;
+    next_ = (next_ + 1) % capacity_;
+}
+
+bool CpuUsageSampler::GetWindow(uint32_t windowSec, CpuUsageSample& result) const
+{
+    std::vector<std::shared_ptr<const CpuUsageSample>> samples;
+    {
+        std::shared_lock<std::shared_mutex> lock(ringMutex_);
+        samples.reserve(capacity_);
+        for (size_t i = 0; i < capacity_; i++) {
+            const auto& sample = ring_[(next_ + i) % capacity_];
+            if (sample != nullptr) {
+                samples.push_back(sample);
+            }
+        }
+    }
+    if (samples.empty()) {
+        return false;
+    }
+    // samples are ordered from the oldest to the newest.
+    const CpuUsageSample& newest = *samples.back();
+    uint64_t now = GetWallNowMs();
+    if (now > newest.endTime && now - newest.endTime > uint64_t(periodMs_) * STALE_PERIODS) {
+        // the sampler has stopped or stalled, the caller collects live instead. a late wakeup is not a stall.
+        return false;
+    }
+    uint64_t windowMs = std::min(std::max(windowSec, 1u), MAX_WINDOW_SEC) * MS_PER_SECOND;
+    uint64_t windowStart = (now > windowMs) ? (now - windowMs) : 0;
+
+    result = CpuUsageSample();
+    result.endTime = newest.endTime;
+    result.startTime = newest.endTime;
+    result.avgLoad1 = newest.avgLoad1;
+    result.avgLoad5 = newest.avgLoad5;
+    result.avgLoad15 = newest.avgLoad15;
+    std::unordered_map<std::string, size_t> procIndex;
+    double totalWeight = 0;
+    for (auto it = samples.rbegin(); it != samples.rend() && (*it)->endTime > windowStart; ++it) {
+        const CpuUsageSample& sample = **it;
+        uint64_t begin = std::max(sample.startTime, windowStart);
+        double weight = static_cast<double>((sample.endTime > begin) ? (sample.endTime - begin) : 1);
+        result.startTime = std::min(result.startTime, begin);
+        totalWeight += weight;
+        AccumulateCpuInfo(sample.cpuInfo, weight, result.cpuInfo);
+        for (const auto& procInfo : sample.procInfos) {
+            auto found = procIndex.find(procInfo.pid);
+            if (found == procIndex.end()) {
+                // walking from the newest sample, so the first hit carries the latest comm and faults.
+                procIndex.emplace(procInfo.pid, result.procInfos.size());
+                ProcInfo merged = procInfo;
+                merged.userSpaceUsage = procInfo.userSpaceUsage * weight;
+                merged.sysSpaceUsage = procInfo.sysSpaceUsage * weight;
+                merged.totalUsage = procInfo.totalUsage * weight;
+                result.procInfos.push_back(std::move(merged));
+                continue;
+            }
+            ProcInfo& merged = result.procInfos[found->second];
+            merged.userSpaceUsage += procInfo.userSpaceUsage * weight;
+            merged.sysSpaceUsage += procInfo.sysSpaceUsage * weight;
+            merged.totalUsage += procInfo.totalUsage * weight;
+        }
+    }
+    CPUInfo weighted = result.cpuInfo;
+    result.cpuInfo = {};
+    AccumulateCpuInfo(weighted, 1.0 / totalWeight, result.cpuInfo);
+    for (auto& procInfo : result.procInfos) {
+        procInfo.userSpaceUsage /= totalWeight;
+        procInfo.sysSpaceUsage /= totalWeight;
+        procInfo.totalUsage /= totalWeight;
+    }
+    return true;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -18,6 +18,9 @@
 #include <securec.h>
 #include <string_ex.h>
 #include <dirent.h>
+#include <algorithm>
+#include <sys/syscall.h>
+#include <unistd.h>
 #include <fstream>
 #include <iostream>
 #include "hilog_wrapper.h"
@@ -44,6 +47,40 @@ static const std::string STORAGE_PATH_PREFIX = "/data/storage/el";
 static const size_t STORAGE_PATH_SIZE = STORAGE_PATH_PREFIX.size();
 static const int TM_START_YEAR = 1900;
 static const int DEC_SYSTEM_VALUE = 10;
+static constexpr size_t DENTS_BUFFER_SIZE = 32 * 1024;
+
+struct LinuxDirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+};
+
+bool ParseId(const char *name, int32_t &id)
+{
+    if (*name == '\0') {
+        return false;
+    }
+    int64_t value = 0;
+    for (const char *ch = name; *ch != '\0'; ch++) {
+        if ((*ch < '0') || (*ch > '9')) {
+            return false;
+        }
+        value = value * DEC_SYSTEM_VALUE + (*ch - '0');
+        if (value > INT32_MAX) {
+            return false;
+        }
+    }
+    id = static_cast<int32_t>(value);
+    return true;
+}
+
+bool IsDirectoryAt(int dirFd, const char *name)
+{
+    struct stat statBuffer;
+    return (fstatat(dirFd, name, &statBuffer, 0) == 0) && S_ISDIR(statBuffer.st_mode);
+}
 }
 
 std::vector<std::string> DumpCommonUtils::GetSubNodes(const std::string &path, bool digit)
@@ -102,18 +139,65 @@ std::vector<std::string> DumpCommonUtils::GetSubDir(const std::string &path, boo
     return subDirs;
 }
 
+void DumpCommonUtils::SetProcRoot(const std::string &root)
+{
+    FileUtils::GetInstance().SetProcRoot(root);
+}
+
 std::vector<int32_t> DumpCommonUtils::GetAllPids()
 {
-    std::string path = "/proc";
     std::vector<int32_t> pids;
-    std::vector<std::string> allPids = GetSubDir(path, true);
-    for (const auto &pid : allPids) {
-        if (!IsNumericStr(pid)) {
-            continue;
+    (void)GetIdsInFolder(FileUtils::GetInstance().GetProcPath("/proc"), pids);
+    return pids;
+}
+
+std::vector<int32_t> DumpCommonUtils::GetAllTids(int32_t pid)
+{
+    std::vector<int32_t> tids;
+    (void)GetIdsInFolder(FileUtils::GetInstance().GetProcPath("/proc/" + std::to_string(pid) + "/task"), tids);
+    return tids;
+}
+
+bool DumpCommonUtils::GetIdsInFolder(const std::string &folder, std::vector<int32_t> &ids)
+{
+    int dirFd = TEMP_FAILURE_RETRY(open(folder.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (dirFd < 0) {
+        DUMPER_HILOGE(MODULE_SERVICE, "failed to open dir: %{public}s, errno: %{public}d", folder.c_str(), errno);
+        return false;
+    }
+    // the names are parsed in the getdents64 buffer, d_type saves a stat for each entry.
+    std::vector<uint64_t> buffer(DENTS_BUFFER_SIZE / sizeof(uint64_t));
+    char *data = reinterpret_cast<char *>(buffer.data());
+    size_t start = ids.size();
+    bool ret = true;
+    while (true) {
+        long len = syscall(SYS_getdents64, dirFd, data, DENTS_BUFFER_SIZE);
+        if (len == 0) {
+            break;
+        }
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            DUMPER_HILOGE(MODULE_SERVICE, "getdents64 %{public}s failed, errno: %{public}d", folder.c_str(), errno);
+            ret = false;
+            break;
+        }
+        for (long pos = 0; pos < len;) {
+            auto ent = reinterpret_cast<LinuxDirent64 *>(data + pos);
+            pos += ent->d_reclen;
+            int32_t id = 0;
+            if (!ParseId(ent->d_name, id)) {
+                continue;
+            }
+            if ((ent->d_type == DT_DIR) || ((ent->d_type == DT_UNKNOWN) && IsDirectoryAt(dirFd, ent->d_name))) {
+                ids.push_back(id);
+            }
         }
-        pids.push_back(std::stoi(pid));
     }
-    return pids;
+    close(dirFd);
+    std::sort(ids.begin() + start, ids.end());
+    return ret;
 }
 
 DumpCommonUtils::CpuInfo::CpuInfo()
@@ -124,7 +208,7 @@ DumpCommonUtils::CpuInfo::CpuInfo()
 bool DumpCommonUtils::GetCpuInfos(std::vector<CpuInfo> &infos)
 {
     std::vector<std::string> names;
-    if (!GetNamesInFolder("/sys/devices/system/cpu/", names)) {
+    if (!GetNamesInFolder(FileUtils::GetInstance().GetProcPath("/sys/devices/system/cpu/"), names)) {
         return false;
     }
     for (size_t i = 0; i < names.size(); i++) {
@@ -160,20 +244,13 @@ void DumpCommonUtils::PidInfo::Reset()
 
 bool DumpCommonUtils::GetPidInfos(std::vector<PidInfo> &infos, bool all)
 {
-    std::vector<std::string> names;
-    if (!GetNamesInFolder("/proc/", names)) {
+    std::vector<int32_t> pids;
+    if (!GetIdsInFolder(FileUtils::GetInstance().GetProcPath("/proc"), pids)) {
         return false;
     }
-    for (size_t i = 0; i < names.size(); i++) {
-        std::string name = names[i];
-        if (name.empty()) {
-            continue;
-        }
-        if (!IsNumericStr(name)) {
-            continue;
-        }
+    for (auto pid : pids) {
         PidInfo pidInfo;
-        StrToInt(name, pidInfo.pid_);
+        pidInfo.pid_ = pid;
         GetProcessInfo(pidInfo.pid_, pidInfo);
         if (all) {
             GetProcessNameByPid(pidInfo.pid_, pidInfo.cmdline_);
@@ -185,7 +262,7 @@ bool DumpCommonUtils::GetPidInfos(std::vector<PidInfo> &infos, bool all)
 
 bool DumpCommonUtils::IsUserPid(const std::string &pid)
 {
-    string path = "/proc/" + pid + "/smaps";
+    string path = FileUtils::GetInstance().GetProcPath("/proc/" + pid + "/smaps");
     string lineContent;
     bool ret = FileUtils::GetInstance().LoadStringFromProcCb(path, true, false, [&](const string& line) -> void {
         lineContent += line;
@@ -201,26 +278,15 @@ bool DumpCommonUtils::IsUserPid(const std::string &pid)
 
 bool DumpCommonUtils::GetUserPids(std::vector<int> &pids)
 {
-    std::vector<std::string> files;
-    if (!GetNamesInFolder("/proc/", files)) {
+    std::vector<int32_t> allPids;
+    if (!GetIdsInFolder(FileUtils::GetInstance().GetProcPath("/proc"), allPids)) {
         return false;
     }
 
-    for (auto file : files) {
-        if (file.empty()) {
-            continue;
-        }
-        if (!IsNumericStr(file)) {
-            continue;
-        }
-
-        if (!IsUserPid(file)) {
+    for (auto pid : allPids) {
+        if (!IsUserPid(std::to_string(pid))) {
             continue;
         }
-
-        int pid;
-        StrToInt(file, pid);
-
         pids.push_back(pid);
     }
     return true;
@@ -272,7 +338,7 @@ bool DumpCommonUtils::GetProcessNameByPid(int pid, std::string& name)
     if (sprintf_s(filesysdir, sizeof(filesysdir), "/proc/%d/cmdline", pid) < 0) {
         return false;
     }
-    std::string filePath = filesysdir;
+    std::string filePath = FileUtils::GetInstance().GetProcPath(filesysdir);
     std::string content;
     bool ret = FileUtils::GetInstance().LoadStringFromProcCb(filePath, false, false, [&](const string& line) -> void {
         content += line;
@@ -305,7 +371,7 @@ bool DumpCommonUtils::GetProcessInfo(int pid, PidInfo &info)
     if (sprintf_s(filesysdir, sizeof(filesysdir), "/proc/%d/status", pid) < 0) {
         return false;
     }
-    std::string file = filesysdir;
+    std::string file = FileUtils::GetInstance().GetProcPath(filesysdir);
     std::vector<std::string> lines;
     if (!GetLinesInFile(file, lines)) {
         return false;
@@ -13,9 +13,17 @@
  * limitations under the License.
  */
 #include "dump_cpu_data.h"
+#include <cinttypes>
 #include "hilog_wrapper.h"
+#include "securec.h"
 namespace OHOS {
 namespace HiviewDFX {
+namespace {
+static constexpr uint32_t MAX_PROC_RECORD_COUNT = 64 * 1024;
+static constexpr int PROC_CPU_LENGTH = 256;
+static_assert(sizeof(CpuProcRecord) == 56, "CpuProcRecord layout is part of the parcel format");
+}
+
 DumpCpuData::DumpCpuData()
 {
 }
@@ -34,10 +42,15 @@ bool DumpCpuData::Marshalling(Parcel& parcel) const
     RETURN_PARCEL_WRITE_HELPER_RET(parcel, String, startTime_, false);
     RETURN_PARCEL_WRITE_HELPER_RET(parcel, String, endTime_, false);
     RETURN_PARCEL_WRITE_HELPER_RET(parcel, Int32, cpuUsagePid_, false);
+    RETURN_PARCEL_WRITE_HELPER_RET(parcel, Uint32, windowSec_, false);
     if (!WriteStringMatrix(dumpCPUDatas_, parcel)) {
         DUMPER_HILOGE(MODULE_CPU_DATA, "failed to write dumpCPUDatas_");
         return false;
     }
+    if (!WriteProcRecords(parcel)) {
+        DUMPER_HILOGE(MODULE_CPU_DATA, "failed to write procRecords_");
+        return false;
+    }
     return true;
 }
 
@@ -61,8 +74,9 @@ bool DumpCpuData::ReadFromParcel(Parcel &parcel)
     RETURN_PARCEL_READ_HELPER_RET(parcel, String, startTime_, false);
     RETURN_PARCEL_READ_HELPER_RET(parcel, String, endTime_, false);
     RETURN_PARCEL_READ_HELPER_RET(parcel, Int32, cpuUsagePid_, false);
+    RETURN_PARCEL_READ_HELPER_RET(parcel, Uint32, windowSec_, false);
     ReadStringMatrix(dumpCPUDatas_, parcel);
-    return true;
+    return ReadProcRecords(parcel);
 }
 
 bool DumpCpuData::WriteStringMatrix(const std::vector<std::vector<std::string>> &martrixVec, Parcel &data) const
@@ -102,5 +116,80 @@ bool DumpCpuData::ReadStringMatrix(std::vector<std::vector<std::string>> &martri
     }
     return true;
 }
+
+bool DumpCpuData::WriteProcRecords(Parcel &data) const
+{
+    if (procRecords_.size() > MAX_PROC_RECORD_COUNT) {
+        DUMPER_HILOGE(MODULE_CPU_DATA, "too many proc records, size=%{public}zu", procRecords_.size());
+        return false;
+    }
+    uint32_t count = static_cast<uint32_t>(procRecords_.size());
+    RETURN_PARCEL_WRITE_HELPER_RET(data, Uint32, count, false);
+    if (count > 0 && !data.WriteBuffer(procRecords_.data(), count * sizeof(CpuProcRecord))) {
+        DUMPER_HILOGE(MODULE_CPU_DATA, "failed to WriteBuffer for procRecords_");
+        return false;
+    }
+    RETURN_PARCEL_WRITE_HELPER_RET(data, String, commPool_, false);
+    return true;
+}
+
+bool DumpCpuData::ReadProcRecords(Parcel &data)
+{
+    uint32_t count = 0;
+    RETURN_PARCEL_READ_HELPER_RET(data, Uint32, count, false);
+    if (count > MAX_PROC_RECORD_COUNT) {
+        DUMPER_HILOGE(MODULE_CPU_DATA, "invalid proc record count %{public}u", count);
+        return false;
+    }
+    procRecords_.clear();
+    if (count > 0) {
+        size_t length = count * sizeof(CpuProcRecord);
+        const uint8_t *buffer = data.ReadBuffer(length);
+        if (buffer == nullptr) {
+            DUMPER_HILOGE(MODULE_CPU_DATA, "failed to ReadBuffer for procRecords_");
+            return false;
+        }
+        procRecords_.resize(count);
+        if (memcpy_s(procRecords_.data(), length, buffer, length) != EOK) {
+            procRecords_.clear();
+            return false;
+        }
+    }
+    RETURN_PARCEL_READ_HELPER_RET(data, String, commPool_, false);
+    for (const auto &record : procRecords_) {
+        if (record.commOffset > commPool_.size() || record.commLength > commPool_.size() - record.commOffset) {
+            DUMPER_HILOGE(MODULE_CPU_DATA, "invalid comm range of pid %{public}d", record.pid);
+            procRecords_.clear();
+            commPool_.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void DumpCpuData::AddProcRecord(CpuProcRecord record, const std::string &comm)
+{
+    record.commOffset = static_cast<uint32_t>(commPool_.size());
+    record.commLength = static_cast<uint32_t>(comm.size());
+    commPool_.append(comm);
+    procRecords_.push_back(record);
+}
+
+void DumpCpuData::FormatProcRecords(std::vector<std::vector<std::string>> &lines) const
+{
+    for (const auto &record : procRecords_) {
+        char format[PROC_CPU_LENGTH] = {0};
+        int ret = sprintf_s(format, PROC_CPU_LENGTH,
+                            "    %-5d    %6.2f%%         %6.2f%%"
+                            "        %6.2f%%        %8" PRIu64 "            %8" PRIu64 "            %-15.*s",
+                            record.pid, record.totalUsage, record.userSpaceUsage, record.sysSpaceUsage,
+                            record.minflt, record.majflt,
+                            static_cast<int>(record.commLength), commPool_.c_str() + record.commOffset);
+        if (ret < 0) {
+            continue;
+        }
+        lines.push_back({std::string(format)});
+    }
+}
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -69,6 +69,14 @@ std::string DumpLogManager::CreateTmpFolder(uint32_t id)
     return ret;
 }
 
+std::shared_ptr<DumpStagingArea> DumpLogManager::CreateStagingArea(const std::string &folder)
+{
+    auto stagingArea = std::make_shared<DumpStagingArea>(folder, DumpStagingArea::Backend::MEMFD);
+    DUMPER_HILOGD(MODULE_COMMON, "CreateStagingArea|folder=%{public}s, backend=%{public}d", folder.c_str(),
+        static_cast<int>(stagingArea->GetBackend()));
+    return stagingArea;
+}
+
 bool DumpLogManager::EraseTmpFolder(uint32_t id)
 {
     DUMPER_HILOGD(MODULE_COMMON, "EraseTmpFolder enter|id=%{public}d", id);
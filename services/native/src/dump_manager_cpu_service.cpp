@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #include "dump_manager_cpu_service.h"
+#include <cstdlib>
 #include <file_ex.h>
 #include <if_system_ability_manager.h>
 #include <ipc_skeleton.h>
@@ -31,6 +32,7 @@
 #include "dump_utils.h"
 #include "hilog_wrapper.h"
 #include "inner/dump_service_id.h"
+#include "parameters.h"
 #include "token_setproc.h"
 #include "util/string_utils.h"
 #include "util/file_utils.h"
@@ -52,9 +54,13 @@ static const int TM_START_YEAR = 1900;
 static const int DEC_SYSTEM_VALUE = 10;
 static const int AVG_INFO_SUBSTR_LENGTH = 4;
 static constexpr int32_t HIDUMPER_XCOLLIE_TIMEOUT = 60; // 60 seconds
+const std::string CPU_SAMPLE_PERIOD_PARAM = "persist.hidumper.cpuusage.sample_period_ms";
 }
 DumpManagerCpuService::DumpManagerCpuService() : SystemAbility(DFX_SYS_HIDUMPER_CPU_ABILITY_ID, true)
 {
+    uint32_t periodMs = OHOS::system::GetUintParameter<uint32_t>(CPU_SAMPLE_PERIOD_PARAM,
+        CpuUsageSampler::DEFAULT_PERIOD_MS);
+    sampler_ = std::make_unique<CpuUsageSampler>(periodMs);
 }
 
 DumpManagerCpuService::~DumpManagerCpuService()
@@ -76,21 +82,77 @@ int32_t DumpManagerCpuService::Request(DumpCpuData &dumpCpuData)
     DUMPER_HILOGI(MODULE_CPU_SERVICE, "enter");
     auto timerId = HiviewDFX::XCollie::GetInstance().SetTimer("HiviewDfx_DumperCpuService_Request",
         HIDUMPER_XCOLLIE_TIMEOUT, nullptr, nullptr, HiviewDFX::XCOLLIE_FLAG_LOG | HiviewDFX::XCOLLIE_FLAG_RECOVERY);
-    std::lock_guard<std::mutex> lock(mutex_);
-    InitParam(dumpCpuData);
     if (!HasDumpPermission()) {
         DUMPER_HILOGE(MODULE_SERVICE,
                       "No ohos.permission.DUMP permission to acccess hidumper cpuservice, please check!");
         HiviewDFX::XCollie::GetInstance().CancelTimer(timerId);
         return DumpStatus::DUMP_NOPERMISSION;
     }
+    // answered from the sampler without mutex_, so concurrent requests do not wait for each other.
+    if (DumpFromSampler(dumpCpuData)) {
+        HiviewDFX::XCollie::GetInstance().CancelTimer(timerId);
+        return DumpStatus::DUMP_OK;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    InitParam(dumpCpuData);
     int32_t ret = DumpCpuUsageData();
     dumpCpuData.dumpCPUDatas_ = *dumpCPUDatas_;
+    dumpCpuData.procRecords_.swap(procData_->procRecords_);
+    dumpCpuData.commPool_.swap(procData_->commPool_);
     ResetParam();
     HiviewDFX::XCollie::GetInstance().CancelTimer(timerId);
     return ret;
 }
 
+bool DumpManagerCpuService::DumpFromSampler(DumpCpuData &dumpCpuData)
+{
+    if (sampler_ == nullptr) {
+        return false;
+    }
+    sampler_->Start();
+    CpuUsageSample window;
+    if (!sampler_->GetWindow(dumpCpuData.windowSec_, window)) {
+        return false;
+    }
+    const ProcInfo *specProc = nullptr;
+    if (dumpCpuData.cpuUsagePid_ != INVALID_PID) {
+        std::string pid = std::to_string(dumpCpuData.cpuUsagePid_);
+        auto it = std::find_if(window.procInfos.begin(), window.procInfos.end(),
+            [&pid](const ProcInfo &info) { return info.pid == pid; });
+        if (it == window.procInfos.end()) {
+            // started after the last sample, let the collector read it directly.
+            return false;
+        }
+        specProc = &(*it);
+    }
+    std::string avgInfo;
+    FormatLoadAvgInfo(window.avgLoad1, window.avgLoad5, window.avgLoad15, avgInfo);
+    dumpCpuData.dumpCPUDatas_.push_back({avgInfo});
+
+    std::string startTime;
+    std::string endTime;
+    GetDateAndTime(window.startTime / THOUSAND_PERCENT_VALUE, startTime);
+    GetDateAndTime(window.endTime / THOUSAND_PERCENT_VALUE, endTime);
+    std::string dumpTimeStr;
+    CreateDumpTimeString(startTime, endTime, dumpTimeStr);
+    dumpCpuData.dumpCPUDatas_.push_back({dumpTimeStr});
+
+    std::string cpuStatStr;
+    CreateCPUStatString(window.cpuInfo, cpuStatStr);
+    dumpCpuData.dumpCPUDatas_.push_back({cpuStatStr});
+
+    if (specProc != nullptr) {
+        AddProcRecord(*specProc, dumpCpuData);
+        return true;
+    }
+    std::sort(window.procInfos.begin(), window.procInfos.end(), CompareProcInfo);
+    dumpCpuData.procRecords_.reserve(window.procInfos.size());
+    for (const auto &info : window.procInfos) {
+        AddProcRecord(info, dumpCpuData);
+    }
+    return true;
+}
+
 void DumpManagerCpuService::InitParam(DumpCpuData &dumpCpuData)
 {
     cpuUsagePid_ = dumpCpuData.cpuUsagePid_;
@@ -99,12 +161,14 @@ void DumpManagerCpuService::InitParam(DumpCpuData &dumpCpuData)
     }
     curCPUInfo_ = std::make_shared<CPUInfo>();
     dumpCPUDatas_ = std::make_shared<std::vector<std::vector<std::string>>>(dumpCpuData.dumpCPUDatas_);
+    procData_ = std::make_shared<DumpCpuData>();
 }
 
 void DumpManagerCpuService::ResetParam()
 {
     curCPUInfo_.reset();
     curProcs_.clear();
+    procData_.reset();
     if (cpuUsagePid_ != INVALID_PID) {
         curSpecProc_.reset();
     }
@@ -193,10 +257,16 @@ DumpStatus DumpManagerCpuService::ReadLoadAvgInfo(std::string &info)
         DUMPER_HILOGE(MODULE_CPU_SERVICE, "collect system cpu load error, ret:%{public}d", collectResult.retCode);
         return DumpStatus::DUMP_FAIL;
     }
+    FormatLoadAvgInfo(collectResult.data.avgLoad1, collectResult.data.avgLoad5, collectResult.data.avgLoad15, info);
+    return DumpStatus::DUMP_OK;
+}
+
+void DumpManagerCpuService::FormatLoadAvgInfo(double avgLoad1, double avgLoad5, double avgLoad15, std::string &info)
+{
     std::vector<std::string> avgLoadInfo;
-    avgLoadInfo.push_back(std::string(std::to_string(collectResult.data.avgLoad1)).substr(0, AVG_INFO_SUBSTR_LENGTH));
-    avgLoadInfo.push_back(std::string(std::to_string(collectResult.data.avgLoad5)).substr(0, AVG_INFO_SUBSTR_LENGTH));
-    avgLoadInfo.push_back(std::string(std::to_string(collectResult.data.avgLoad15)).substr(0, AVG_INFO_SUBSTR_LENGTH));
+    avgLoadInfo.push_back(std::string(std::to_string(avgLoad1)).substr(0, AVG_INFO_SUBSTR_LENGTH));
+    avgLoadInfo.push_back(std::string(std::to_string(avgLoad5)).substr(0, AVG_INFO_SUBSTR_LENGTH));
+    avgLoadInfo.push_back(std::string(std::to_string(avgLoad15)).substr(0, AVG_INFO_SUBSTR_LENGTH));
 
     info = "Load average:";
     for (size_t i = 0; i < LOAD_AVG_INFO_COUNT; i++) {
@@ -210,7 +280,6 @@ DumpStatus DumpManagerCpuService::ReadLoadAvgInfo(std::string &info)
     }
     info.append(" the cpu load average in 1 min, 5 min and 15 min");
     DUMPER_HILOGD(MODULE_CPU_SERVICE, "info is %{public}s", info.c_str());
-    return DumpStatus::DUMP_OK;
 }
 
 bool DumpManagerCpuService::GetSysCPUInfo(std::shared_ptr<CPUInfo> &cpuInfo)
@@ -364,11 +433,16 @@ void DumpManagerCpuService::AddStrLineToDumpInfo(const std::string &strLine)
 
 void DumpManagerCpuService::CreateCPUStatString(std::string &str)
 {
-    double userSpaceUsage = (curCPUInfo_->userUsage + curCPUInfo_->niceUsage) * HUNDRED_PERCENT_VALUE;
-    double sysSpaceUsage = curCPUInfo_->systemUsage * HUNDRED_PERCENT_VALUE;
-    double iowUsage = curCPUInfo_->ioWaitUsage * HUNDRED_PERCENT_VALUE;
-    double irqUsage = (curCPUInfo_->irqUsage + curCPUInfo_->softIrqUsage) * HUNDRED_PERCENT_VALUE;
-    double idleUsage = curCPUInfo_->idleUsage * HUNDRED_PERCENT_VALUE;
+    CreateCPUStatString(*curCPUInfo_, str);
+}
+
+void DumpManagerCpuService::CreateCPUStatString(const CPUInfo &cpuInfo, std::string &str)
+{
+    double userSpaceUsage = (cpuInfo.userUsage + cpuInfo.niceUsage) * HUNDRED_PERCENT_VALUE;
+    double sysSpaceUsage = cpuInfo.systemUsage * HUNDRED_PERCENT_VALUE;
+    double iowUsage = cpuInfo.ioWaitUsage * HUNDRED_PERCENT_VALUE;
+    double irqUsage = (cpuInfo.irqUsage + cpuInfo.softIrqUsage) * HUNDRED_PERCENT_VALUE;
+    double idleUsage = cpuInfo.idleUsage * HUNDRED_PERCENT_VALUE;
     double totalUsage = userSpaceUsage + sysSpaceUsage;
 
     char format[PROC_CPU_LENGTH] = {0};
@@ -385,59 +459,60 @@ void DumpManagerCpuService::CreateCPUStatString(std::string &str)
 
 void DumpManagerCpuService::DumpProcInfo()
 {
-    std::vector<std::shared_ptr<ProcInfo>> sortedInfos;
-    sortedInfos.assign(curProcs_.begin(), curProcs_.end());
-    std::sort(sortedInfos.begin(), sortedInfos.end(), SortProcInfo);
-
+    // the header goes out even with no process, only the rows are formatted on the caller side.
     AddStrLineToDumpInfo("Details of Processes:");
-    AddStrLineToDumpInfo("    PID   Total Usage	   User Space    Kernel Space    Page Fault Minor"
+    AddStrLineToDumpInfo("    PID   Total Usage\t   User Space    Kernel Space    Page Fault Minor"
                          "    Page Fault Major    Name");
+    if (procData_ == nullptr) {
+        return;
+    }
     if (cpuUsagePid_ != INVALID_PID) {
-        char format[PROC_CPU_LENGTH] = {0};
-        int ret = sprintf_s(format, PROC_CPU_LENGTH,
-                            "    %-5s    %6.2f%%         %6.2f%%"
-                            "        %6.2f%%        %8s            %8s            %-15s",
-                            (curSpecProc_->pid).c_str(), curSpecProc_->totalUsage,
-                            curSpecProc_->userSpaceUsage, curSpecProc_->sysSpaceUsage,
-                            (curSpecProc_->minflt).c_str(), (curSpecProc_->majflt).c_str(),
-                            (curSpecProc_->comm).c_str());
-        AddStrLineToDumpInfo(std::string(format));
-        if (ret < 0) {
-            DUMPER_HILOGE(MODULE_CPU_SERVICE, "Dump process %{public}d cpu info failed!.", cpuUsagePid_);
+        if (curSpecProc_ != nullptr) {
+            AddProcRecord(*curSpecProc_, *procData_);
         }
         return;
     }
-    for (size_t i = 0; i < sortedInfos.size(); i++) {
-        char format[PROC_CPU_LENGTH] = {0};
-        int ret = sprintf_s(format, PROC_CPU_LENGTH,
-                            "    %-5s    %6.2f%%         %6.2f%%"
-                            "        %6.2f%%        %8s            %8s            %-15s",
-                            (sortedInfos[i]->pid).c_str(), sortedInfos[i]->totalUsage,
-                            sortedInfos[i]->userSpaceUsage, sortedInfos[i]->sysSpaceUsage,
-                            (sortedInfos[i]->minflt).c_str(), (sortedInfos[i]->majflt).c_str(),
-                            (sortedInfos[i]->comm).c_str());
-        if (ret < 0) {
-            continue;
-        }
-        AddStrLineToDumpInfo(std::string(format));
+    std::vector<std::shared_ptr<ProcInfo>> sortedInfos;
+    sortedInfos.assign(curProcs_.begin(), curProcs_.end());
+    std::sort(sortedInfos.begin(), sortedInfos.end(), SortProcInfo);
+    procData_->procRecords_.reserve(sortedInfos.size());
+    for (const auto &info : sortedInfos) {
+        AddProcRecord(*info, *procData_);
     }
 }
 
+void DumpManagerCpuService::AddProcRecord(const ProcInfo &info, DumpCpuData &dumpCpuData)
+{
+    CpuProcRecord record;
+    record.pid = static_cast<int32_t>(strtol(info.pid.c_str(), nullptr, DEC_SYSTEM_VALUE));
+    record.minflt = strtoull(info.minflt.c_str(), nullptr, DEC_SYSTEM_VALUE);
+    record.majflt = strtoull(info.majflt.c_str(), nullptr, DEC_SYSTEM_VALUE);
+    record.totalUsage = info.totalUsage;
+    record.userSpaceUsage = info.userSpaceUsage;
+    record.sysSpaceUsage = info.sysSpaceUsage;
+    dumpCpuData.AddProcRecord(record, info.comm);
+}
+
 bool DumpManagerCpuService::SortProcInfo(std::shared_ptr<ProcInfo> &left, std::shared_ptr<ProcInfo> &right)
 {
-    if (right->totalUsage != left->totalUsage) {
-        return right->totalUsage < left->totalUsage;
+    return CompareProcInfo(*left, *right);
+}
+
+bool DumpManagerCpuService::CompareProcInfo(const ProcInfo &left, const ProcInfo &right)
+{
+    if (right.totalUsage != left.totalUsage) {
+        return right.totalUsage < left.totalUsage;
     }
-    if (right->userSpaceUsage != left->userSpaceUsage) {
-        return right->userSpaceUsage < left->userSpaceUsage;
+    if (right.userSpaceUsage != left.userSpaceUsage) {
+        return right.userSpaceUsage < left.userSpaceUsage;
     }
-    if (right->sysSpaceUsage != left->sysSpaceUsage) {
-        return right->sysSpaceUsage < left->sysSpaceUsage;
+    if (right.sysSpaceUsage != left.sysSpaceUsage) {
+        return right.sysSpaceUsage < left.sysSpaceUsage;
     }
-    if (right->pid.length() != left->pid.length()) {
-        return right->pid.length() < left->pid.length();
+    if (right.pid.length() != left.pid.length()) {
+        return right.pid.length() < left.pid.length();
     }
-    return (right->pid.compare(left->pid) < 0);
+    return (right.pid.compare(left.pid) < 0);
 }
 
 void DumpManagerCpuService::StartService()
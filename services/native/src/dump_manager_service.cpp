@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #include "dump_manager_service.h"
+#include <algorithm>
 #include <file_ex.h>
 #include <if_system_ability_manager.h>
 #include <ipc_skeleton.h>
@@ -32,9 +33,11 @@
 #include "common.h"
 #include "common/dumper_constant.h"
 #include "dump_log_manager.h"
+#include "executor/memory_dumper.h"
 #include "inner/dump_service_id.h"
 #include "hilog_wrapper.h"
 #include "manager/dump_implement.h"
+#include "output_fanout.h"
 #include "raw_param.h"
 #include "token_setproc.h"
 #include "accesstoken_kit.h"
@@ -59,6 +62,22 @@ constexpr size_t FD_TOP_CNT = 10;
 constexpr int32_t NEED_DUMP_FDLINK_NUMS = 1200;
 constexpr size_t ORPHAN_FD_TOP_CNT = 3;
 constexpr size_t ORPHAN_FDLINKPATH_TOP_CNT = 10;
+// one run slot is kept for interactive requests targeting a single process.
+static const int32_t RUNNING_MAX = 3;
+static const int PRIORITY_LOW = 0;
+static const int PRIORITY_NORMAL = 1;
+static const int PRIORITY_HIGH = 2;
+// read-only options whose output depends only on the arguments, so identical requests can share one run.
+const std::set<std::string> SHAREABLE_OPTIONS = {
+    "--cpufreq", "--cpuusage", "--mem", "--net", "--storage", "--prune", "--show-ashmem", "--show-dmabuf",
+    "-c", "-e", "-l",
+};
+const std::set<std::string> LOW_PRIORITY_OPTIONS = {"-a", "-c", "-e", "-z", "--zip"};
+
+bool IsNumber(const std::string &str)
+{
+    return !str.empty() && std::all_of(str.begin(), str.end(), [](char c) { return isdigit(c) != 0; });
+}
 }
 
 DumpManagerService::DumpManagerService() : SystemAbility(DFX_SYS_HIDUMPER_ABILITY_ID, true)
@@ -187,12 +206,23 @@ int32_t DumpManagerService::Request(std::vector<std::u16string> &args, int outfd
         DUMPER_HILOGE(MODULE_SERVICE, "sum is greater than the request max, sum:%{public}d.", sum);
         HandleRequestError(args, outfd, static_cast<int32_t>(DumpStatus::DUMP_FAIL), "request sum reached max");
         return DumpStatus::DUMP_REQUEST_MAX;
-    } else if (sum == 0) {
+    }
+    std::string fingerprint = GetRequestFingerprint(args);
+    int32_t leaderStatus = DumpStatus::DUMP_OK;
+    if (AttachToInflightRequest(fingerprint, outfd, leaderStatus)) {
+        return leaderStatus;
+    }
+    if (sum == 0) {
         DumpLogManager::Init();
     }
     DelayUnloadTask();
     DUMPER_HILOGD(MODULE_SERVICE, "enter|");
+    std::shared_ptr<OutputFanout> fanout = LeadInflightRequest(fingerprint, outfd);
     const std::shared_ptr<RawParam> rawParam = AddRequestRawParam(args, outfd);
+    if (fanout != nullptr) {
+        unique_lock<mutex> lock(mutex_);
+        inflightLeaders_[rawParam->GetRequestId()] = fingerprint;
+    }
     int32_t ret = StartRequest(rawParam);
     DUMPER_HILOGD(MODULE_SERVICE, "leave|ret=%{public}d", ret);
     return ret;
@@ -568,7 +598,7 @@ bool DumpManagerService::Init()
 int DumpManagerService::GetRequestSum()
 {
     unique_lock<mutex> lock(mutex_);
-    return requestRawParamMap_.size();
+    return requestRawParamMap_.size() + followerCount_;
 }
 
 std::shared_ptr<RawParam> DumpManagerService::AddRequestRawParam(std::vector<std::u16string> &args, int outfd)
@@ -606,6 +636,15 @@ void DumpManagerService::EraseRequestRawParam(const std::shared_ptr<RawParam> ra
     DUMPER_HILOGD(MODULE_SERVICE, "leave|");
 }
 
+void DumpManagerService::NotifyRequestCanceled()
+{
+    {
+        // taken so the wakeup can not fall between a waiter checking its predicate and blocking.
+        unique_lock<mutex> lock(mutex_);
+    }
+    runSlotCond_.notify_all();
+}
+
 void DumpManagerService::CancelAllRequest()
 {
     DUMPER_HILOGD(MODULE_SERVICE, "enter|");
@@ -616,6 +655,7 @@ void DumpManagerService::CancelAllRequest()
         }
         requestIt.second->Cancel();
     }
+    runSlotCond_.notify_all();
     DUMPER_HILOGD(MODULE_SERVICE, "leave|");
 }
 
@@ -646,6 +686,156 @@ void DumpManagerService::GetIdleRequest()
     }
 }
 
+std::string DumpManagerService::GetRequestFingerprint(const std::vector<std::u16string> &args)
+{
+    // args are the program name, the options and the caller ppid appended by the client.
+    if (args.size() <= ARG_MIN_COUNT + 1) {
+        return "";
+    }
+    std::string fingerprint;
+    for (size_t i = 1; i < args.size() - 1; i++) {
+        std::string arg = Str16ToStr8(args[i]);
+        std::string value;
+        size_t pos = arg.find('=');
+        if (pos != std::string::npos) {
+            value = arg.substr(pos + 1);
+            arg.resize(pos);
+        }
+        if (SHAREABLE_OPTIONS.count(arg) == 0 && !IsNumber(arg)) {
+            return "";
+        }
+        if (!value.empty() && !IsNumber(value)) {
+            return "";
+        }
+        fingerprint.append(arg);
+        if (!value.empty()) {
+            fingerprint.append(" ").append(value);
+        }
+        fingerprint.append(" ");
+    }
+    return fingerprint;
+}
+
+int DumpManagerService::GetRequestPriority(int argc, char *argv[])
+{
+    if (argc <= 1 || argv == nullptr) {
+        return PRIORITY_LOW;
+    }
+    bool hasPid = false;
+    for (int i = 1; i < argc && argv[i] != nullptr; i++) {
+        std::string arg(argv[i]);
+        if (LOW_PRIORITY_OPTIONS.count(arg) > 0) {
+            return PRIORITY_LOW;
+        }
+        size_t pos = arg.find('=');
+        hasPid = hasPid || IsNumber(arg) || (pos != std::string::npos && IsNumber(arg.substr(pos + 1)));
+    }
+    return hasPid ? PRIORITY_HIGH : PRIORITY_NORMAL;
+}
+
+bool DumpManagerService::AttachToInflightRequest(const std::string &fingerprint, int outfd, int32_t &status)
+{
+    if (fingerprint.empty()) {
+        return false;
+    }
+    std::shared_ptr<OutputFanout> fanout;
+    {
+        unique_lock<mutex> lock(mutex_);
+        auto it = inflightRequests_.find(fingerprint);
+        if (it == inflightRequests_.end()) {
+            return false;
+        }
+        fanout = it->second;
+        followerCount_++;
+    }
+    bool attached = fanout->Attach(outfd, status);
+    if (attached) {
+        DUMPER_HILOGI(MODULE_SERVICE, "attached to inflight request:%{public}s, status:%{public}d",
+            fingerprint.c_str(), status);
+    }
+    unique_lock<mutex> lock(mutex_);
+    followerCount_--;
+    return attached;
+}
+
+std::shared_ptr<OutputFanout> DumpManagerService::LeadInflightRequest(const std::string &fingerprint, int &outfd)
+{
+    if (fingerprint.empty() || outfd < 0) {
+        return nullptr;
+    }
+    unique_lock<mutex> lock(mutex_);
+    if (inflightRequests_.count(fingerprint) > 0) {
+        return nullptr;
+    }
+    auto fanout = std::make_shared<OutputFanout>();
+    if (!fanout->Start(outfd)) {
+        return nullptr;
+    }
+    outfd = fanout->GetInputFd();
+    inflightRequests_[fingerprint] = fanout;
+    return fanout;
+}
+
+void DumpManagerService::EndInflightRequest(const std::shared_ptr<RawParam> rawParam, int32_t status)
+{
+    std::shared_ptr<OutputFanout> fanout;
+    {
+        unique_lock<mutex> lock(mutex_);
+        auto leader = inflightLeaders_.find(rawParam->GetRequestId());
+        if (leader == inflightLeaders_.end()) {
+            rawParam->CloseOutputFd();
+            return;
+        }
+        auto it = inflightRequests_.find(leader->second);
+        if (it != inflightRequests_.end()) {
+            fanout = it->second;
+            inflightRequests_.erase(it);
+        }
+        inflightLeaders_.erase(leader);
+    }
+    // closing the pipe lets the relay drain and close every attached client.
+    rawParam->CloseOutputFd();
+    if (fanout != nullptr) {
+        fanout->Finish(status);
+    }
+}
+
+bool DumpManagerService::AcquireRunSlot(const std::shared_ptr<RawParam> rawParam, int priority)
+{
+    unique_lock<mutex> lock(mutex_);
+    const std::pair<int, uint64_t> key(-priority, ++waitingSeq_);
+    waitingRequests_.insert(key);
+    runSlotCond_.wait(lock, [this, &key, &rawParam, priority] {
+        if (blockRequest_ || rawParam->IsCanceled()) {
+            return true;
+        }
+        bool laneFree = (priority == PRIORITY_HIGH) || (runningLowCount_ < RUNNING_MAX - 1);
+        return *waitingRequests_.begin() == key && runningCount_ < RUNNING_MAX && laneFree;
+    });
+    waitingRequests_.erase(key);
+    if (blockRequest_ || rawParam->IsCanceled()) {
+        runSlotCond_.notify_all();
+        return false;
+    }
+    runningCount_++;
+    if (priority != PRIORITY_HIGH) {
+        runningLowCount_++;
+    }
+    return true;
+}
+
+void DumpManagerService::ReleaseRunSlot(int priority)
+{
+    {
+        unique_lock<mutex> lock(mutex_);
+        runningCount_--;
+        if (priority != PRIORITY_HIGH) {
+            runningLowCount_--;
+        }
+    }
+    runSlotCond_.notify_all();
+}
+
 int32_t DumpManagerService::StartRequest(const std::shared_ptr<RawParam> rawParam)
 {
     RequestMain(rawParam);
@@ -659,17 +849,22 @@ void DumpManagerService::RequestMain(const std::shared_ptr<RawParam> rawParam)
     char **argV = rawParam->GetArgv();
     std::string folder = DumpLogManager::CreateTmpFolder(rawParam->GetRequestId());
     rawParam->SetFolder(folder);
-    if ((argC > 0) && (argV != nullptr)) {
+    rawParam->SetStagingArea(DumpLogManager::CreateStagingArea(folder));
+    int priority = GetRequestPriority(argC, argV);
+    DumpStatus status = DumpStatus::DUMP_FAIL;
+    if ((argC > 0) && (argV != nullptr) && AcquireRunSlot(rawParam, priority)) {
         DUMPER_HILOGD(MODULE_SERVICE, "debug|enter task, argC=%{public}d", argC);
         for (int i = 0; i < argC; i++) {
             DUMPER_HILOGD(MODULE_SERVICE, "debug|argV[%{public}d]=%{public}s", i, argV[i]);
         }
-        DumpImplement::GetInstance().Main(argC, argV, rawParam);
+        status = DumpImplement::GetInstance().Main(argC, argV, rawParam);
+        ReleaseRunSlot(priority);
         DUMPER_HILOGD(MODULE_SERVICE, "debug|leave task");
     }
+    rawParam->SetStagingArea(nullptr);
     DumpLogManager::EraseTmpFolder(rawParam->GetRequestId());
     DumpLogManager::EraseLogs();
-    rawParam->CloseOutputFd();
+    EndInflightRequest(rawParam, status);
     EraseRequestRawParam(rawParam);
     DUMPER_HILOGD(MODULE_SERVICE, "leave|");
 }
@@ -684,6 +879,7 @@ void DumpManagerService::DelayUnloadTask()
             GetIdleRequest();
             return;
         }
+        MemoryDumper::ReleaseMemoryLibrary();
         auto samgrProxy = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
         if (samgrProxy == nullptr) {
             DUMPER_HILOGE(MODULE_SERVICE, "get samgr failed");
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "output_fanout.h"
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include "common.h"
+#include "common/dumper_constant.h"
+#include "hilog_wrapper.h"
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static constexpr size_t RELAY_BUFFER_SIZE = 64 * 1024;
+} // namespace
+
+OutputFanout::OutputFanout(size_t replayLimit) : replayLimit_(replayLimit)
+{
+}
+
+OutputFanout::~OutputFanout()
+{
+    Finish(DumpStatus::DUMP_OK);
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return followers_.empty(); });
+}
+
+bool OutputFanout::Start(int clientFd)
+{
+    int pipeFds[2] = {-1, -1};
+    if (pipe2(pipeFds, O_CLOEXEC) != 0) {
+        DUMPER_HILOGE(MODULE_SERVICE, "create fanout pipe failed, errno=%{public}d", errno);
+        return false;
+    }
+    readFd_ = pipeFds[0];
+    writeFd_ = pipeFds[1];
+    leaderFd_ = clientFd;
+    relay_ = std::thread([this] { Run(); });
+    return true;
+}
+
+int OutputFanout::GetInputFd() const
+{
+    return writeFd_;
+}
+
+bool OutputFanout::Attach(int clientFd, int32_t &status)
+{
+    auto follower = std::make_shared<Follower>();
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (finished_ || replayDropped_ || readFd_ < 0) {
+        return false;
+    }
+    follower->pending = replay_;
+    followers_.push_back(follower);
+    while (true) {
+        cond_.wait(lock, [this, &follower] {
+            return !follower->pending.empty() || follower->dropped || finished_;
+        });
+        if (follower->dropped || follower->pending.empty()) {
+            break;
+        }
+        std::string data;
+        data.swap(follower->pending);
+        lock.unlock();
+        // blocks the follower's own request only, the relay goes on queueing for it meanwhile.
+        bool ok = WriteAll(clientFd, data.data(), data.size());
+        lock.lock();
+        if (!ok) {
+            DUMPER_HILOGD(MODULE_SERVICE, "follower fd %{public}d gone, errno=%{public}d", clientFd, errno);
+            follower->dropped = true;
+        }
+    }
+    followers_.erase(std::remove(followers_.begin(), followers_.end(), follower), followers_.end());
+    status = follower->dropped ? static_cast<int32_t>(DumpStatus::DUMP_FAIL) : status_;
+    cond_.notify_all();
+    lock.unlock();
+    CloseFd(clientFd);
+    return true;
+}
+
+void OutputFanout::Finish(int32_t status)
+{
+    // the write end belongs to the request, the relay ends when it is closed.
+    writeFd_ = -1;
+    if (relay_.joinable()) {
+        relay_.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (finished_) {
+        return;
+    }
+    CloseFd(leaderFd_);
+    leaderFd_ = -1;
+    CloseFd(readFd_);
+    readFd_ = -1;
+    status_ = status;
+    finished_ = true;
+    std::string().swap(replay_);
+    cond_.notify_all();
+}
+
+void OutputFanout::Run()
+{
+    std::vector<char> buffer(RELAY_BUFFER_SIZE);
+    while (true) {
+        ssize_t readLen = TEMP_FAILURE_RETRY(read(readFd_, buffer.data(), buffer.size()));
+        if (readLen <= 0) {
+            break;
+        }
+        Forward(buffer.data(), static_cast<size_t>(readLen));
+    }
+}
+
+void OutputFanout::Forward(const char* data, size_t size)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!replayDropped_ && replay_.size() + size > replayLimit_) {
+            // too late for new clients to catch up, the attached ones have their own copy.
+            replayDropped_ = true;
+            std::string().swap(replay_);
+        }
+        if (!replayDropped_) {
+            replay_.append(data, size);
+        }
+        for (auto &follower : followers_) {
+            if (follower->dropped) {
+                continue;
+            }
+            if (follower->pending.size() + size > replayLimit_) {
+                DUMPER_HILOGW(MODULE_SERVICE, "follower dropped, %{public}zu bytes behind", follower->pending.size());
+                follower->dropped = true;
+                std::string().swap(follower->pending);
+                continue;
+            }
+            follower->pending.append(data, size);
+        }
+        if (!followers_.empty()) {
+            cond_.notify_all();
+        }
+    }
+    // only the relay writes to the leader and only Finish closes it after the relay ends,
+    // so the fd stays valid without the lock.
+    if (leaderFd_ >= 0 && !WriteAll(leaderFd_, data, size)) {
+        DUMPER_HILOGD(MODULE_SERVICE, "leader fd %{public}d gone, errno=%{public}d", leaderFd_, errno);
+        CloseFd(leaderFd_);
+        leaderFd_ = -1;
+    }
+}
+
+bool OutputFanout::WriteAll(int fd, const char* data, size_t size)
+{
+    size_t written = 0;
+    while (written < size) {
+        ssize_t ret = TEMP_FAILURE_RETRY(write(fd, data + written, size - written));
+        if (ret <= 0) {
+            return false;
+        }
+        written += static_cast<size_t>(ret);
+    }
+    return true;
+}
+
+void OutputFanout::CloseFd(int fd)
+{
+    if (fd < 0) {
+        return;
+    }
+    fdsan_exchange_owner_tag(fd, 0, FDTAG);
+    fdsan_close_with_tag(fd, FDTAG);
+}
+} // namespace HiviewDFX
+} // namespace OHOS
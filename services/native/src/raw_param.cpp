@@ -14,6 +14,7 @@
  */
 #include "raw_param.h"
 #include <cinttypes>
+#include <poll.h>
 #include <thread>
 #include <securec.h>
 #include <string_ex.h>
@@ -29,6 +30,9 @@ static const bool SHOW_PROGRESS_BAR = false;
 static const int PROGRESS_LENGTH = 128;
 static const char PROGRESS_STYLE = '=';
 static const char PROGRESS_TICK[] = {'-', '\\', '|', '/'};
+// frames are coalesced to at most one per interval, the spinner alone is redrawn less often.
+static constexpr std::chrono::milliseconds PROGRESS_MIN_INTERVAL {100};
+static constexpr std::chrono::milliseconds PROGRESS_TICK_INTERVAL {500};
 } // namespace
 
 RawParam::RawParam(int calllingUid, int calllingPid, uint32_t reqId, std::vector<std::u16string> &args, int outfd)
@@ -153,6 +157,11 @@ bool RawParam::IsProgressEnabled() const
     return progressEnabled_;
 }
 
+void RawParam::SetProgressMode(ProgressMode mode)
+{
+    progressMode_ = mode;
+}
+
 void RawParam::SetTitle(const std::string &path)
 {
     path_ = path;
@@ -168,6 +177,16 @@ std::string RawParam::GetFolder()
     return folder_;
 }
 
+void RawParam::SetStagingArea(const std::shared_ptr<DumpStagingArea> &stagingArea)
+{
+    stagingArea_ = stagingArea;
+}
+
+std::shared_ptr<DumpStagingArea> RawParam::GetStagingArea()
+{
+    return stagingArea_;
+}
+
 void RawParam::SetCallerPpid(const std::string &ppid)
 {
     StrToInt(ppid, callerPpid_);
@@ -191,21 +210,101 @@ void RawParam::UpdateProgress(uint64_t progress)
     if ((!progressEnabled_) || (outfd_ < 0) || (progress > FINISH)) {
         return;
     }
+    std::lock_guard<std::mutex> lock(progressMutex_);
     progress_ = std::max(progress, progress_);
     progressTick_ = (progressTick_ + 1) % sizeof(PROGRESS_TICK);
-    if (SHOW_PROGRESS_BAR) {
+    bool finished = (progress_ == FINISH);
+    auto now = std::chrono::steady_clock::now();
+    if (!ShouldReportProgress(finished, now)) {
+        return;
+    }
+    // a frame that finds the client pipe full is dropped, a newer one follows. the last frame always goes out.
+    if (!WriteProgress(RenderProgress(finished), finished)) {
+        return;
+    }
+    reportedProgress_ = progress_;
+    progressReported_ = true;
+    finishReported_ = finished;
+    reportTime_ = now;
+}
+
+void RawParam::ReportTrace(const std::string &tracePath)
+{
+    if ((outfd_ < 0) || tracePath.empty()) {
+        return;
+    }
+    // after the last progress frame, the trace is only complete once the dump has finished.
+    std::lock_guard<std::mutex> lock(progressMutex_);
+    if (progressMode_ == ProgressMode::MACHINE) {
+        WriteProgress("trace:" + tracePath + "\n", true);
+    } else {
+        WriteProgress("The trace is:" + tracePath + "\n", true);
+    }
+}
+
+bool RawParam::ShouldReportProgress(bool finished, std::chrono::steady_clock::time_point now) const
+{
+    if (finished) {
+        return !finishReported_;
+    }
+    if (!progressReported_) {
+        return true;
+    }
+    auto elapsed = now - reportTime_;
+    if (elapsed < PROGRESS_MIN_INTERVAL) {
+        return false;
+    }
+    if (progress_ != reportedProgress_) {
+        return true;
+    }
+    return (progressMode_ == ProgressMode::TERMINAL) && (elapsed >= PROGRESS_TICK_INTERVAL);
+}
+
+std::string RawParam::RenderProgress(bool finished)
+{
+    char frame[PROGRESS_LENGTH * 2] = {0};
+    int len = 0;
+    if (progressMode_ == ProgressMode::MACHINE) {
+        len = snprintf_s(frame, sizeof(frame), sizeof(frame) - 1, "progress:%" PRIu64 "\n", progress_);
+    } else if (SHOW_PROGRESS_BAR) {
         char barbuf[PROGRESS_LENGTH + 1] = {0};
         for (size_t i = 0; ((i < progress_) && (i < PROGRESS_LENGTH)); i++) {
             barbuf[i] = PROGRESS_STYLE;
         }
-        dprintf(outfd_, "\033[?25l\r[%-100s],%2" PRIu64 "%%,[%c]\033[?25h",
+        len = snprintf_s(frame, sizeof(frame), sizeof(frame) - 1, "\033[?25l\r[%-100s],%2" PRIu64 "%%,[%c]\033[?25h",
             barbuf, progress_, PROGRESS_TICK[progressTick_]);
     } else {
-        dprintf(outfd_, "\033[?25l\r%2" PRIu64 "%%,[%c]\033[?25h", progress_, PROGRESS_TICK[progressTick_]);
+        len = snprintf_s(frame, sizeof(frame), sizeof(frame) - 1, "\033[?25l\r%2" PRIu64 "%%,[%c]\033[?25h",
+            progress_, PROGRESS_TICK[progressTick_]);
+    }
+    std::string result = (len > 0) ? std::string(frame, len) : "";
+    if (finished) {
+        result += path_ + "\n";
     }
-    if (progress_ == FINISH) {
-        dprintf(outfd_, "%s\n", path_.c_str());
+    return result;
+}
+
+bool RawParam::WriteProgress(const std::string &frame, bool wait)
+{
+    if (frame.empty()) {
+        return false;
+    }
+    if (!wait) {
+        // frames are shorter than PIPE_BUF, so a writable pipe takes the whole frame without blocking.
+        struct pollfd pfd = {outfd_, POLLOUT, 0};
+        if ((TEMP_FAILURE_RETRY(poll(&pfd, 1, 0)) <= 0) || ((pfd.revents & POLLOUT) == 0)) {
+            return false;
+        }
     }
+    size_t written = 0;
+    while (written < frame.size()) {
+        ssize_t ret = TEMP_FAILURE_RETRY(write(outfd_, frame.data() + written, frame.size() - written));
+        if (ret <= 0) {
+            return false;
+        }
+        written += static_cast<size_t>(ret);
+    }
+    return true;
 }
 
 RawParam::ClientDeathRecipient::ClientDeathRecipient(uint32_t reqId, bool &deathed) : reqId_(reqId), deathed_(deathed)
@@ -222,6 +321,7 @@ void RawParam::ClientDeathRecipient::OnRemoteDied(const wptr<IRemoteObject> &rem
     }
     DUMPER_HILOGD(MODULE_SERVICE, "enter|reqId=%{public}d", reqId_);
     deathed_ = true;
+    dumpManagerService->NotifyRequestCanceled();
     DUMPER_HILOGD(MODULE_SERVICE, "leave|reqId=%{public}d", reqId_);
 }
 
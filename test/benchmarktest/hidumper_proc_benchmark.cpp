@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <fcntl.h>
+#include <memory>
+#include <unistd.h>
+#include "dump_common_utils.h"
+#include "executor/fd_thread_dumper.h"
+#include "executor/memory/dma_info.h"
+#include "executor/memory/memory_filter.h"
+#include "executor/memory/memory_info.h"
+#include "executor/memory/parse/parse_ashmem_info.h"
+#include "executor/memory/parse/parse_dmabuf_info.h"
+#include "executor/memory/parse/parse_meminfo.h"
+#include "executor/memory/parse/parse_smaps_info.h"
+#include "executor/memory/parse/parse_smaps_rollup_info.h"
+#include "executor/memory/parse/parse_vmallocinfo.h"
+#include "proc_fixture.h"
+#include "util/file_utils.h"
+
+using namespace std;
+using namespace OHOS::HiviewDFX;
+namespace {
+const string FIXTURE_ROOT = "/data/local/tmp/hidumper_proc_fixture";
+
+/**
+ * Points the proc root at a fixture tree of spec for one benchmark, the tree is kept for the next benchmark
+ * with the same spec since generating it costs far more than reading it.
+ */
+class ProcTreeBenchmark : public benchmark::Fixture {
+public:
+    void TearDown(const benchmark::State &) override
+    {
+        FileUtils::GetInstance().SetProcRoot("");
+    }
+
+protected:
+    bool Prepare(benchmark::State &state, const ProcFixture::Spec &spec)
+    {
+        static unique_ptr<ProcFixture> fixture;
+        static ProcFixture::Spec fixtureSpec;
+        if (fixture == nullptr || !IsSameSpec(spec, fixtureSpec)) {
+            fixture = make_unique<ProcFixture>(FIXTURE_ROOT, spec);
+            fixtureSpec = spec;
+            if (!fixture->Generate()) {
+                fixture = nullptr;
+                state.SkipWithError("generate the fixture tree failed");
+                return false;
+            }
+        }
+        FileUtils::GetInstance().SetProcRoot(FIXTURE_ROOT);
+        pids_ = fixture->GetPids();
+        return true;
+    }
+
+    static bool IsSameSpec(const ProcFixture::Spec &first, const ProcFixture::Spec &second)
+    {
+        return first.processCount == second.processCount && first.vmaCount == second.vmaCount &&
+            first.threadCount == second.threadCount && first.fdCount == second.fdCount &&
+            first.ashmemCount == second.ashmemCount && first.dmabufCount == second.dmabufCount &&
+            first.firstPid == second.firstPid && first.seed == second.seed;
+    }
+
+    vector<int32_t> pids_;
+};
+
+ProcFixture::Spec ProcessSpec(int64_t processCount)
+{
+    ProcFixture::Spec spec;
+    spec.processCount = static_cast<int32_t>(processCount);
+    return spec;
+}
+} // namespace
+
+BENCHMARK_DEFINE_F(ProcTreeBenchmark, ParseMeminfo)(benchmark::State &state)
+{
+    if (!Prepare(state, ProcessSpec(1))) {
+        return;
+    }
+    ParseMeminfo parser;
+    for (auto _ : state) {
+        ParseMeminfo::ValueMap result;
+        benchmark::DoNotOptimize(parser.GetMeminfo(result));
+    }
+}
+BENCHMARK_REGISTER_F(ProcTreeBenchmark, ParseMeminfo);
+
+BENCHMARK_DEFINE_F(ProcTreeBenchmark, ParseVmallocinfo)(benchmark::State &state)
+{
+    if (!Prepare(state, ProcessSpec(1))) {
+        return;
+    }
+    ParseVmallocinfo parser;
+    for (auto _ : state) {
+        uint64_t value = 0;
+        benchmark::DoNotOptimize(parser.GetVmallocinfo(value));
+    }
+}
+BENCHMARK_REGISTER_F(ProcTreeBenchmark, ParseVmallocinfo);
+
+// range(0) is the count of vmas in the smaps of one process.
+BENCHMARK_DEFINE_F(ProcTreeBenchmark, ParseSmapsInfo)(benchmark::State &state)
+{
+    ProcFixture::Spec spec = ProcessSpec(1);
+    spec.vmaCount = static_cast<int32_t>(state.range(0));
+    if (!Prepare(state, spec)) {
+        return;
+    }
+    for (auto _ : state) {
+        ParseSmapsInfo parser;
+        ParseSmapsInfo::GroupMap nativeMap;
+        ParseSmapsInfo::GroupMap result;
+        benchmark::DoNotOptimize(parser.GetInfo(MemoryFilter::MemoryType::APPOINT_PID, pids_[0], nativeMap, result));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ProcTreeBenchmark, ParseSmapsInfo)->Arg(100)->Arg(1000)->Arg(10000);
+
+// range(0) is the count of processes, every one of them is read.
+BENCHMARK_DEFINE_F(ProcTreeBenchmark, ParseSmapsRollupInfo)(benchmark::State &state)
+{
+    if (!Prepare(state, ProcessSpec(state.range(0)))) {
+        return;
+    }
+    ParseSmapsRollupInfo parser;
+    for (auto _ : state) {
+        for (auto pid : pids_) {
+            MemInfoData::MemInfo memInfo;
+            benchmark::DoNotOptimize(parser.GetMemInfo(pid, memInfo));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ProcTreeBenchmark, ParseSmapsRollupInfo)->Arg(100)->Arg(500);
+
+// range(0) is the count of processes, range(1) the count of ashmem regions of each.
+BENCHMARK_DEFINE_F(ProcTreeBenchmark, ParseAshmemInfo)(benchmark::State &state)
+{
+    ProcFixture::Spec spec = ProcessSpec(state.range(0));
+    spec.ashmemCount = static_cast<int32_t>(state.range(1));
+    if (!Prepare(state, spec)) {
+        return;
+    }
+    ParseAshmemInfo parser;
+    for (auto _ : state) {
+        pair<int, vector<string>> result;
+        benchmark::DoNotOptimize(parser.GetAshmemInfo(pids_.back(), result));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+BENCHMARK_REGISTER_F(ProcTreeBenchmark, ParseAshmemInfo)->Args({100, 16})->Args({500, 64});
+
+// range(0) is the count of dmabuf buffers of the process.
+BENCHMARK_DEFINE_F(ProcTreeBenchmark, ParseDmaBufInfo)(benchmark::State &state)
+{
+    ProcFixture::Spec spec = ProcessSpec(1);
+    spec.dmabufCount = static_cast<int32_t>(state.range(0));
+    if (!Prepare(state, spec)) {
+        return;
+    }
+    ParseDmaBufInfo parser;
+    for (auto _ : state) {
+        vector<string> result;
+        unordered_map<string, int> headerMap;
+        vector<int> columnWidths;
+        vector<string> titles;
+        benchmark::DoNotOptimize(parser.GetDmaBufInfo(pids_[0], result, headerMap, columnWidths, titles));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ProcTreeBenchmark, ParseDmaBufInfo)->Arg(64)->Arg(4096);
+
+// range(0) is the count of processes, range(1) the count of dmabuf buffers of each.
+BENCHMARK_DEFINE_F(ProcTreeBenchmark, DmaInfo)(benchmark::State &state)
+{
+    ProcFixture::Spec spec = ProcessSpec(state.range(0));
+    spec.dmabufCount = static_cast<int32_t>(state.range(1));
+    if (!Prepare(state, spec)) {
+        return;
+    }
+    for (auto _ : state) {
+        DmaInfo dmaInfo;
+        benchmark::DoNotOptimize(dmaInfo.ParseDmaInfo());
+        benchmark::DoNotOptimize(dmaInfo.GetTotalDma());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+BENCHMARK_REGISTER_F(ProcTreeBenchmark, DmaInfo)->Args({100, 16})->Args({500, 64});
+
+// range(0) is the count of processes, enumerated from the proc root with getdents64.
+BENCHMARK_DEFINE_F(ProcTreeBenchmark, GetAllPids)(benchmark::State &state)
+{
+    if (!Prepare(state, ProcessSpec(state.range(0)))) {
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(DumpCommonUtils::GetAllPids());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ProcTreeBenchmark, GetAllPids)->Arg(500)->Arg(3000);
+
+// the readdir enumeration GetAllPids replaced, on the same tree.
+BENCHMARK_DEFINE_F(ProcTreeBenchmark, GetSubDirPids)(benchmark::State &state)
+{
+    if (!Prepare(state, ProcessSpec(state.range(0)))) {
+        return;
+    }
+    const string procPath = FileUtils::GetInstance().GetProcPath("/proc");
+    for (auto _ : state) {
+        vector<int32_t> pids;
+        for (const auto &name : DumpCommonUtils::GetSubDir(procPath, true)) {
+            pids.push_back(static_cast<int32_t>(strtol(name.c_str(), nullptr, 10)));
+        }
+        benchmark::DoNotOptimize(pids);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ProcTreeBenchmark, GetSubDirPids)->Arg(500)->Arg(3000);
+
+// range(0) is the count of processes.
+BENCHMARK_DEFINE_F(ProcTreeBenchmark, GetUserPids)(benchmark::State &state)
+{
+    if (!Prepare(state, ProcessSpec(state.range(0)))) {
+        return;
+    }
+    for (auto _ : state) {
+        vector<int> pids;
+        benchmark::DoNotOptimize(DumpCommonUtils::GetUserPids(pids));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ProcTreeBenchmark, GetUserPids)->Arg(100)->Arg(500);
+
+// range(0) is the count of processes.
+BENCHMARK_DEFINE_F(ProcTreeBenchmark, GetPidInfos)(benchmark::State &state)
+{
+    if (!Prepare(state, ProcessSpec(state.range(0)))) {
+        return;
+    }
+    for (auto _ : state) {
+        vector<DumpCommonUtils::PidInfo> infos;
+        benchmark::DoNotOptimize(DumpCommonUtils::GetPidInfos(infos, true));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ProcTreeBenchmark, GetPidInfos)->Arg(100)->Arg(500);
+
+// hidumper --fd PID, range(0) is the count of fds of the process.
+BENCHMARK_DEFINE_F(ProcTreeBenchmark, DumpFd)(benchmark::State &state)
+{
+    ProcFixture::Spec spec = ProcessSpec(1);
+    spec.fdCount = static_cast<int32_t>(state.range(0));
+    if (!Prepare(state, spec)) {
+        return;
+    }
+    DumperOpts opts;
+    opts.isDumpFd_ = true;
+    opts.processPid_ = pids_[0];
+    auto parameter = make_shared<DumperParameter>();
+    parameter->SetOpts(opts);
+    for (auto _ : state) {
+        auto dumpDatas = make_shared<vector<vector<string>>>();
+        FdThreadDumper dumper;
+        dumper.PreExecute(parameter, dumpDatas);
+        benchmark::DoNotOptimize(dumper.Execute());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ProcTreeBenchmark, DumpFd)->Arg(1000)->Arg(10000);
+
+// hidumper --thread PID, range(0) is the count of threads of the process.
+BENCHMARK_DEFINE_F(ProcTreeBenchmark, DumpThread)(benchmark::State &state)
+{
+    ProcFixture::Spec spec = ProcessSpec(1);
+    spec.threadCount = static_cast<int32_t>(state.range(0));
+    if (!Prepare(state, spec)) {
+        return;
+    }
+    DumperOpts opts;
+    opts.isDumpThread_ = true;
+    opts.processPid_ = pids_[0];
+    auto parameter = make_shared<DumperParameter>();
+    parameter->SetOpts(opts);
+    for (auto _ : state) {
+        auto dumpDatas = make_shared<vector<vector<string>>>();
+        FdThreadDumper dumper;
+        dumper.PreExecute(parameter, dumpDatas);
+        benchmark::DoNotOptimize(dumper.Execute());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ProcTreeBenchmark, DumpThread)->Arg(100)->Arg(2000);
+
+// hidumper --mem, range(0) is the count of processes. The graphics and kernel memory still come from the device.
+BENCHMARK_DEFINE_F(ProcTreeBenchmark, DumpMemNoPid)(benchmark::State &state)
+{
+    if (!Prepare(state, ProcessSpec(state.range(0)))) {
+        return;
+    }
+    int fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        state.SkipWithError("open /dev/null failed");
+        return;
+    }
+    for (auto _ : state) {
+        MemoryInfo memoryInfo;
+        auto result = make_shared<vector<vector<string>>>();
+        benchmark::DoNotOptimize(memoryInfo.GetMemoryInfoNoPid(fd, result));
+    }
+    close(fd);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ProcTreeBenchmark, DumpMemNoPid)->Arg(50)->Arg(200)->Unit(benchmark::kMillisecond);
+
+// hidumper --mem --prune, range(0) is the count of processes.
+BENCHMARK_DEFINE_F(ProcTreeBenchmark, DumpMemPrune)(benchmark::State &state)
+{
+    if (!Prepare(state, ProcessSpec(state.range(0)))) {
+        return;
+    }
+    int fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        state.SkipWithError("open /dev/null failed");
+        return;
+    }
+    for (auto _ : state) {
+        MemoryInfo memoryInfo;
+        auto result = make_shared<vector<vector<string>>>();
+        benchmark::DoNotOptimize(memoryInfo.GetMemoryInfoPrune(fd, result));
+    }
+    close(fd);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ProcTreeBenchmark, DumpMemPrune)->Arg(50)->Arg(200)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+#include "util/text_sanitizer.h"
+#include "util/zip/zip_writer.h"
+
+using namespace std;
+using namespace OHOS::HiviewDFX;
+namespace {
+const string ZIP_FOLDER = "/data/local/tmp/hidumper_zip_bench";
+const char ASCII_CR = '\r';
+const char ASCII_LF = '\n';
+const char ASCII_ESC = '\033';
+const char ASCII_OB = '[';
+const char ASCII_UA = 'A';
+const char ASCII_LA = 'a';
+const char ASCII_UZ = 'Z';
+const char ASCII_LZ = 'z';
+
+/**
+ * Writes the files a zip dump typically packs, small logs, a few large text files and already compressed ones.
+ */
+class ZipWriterBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State &) override
+    {
+        (void)system(("rm -rf " + ZIP_FOLDER + " && mkdir -p " + ZIP_FOLDER).c_str());
+        const size_t sizes[] = {0, 100, 4096, 256 * 1024, 256 * 1024 + 1, 3 * 1024 * 1024};
+        zipItems_.clear();
+        totalSize_ = 0;
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            string name = "file_" + to_string(i) + ((i % 2 == 0) ? ".txt" : ".gz");
+            FILE *fp = fopen((ZIP_FOLDER + "/" + name).c_str(), "w");
+            if (fp == nullptr) {
+                continue;
+            }
+            for (size_t n = 0; n < sizes[i]; n++) {
+                fputc('a' + static_cast<int>(n % 26), fp);
+            }
+            (void)fclose(fp);
+            zipItems_.push_back(make_pair(ZIP_FOLDER + "/" + name, name));
+            totalSize_ += sizes[i];
+        }
+    }
+
+    void TearDown(const benchmark::State &) override
+    {
+        (void)system(("rm -rf " + ZIP_FOLDER).c_str());
+    }
+
+protected:
+    vector<pair<string, string>> zipItems_;
+    size_t totalSize_ {0};
+};
+
+// the byte by byte filter FileFormatDumpFilter and IoTopInfoTask used before TextSanitizer, kept as the baseline.
+void LegacyFilterControlChar(std::string &str)
+{
+    std::string newStr;
+
+    bool skip = false;
+    const size_t sum = str.size();
+    for (size_t pos = 0; pos < sum; pos++) {
+        char &c = str.at(pos);
+
+        if ((!skip) && (c == ASCII_ESC) && ((pos + 1) < sum)) {
+            char &next_c = str.at(pos + 1);
+            skip = (next_c == ASCII_OB);
+        }
+
+        if (skip && (((c >= ASCII_UA) && (c <= ASCII_UZ)) || ((c >= ASCII_LA) && (c <= ASCII_LZ)))) {
+            skip = false;
+            continue;
+        }
+
+        if (skip || (c == ASCII_CR) || (c == ASCII_LF)) {
+            continue;
+        }
+
+        newStr.append(1, c);
+    }
+
+    str = newStr;
+}
+
+/**
+ * A command output of 128 byte lines, every 16th line is colored with an escape sequence.
+ */
+class TextSanitizerBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State &) override
+    {
+        const size_t lineSize = 128;
+        const size_t lineCount = 8192;
+        const size_t colorEvery = 16;
+        text_.clear();
+        for (size_t i = 0; i < lineCount; i++) {
+            string line = (i % colorEvery == 0) ? "\033[1;31m" : "";
+            line.append(lineSize - line.size() - 1, 'a' + static_cast<char>(i % 26));
+            text_.append(line).append(1, '\n');
+        }
+    }
+
+protected:
+    string text_;
+};
+} // namespace
+
+BENCHMARK_DEFINE_F(TextSanitizerBenchmark, Sanitize)(benchmark::State &state)
+{
+    for (auto _ : state) {
+        string str = text_;
+        TextSanitizer::Sanitize(str);
+        benchmark::DoNotOptimize(str.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text_.size()));
+}
+BENCHMARK_REGISTER_F(TextSanitizerBenchmark, Sanitize);
+
+BENCHMARK_DEFINE_F(TextSanitizerBenchmark, LegacyFilter)(benchmark::State &state)
+{
+    for (auto _ : state) {
+        string str = text_;
+        LegacyFilterControlChar(str);
+        benchmark::DoNotOptimize(str.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text_.size()));
+}
+BENCHMARK_REGISTER_F(TextSanitizerBenchmark, LegacyFilter);
+
+BENCHMARK_DEFINE_F(ZipWriterBenchmark, Write)(benchmark::State &state)
+{
+    const string zipPath = ZIP_FOLDER + "/hidumper_bench.zip";
+    for (auto _ : state) {
+        ZipWriter zipWriter(zipPath);
+        if (!zipWriter.Open() || !zipWriter.Write(zipItems_)) {
+            state.SkipWithError("write the zip failed");
+            return;
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(totalSize_));
+}
+BENCHMARK_REGISTER_F(ZipWriterBenchmark, Write)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
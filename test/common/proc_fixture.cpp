@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "proc_fixture.h"
+#include <cerrno>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr uint64_t PAGE_KB = 4;
+constexpr uint64_t VMA_BASE = 0x5500000000;
+constexpr uint64_t VMA_GAP = 0x1000;
+constexpr uint64_t KB_TO_BYTE = 1024;
+constexpr uint64_t MEM_TOTAL_KB = 12 * 1024 * 1024;
+constexpr int32_t APP_UID_BASE = 20010000;
+constexpr int32_t SYSTEM_UID = 1000;
+constexpr int32_t VMALLOC_COUNT = 4000;
+constexpr int32_t START_TIME_FIELD = 19; // after the comm of /proc/pid/task/tid/stat
+constexpr int32_t STAT_FIELD_COUNT = 50;
+constexpr size_t LINE_BUF_SIZE = 256;
+constexpr int APP_INTERVAL = 2; // every second process is an app
+const char *const VMA_NAMES[] = {
+    "[anon:native_heap:jemalloc]", "[anon:native_heap:jemalloc meta]", "[anon:ArkTS Heap]", "[stack]", "[heap]",
+    "/system/lib64/libc.so", "/system/lib64/libc++.so", "/system/lib64/platformsdk/libace_compatible.z.so",
+    "/system/lib64/libark_jsruntime.so", "/dev/ashmem/SharedBlock (deleted)", "/dev/dri/renderD128",
+    "/data/storage/el1/bundle/entry.hap", "/system/fonts/HarmonyOS_Sans.ttf", "[anon:libc_malloc]", "",
+};
+const char *const VMA_PERMS[] = {"r--p", "r-xp", "rw-p", "rw-s", "---p"};
+// '#' is replaced by a number, so that the same kind of fds point to several files.
+const char *const FD_TARGETS[] = {
+    "socket:[#]", "pipe:[#]", "anon_inode:[eventfd]", "anon_inode:[eventpoll]", "anon_inode:sync_file",
+    "/dmabuf:#", "/dev/ashmem", "/data/storage/el2/base/files/log#.txt", "/system/lib64/libace_compatible.z.so",
+    "/dev/binder",
+};
+constexpr int32_t FD_TARGET_SPREAD = 50;
+const char *const THREAD_NAMES[] = {"OS_IPC_0", "OS_IPC_1", "RSRenderThread", "EventRunner#1", "ffrt_io", "gc_thread"};
+
+template<size_t N>
+size_t CountOf(const char *const (&)[N])
+{
+    return N;
+}
+
+std::string Format(const char *format, ...) __attribute__((format(printf, 1, 2)));
+std::string Format(const char *format, ...)
+{
+    char buf[LINE_BUF_SIZE] = {0};
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    return (len < 0) ? "" : std::string(buf);
+}
+
+std::string KbLine(const char *key, uint64_t kb)
+{
+    return Format("%-16s%8" PRIu64 " kB\n", key, kb);
+}
+} // namespace
+
+ProcFixture::ProcFixture(const std::string &root, const Spec &spec) : root_(root), spec_(spec), engine_(spec.seed)
+{
+}
+
+ProcFixture::~ProcFixture()
+{
+}
+
+bool ProcFixture::Generate()
+{
+    Remove();
+    engine_.seed(spec_.seed);
+    ashmemOverview_ = "Process ashmem overview info:\n";
+    ashmemDetail_ = "Process ashmem detail info:\n"
+        "Process_name    Process_ID    fd    cnode_idx    applicant_Pid    ashmem_name    virtual_size    "
+        "physical_size    magic\n";
+    dmabufInfo_ = "Dma-buf objects usage of processes:\n"
+        "Process          pid              fd               size_bytes       ino              exp_pid          "
+        "exp_task_comm    buf_name          exp_name\n";
+    if (!MakeFolder(root_) || !MakeFolder(root_ + "/proc") || !GenerateSystem()) {
+        return false;
+    }
+    for (int32_t i = 0; i < spec_.processCount; i++) {
+        if (!GenerateProcess(i)) {
+            return false;
+        }
+    }
+    return WriteFile(root_ + "/proc/ashmem_process_info", ashmemOverview_ + ashmemDetail_) &&
+        WriteFile(root_ + "/proc/process_dmabuf_info", dmabufInfo_);
+}
+
+void ProcFixture::Remove()
+{
+    if (root_.empty() || root_ == "/") {
+        return;
+    }
+    std::string cmd = "rm -rf " + root_;
+    (void)system(cmd.c_str());
+}
+
+const std::string &ProcFixture::GetRoot() const
+{
+    return root_;
+}
+
+std::vector<int32_t> ProcFixture::GetPids() const
+{
+    std::vector<int32_t> pids;
+    for (int32_t i = 0; i < spec_.processCount; i++) {
+        pids.push_back(spec_.firstPid + i);
+    }
+    return pids;
+}
+
+std::string ProcFixture::GetProcessName(int32_t index)
+{
+    return ((index % APP_INTERVAL) == 0) ? "com.example.app" + std::to_string(index) :
+        "service" + std::to_string(index);
+}
+
+bool ProcFixture::GenerateSystem()
+{
+    const uint64_t freeKb = MEM_TOTAL_KB / 8; // 8: an eighth is free
+    const std::vector<std::pair<const char *, uint64_t>> meminfo = {
+        {"MemTotal:", MEM_TOTAL_KB}, {"MemFree:", freeKb}, {"MemAvailable:", freeKb * 3}, {"Buffers:", 8192},
+        {"Cached:", MEM_TOTAL_KB / 4}, {"SwapCached:", 4096}, {"Active:", MEM_TOTAL_KB / 3},
+        {"Inactive:", MEM_TOTAL_KB / 5}, {"Active(anon):", MEM_TOTAL_KB / 6}, {"Inactive(anon):", MEM_TOTAL_KB / 10},
+        {"Active(file):", MEM_TOTAL_KB / 6}, {"Inactive(file):", MEM_TOTAL_KB / 10}, {"Unevictable:", 65536},
+        {"Mlocked:", 65536}, {"SwapTotal:", MEM_TOTAL_KB / 2}, {"SwapFree:", MEM_TOTAL_KB / 3}, {"Dirty:", 512},
+        {"Writeback:", 0}, {"AnonPages:", MEM_TOTAL_KB / 4}, {"Mapped:", MEM_TOTAL_KB / 8}, {"Shmem:", 32768},
+        {"KReclaimable:", 131072}, {"Slab:", 262144}, {"SReclaimable:", 131072}, {"SUnreclaim:", 131072},
+        {"KernelStack:", 49152}, {"PageTables:", 98304}, {"NFS_Unstable:", 0}, {"Bounce:", 0},
+        {"WritebackTmp:", 0}, {"CommitLimit:", MEM_TOTAL_KB}, {"Committed_AS:", MEM_TOTAL_KB * 2},
+        {"VmallocTotal:", 263061440}, {"VmallocUsed:", 65536}, {"VmallocChunk:", 0}, {"CmaTotal:", 262144},
+        {"CmaFree:", 131072},
+    };
+    std::string content;
+    for (const auto &item : meminfo) {
+        content += KbLine(item.first, item.second);
+    }
+    if (!WriteFile(root_ + "/proc/meminfo", content)) {
+        return false;
+    }
+    content.clear();
+    uint64_t address = VMA_BASE;
+    for (int32_t i = 0; i < VMALLOC_COUNT; i++) {
+        uint64_t pages = Random(1, 64); // 64: pages of the largest area
+        uint64_t size = (pages + 1) * PAGE_KB * KB_TO_BYTE;
+        content += Format("0x%016" PRIx64 "-0x%016" PRIx64 " %8" PRIu64 " load_module+0x7c/0x1e0 pages=%" PRIu64
+            " vmalloc N0=%" PRIu64 "\n", address, address + size, size, pages, pages);
+        address += size;
+    }
+    if (!WriteFile(root_ + "/proc/vmallocinfo", content)) {
+        return false;
+    }
+    std::string cpuFolder = root_ + "/sys/devices/system/cpu";
+    if (!MakeFolder(root_ + "/sys") || !MakeFolder(root_ + "/sys/devices") ||
+        !MakeFolder(root_ + "/sys/devices/system") || !MakeFolder(cpuFolder)) {
+        return false;
+    }
+    for (int32_t i = 0; i < spec_.cpuCount; i++) {
+        if (!MakeFolder(cpuFolder + "/cpu" + std::to_string(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ProcFixture::GenerateProcess(int32_t index)
+{
+    const int32_t pid = spec_.firstPid + index;
+    const std::string name = GetProcessName(index);
+    const bool isApp = (index % APP_INTERVAL) == 0;
+    const std::string folder = root_ + "/proc/" + std::to_string(pid);
+    if (!MakeFolder(folder)) {
+        return false;
+    }
+    std::string rollup;
+    if (!GenerateSmaps(folder, rollup) || !WriteFile(folder + "/smaps_rollup", rollup)) {
+        return false;
+    }
+    std::string cmdline = isApp ? name : "/system/bin/" + name;
+    cmdline += std::string("\0--start\0", 9); // 9: the arguments with their terminators
+    const int32_t uid = isApp ? APP_UID_BASE + index : SYSTEM_UID;
+    const uint64_t vssPages = static_cast<uint64_t>(spec_.vmaCount) * Random(8, 64); // 8 to 64 pages each
+    std::string status = "Name:\t" + name.substr(0, 15) + "\n" + "Umask:\t0022\nState:\tS (sleeping)\n" + // 15: comm
+        Format("Tgid:\t%d\nNgid:\t0\nPid:\t%d\nPPid:\t1\nTracerPid:\t0\n", pid, pid) +
+        Format("Uid:\t%d\t%d\t%d\t%d\nGid:\t%d\t%d\t%d\t%d\n", uid, uid, uid, uid, uid, uid, uid, uid) +
+        Format("FDSize:\t%d\n", spec_.fdCount) + KbLine("VmPeak:", vssPages * PAGE_KB) +
+        KbLine("VmSize:", vssPages * PAGE_KB) + KbLine("VmRSS:", vssPages) + KbLine("VmSwap:", vssPages / 8) +
+        Format("Threads:\t%d\n", spec_.threadCount);
+    std::string statm = Format("%" PRIu64 " %" PRIu64 " %" PRIu64 " 8 0 %" PRIu64 " 0\n", vssPages,
+        vssPages / PAGE_KB, vssPages / 8, vssPages / 2); // 8, 2: shared and data parts
+    std::string adj = isApp ? std::to_string(Random(0, 10) * 100) + "\n" : "-800\n"; // 10, 100: app adj levels
+    if (!WriteFile(folder + "/cmdline", cmdline) || !WriteFile(folder + "/status", status) ||
+        !WriteFile(folder + "/statm", statm) || !WriteFile(folder + "/oom_score_adj", adj) ||
+        !GenerateThreads(folder, pid, name) || !GenerateFds(folder, pid)) {
+        return false;
+    }
+
+    uint64_t ashmemTotal = 0;
+    for (int32_t i = 0; i < spec_.ashmemCount; i++) {
+        uint64_t size = Random(1, 256) * PAGE_KB * KB_TO_BYTE; // 256: pages of the largest region
+        ashmemTotal += size;
+        ashmemDetail_ += Format("%s    %d    %d    %d    %d    dev/ashmem/SharedBlock%d    %" PRIu64 "    %" PRIu64
+            "    %d\n", name.c_str(), pid, 100 + i, pid * 16 + i, pid, i, size, size, 0x2); // 100, 16: fd and node
+    }
+    ashmemOverview_ += Format("Total ashmem  of [%s] virtual size is %" PRIu64 ", physical size is %" PRIu64 "\n",
+        name.c_str(), ashmemTotal, ashmemTotal);
+
+    std::string mmDmabuf = "Process          pid              fd               size_bytes       ino              "
+        "exp_pid          exp_task_comm    buf_name         exp_name         buf_type\n";
+    uint64_t dmabufTotal = 0;
+    for (int32_t i = 0; i < spec_.dmabufCount; i++) {
+        uint64_t size = Random(1, 1024) * PAGE_KB * KB_TO_BYTE; // 1024: pages of the largest buffer
+        uint64_t ino = static_cast<uint64_t>(pid) * 1000 + i; // 1000: buffers of a process at most
+        dmabufTotal += size;
+        std::string line = Format("%-16s %-16d %-16d %-16" PRIu64 " %-16" PRIu64 " %-16d %-16s %-16s %-16s",
+            name.substr(0, 15).c_str(), pid, 200 + i, size, ino, pid, "allocator_host", "NULL", "system"); // 200: fd
+        dmabufInfo_ += line + "\n";
+        mmDmabuf += line + " normal\n";
+    }
+    dmabufInfo_ += "Total dmabuf size of " + name.substr(0, 15) + ": " + std::to_string(dmabufTotal) + " bytes\n";
+    return WriteFile(folder + "/mm_dmabuf_info", mmDmabuf);
+}
+
+bool ProcFixture::GenerateSmaps(const std::string &folder, std::string &rollup)
+{
+    std::string smaps;
+    uint64_t address = VMA_BASE;
+    uint64_t rss = 0;
+    uint64_t pss = 0;
+    uint64_t privateDirty = 0;
+    uint64_t swap = 0;
+    for (int32_t i = 0; i < spec_.vmaCount; i++) {
+        Vma vma;
+        vma.start = address;
+        vma.sizeKb = Random(1, 256) * PAGE_KB; // 256: pages of the largest vma
+        vma.rssKb = Random(0, vma.sizeKb / PAGE_KB) * PAGE_KB;
+        vma.pssKb = vma.rssKb / Random(1, 4); // 4: sharers of a page at most
+        vma.privateDirtyKb = vma.pssKb / 2; // 2: half of the proportion is dirty
+        vma.swapKb = Random(0, 2) * PAGE_KB; // 2: pages swapped at most
+        vma.perms = VMA_PERMS[Random(0, CountOf(VMA_PERMS) - 1)];
+        vma.name = VMA_NAMES[Random(0, CountOf(VMA_NAMES) - 1)];
+        uint64_t end = vma.start + vma.sizeKb * KB_TO_BYTE;
+        uint64_t inode = (vma.name.empty() || vma.name[0] != '/') ? 0 : Random(1000, 99999); // inode range
+        smaps += Format("%012" PRIx64 "-%012" PRIx64 " %s %08x 103:04 %-10" PRIu64 " ", vma.start, end,
+            vma.perms.c_str(), 0, inode) + vma.name + "\n";
+        smaps += KbLine("Size:", vma.sizeKb) + KbLine("KernelPageSize:", PAGE_KB) + KbLine("MMUPageSize:", PAGE_KB) +
+            KbLine("Rss:", vma.rssKb) + KbLine("Pss:", vma.pssKb) + KbLine("Shared_Clean:", vma.rssKb - vma.pssKb) +
+            KbLine("Shared_Dirty:", 0) + KbLine("Private_Clean:", vma.pssKb - vma.privateDirtyKb) +
+            KbLine("Private_Dirty:", vma.privateDirtyKb) + KbLine("Referenced:", vma.rssKb) +
+            KbLine("Anonymous:", vma.privateDirtyKb) + KbLine("LazyFree:", 0) + KbLine("AnonHugePages:", 0) +
+            KbLine("ShmemPmdMapped:", 0) + KbLine("FilePmdMapped:", 0) + KbLine("Shared_Hugetlb:", 0) +
+            KbLine("Private_Hugetlb:", 0) + KbLine("Swap:", vma.swapKb) + KbLine("SwapPss:", vma.swapKb) +
+            KbLine("Locked:", 0) + "THPeligible:    0\nVmFlags: rd mr mw me ac\n";
+        rss += vma.rssKb;
+        pss += vma.pssKb;
+        privateDirty += vma.privateDirtyKb;
+        swap += vma.swapKb;
+        address = end + VMA_GAP;
+    }
+    rollup = Format("%012" PRIx64 "-%012" PRIx64 " ---p 00000000 00:00 0                          [rollup]\n",
+        VMA_BASE, address) + KbLine("Rss:", rss) + KbLine("Pss:", pss) + KbLine("Pss_Anon:", privateDirty) +
+        KbLine("Pss_File:", pss - privateDirty) + KbLine("Pss_Shmem:", 0) + KbLine("Shared_Clean:", rss - pss) +
+        KbLine("Shared_Dirty:", 0) + KbLine("Private_Clean:", pss - privateDirty) +
+        KbLine("Private_Dirty:", privateDirty) + KbLine("Referenced:", rss) + KbLine("Anonymous:", privateDirty) +
+        KbLine("Swap:", swap) + KbLine("SwapPss:", swap) + KbLine("Locked:", 0);
+    return WriteFile(folder + "/smaps", smaps);
+}
+
+bool ProcFixture::GenerateThreads(const std::string &folder, int32_t pid, const std::string &name)
+{
+    if (!MakeFolder(folder + "/task")) {
+        return false;
+    }
+    for (int32_t i = 0; i < spec_.threadCount; i++) {
+        int32_t tid = (i == 0) ? pid : pid * 100 + i; // 100: tids are apart from the pids
+        std::string comm = (i == 0) ? name.substr(0, 15) : THREAD_NAMES[Random(0, CountOf(THREAD_NAMES) - 1)];
+        std::string stat = std::to_string(tid) + " (" + comm + ")";
+        for (int32_t field = 0; field < STAT_FIELD_COUNT; field++) {
+            stat += (field == 0) ? " S" : " " + std::to_string((field == START_TIME_FIELD) ? Random(100, 900000) : 0);
+        }
+        std::string taskFolder = folder + "/task/" + std::to_string(tid);
+        if (!MakeFolder(taskFolder) || !WriteFile(taskFolder + "/stat", stat + "\n") ||
+            !WriteFile(taskFolder + "/comm", comm + "\n")) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ProcFixture::GenerateFds(const std::string &folder, int32_t pid)
+{
+    std::string fdFolder = folder + "/fd";
+    if (!MakeFolder(fdFolder)) {
+        return false;
+    }
+    for (int32_t i = 0; i < spec_.fdCount; i++) {
+        // most fds of a leaking process point to one kind of file, the rest are spread over the others.
+        size_t kind = (Random(0, 3) == 0) ? Random(0, CountOf(FD_TARGETS) - 1) : 0; // 3: a quarter
+        std::string target = FD_TARGETS[kind];
+        size_t numberPos = target.find('#');
+        if (numberPos != std::string::npos) {
+            target.replace(numberPos, 1, std::to_string(pid * FD_TARGET_SPREAD + i % FD_TARGET_SPREAD));
+        }
+        if (symlink(target.c_str(), (fdFolder + "/" + std::to_string(i)).c_str()) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t ProcFixture::Random(uint64_t min, uint64_t max)
+{
+    std::uniform_int_distribution<uint64_t> distribution(min, max);
+    return distribution(engine_);
+}
+
+bool ProcFixture::WriteFile(const std::string &path, const std::string &content)
+{
+    int fd = TEMP_FAILURE_RETRY(open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR));
+    if (fd < 0) {
+        printf("open %s failed, errno:%d\n", path.c_str(), errno);
+        return false;
+    }
+    size_t written = 0;
+    while (written < content.size()) {
+        ssize_t ret = TEMP_FAILURE_RETRY(write(fd, content.data() + written, content.size() - written));
+        if (ret <= 0) {
+            break;
+        }
+        written += static_cast<size_t>(ret);
+    }
+    close(fd);
+    return written == content.size();
+}
+
+bool ProcFixture::MakeFolder(const std::string &path)
+{
+    return (mkdir(path.c_str(), S_IRWXU) == 0) || (errno == EEXIST);
+}
+} // namespace HiviewDFX
+} // namespace OHOS
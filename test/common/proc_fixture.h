@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_PROC_FIXTURE_H
+#define HIDUMPER_PROC_FIXTURE_H
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Generates a /proc and /sys tree under a folder, for FileUtils::SetProcRoot.
+ * The same spec always generates the same files, the processes are firstPid, firstPid + 1 and so on.
+ */
+class ProcFixture {
+public:
+    struct Spec {
+        int32_t processCount {100};
+        int32_t vmaCount {200}; // smaps entries of each process
+        int32_t threadCount {8}; // of each process
+        int32_t fdCount {64}; // of each process
+        int32_t ashmemCount {4}; // ashmem regions of each process
+        int32_t dmabufCount {4}; // dmabuf buffers of each process
+        int32_t cpuCount {8};
+        int32_t firstPid {1000};
+        uint32_t seed {1};
+    };
+
+    ProcFixture(const std::string &root, const Spec &spec);
+    ~ProcFixture();
+    ProcFixture(const ProcFixture &) = delete;
+    ProcFixture &operator=(const ProcFixture &) = delete;
+
+    bool Generate();
+    void Remove();
+    const std::string &GetRoot() const;
+    std::vector<int32_t> GetPids() const;
+    static std::string GetProcessName(int32_t index);
+
+private:
+    struct Vma {
+        uint64_t start;
+        uint64_t sizeKb;
+        uint64_t rssKb;
+        uint64_t pssKb;
+        uint64_t privateDirtyKb;
+        uint64_t swapKb;
+        std::string perms;
+        std::string name;
+    };
+    bool GenerateSystem();
+    bool GenerateProcess(int32_t index);
+    bool GenerateSmaps(const std::string &folder, std::string &rollup);
+    bool GenerateThreads(const std::string &folder, int32_t pid, const std::string &name);
+    bool GenerateFds(const std::string &folder, int32_t pid);
+    uint64_t Random(uint64_t min, uint64_t max);
+    static bool WriteFile(const std::string &path, const std::string &content);
+    static bool MakeFolder(const std::string &path);
+
+private:
+    std::string root_;
+    Spec spec_;
+    std::mt19937 engine_;
+    std::string ashmemOverview_;
+    std::string ashmemDetail_;
+    std::string dmabufInfo_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_PROC_FIXTURE_H
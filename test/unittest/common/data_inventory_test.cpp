@@ -432,6 +432,28 @@ HWTEST_F(DataInventoryTest, InjectStringWithFilterEmpty, TestSize.Level1)
     std::remove(tempFile.c_str());
 }
 
+HWTEST_F(DataInventoryTest, InjectSanitizedStringBasic, TestSize.Level1)
+{
+    std::string tempFile = "sanitized_test_file.txt";
+    std::ofstream file(tempFile);
+    ASSERT_TRUE(file.is_open());
+    
+    file << "\033[1mTotal DISK READ:\033[0m 0.00 B/s\r" << std::endl;
+    file << "plain line" << std::endl;
+    file.close();
+    
+    bool result = inventory_.InjectSanitizedString(tempFile, DataId::IOTOP_INFO, true);
+    ASSERT_TRUE(result);
+    
+    auto retrievedData = inventory_.GetPtr<std::vector<std::string>>(DataId::IOTOP_INFO);
+    ASSERT_NE(retrievedData, nullptr);
+    ASSERT_EQ(retrievedData->size(), 2);
+    ASSERT_EQ((*retrievedData)[0], "Total DISK READ: 0.00 B/s");
+    ASSERT_EQ((*retrievedData)[1], "plain line");
+    
+    std::remove(tempFile.c_str());
+}
+
 HWTEST_F(DataInventoryTest, GetPtrEmptyDataId, TestSize.Level1)
 {
     auto retrievedData = inventory_.GetPtr<std::vector<std::string>>(DataId::DEVICE_INFO);
@@ -13,6 +13,10 @@
  * limitations under the License.
  */
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "dump_common_utils.h"
 using namespace std;
 using namespace testing::ext;
@@ -83,5 +87,42 @@ HWTEST_F(DumpCommonUtilsTest, FindNonSandBoxPathIndexTest, TestSize.Level3)
     printf("targetPath2 %s\n", targetPath2.c_str());
     ASSERT_TRUE(targetPath2 == "/data/storage/ela/testFd/a/mockfdLinkPath");
 }
+/**
+ * @tc.name: GetIdsInFolderTest
+ * @tc.desc: Enumerate the numeric sub directories of a fixture folder, /proc and the task folder.
+ * @tc.type: FUNC
+ */
+HWTEST_F(DumpCommonUtilsTest, GetIdsInFolderTest, TestSize.Level3)
+{
+    const string folder = "/data/local/tmp/hidumper_ids_fixture";
+    system(("rm -rf " + folder + " && mkdir -p " + folder).c_str());
+    const int idCount = 2000;
+    const int idStep = 7;
+    for (int i = idCount - 1; i >= 0; i--) {
+        ASSERT_EQ(mkdir((folder + "/" + std::to_string(i * idStep)).c_str(), S_IRWXU), 0);
+    }
+    int fd = open((folder + "/12345").c_str(), O_CREAT | O_WRONLY | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    ASSERT_EQ(mkdir((folder + "/abc").c_str(), S_IRWXU), 0);
+    ASSERT_EQ(mkdir((folder + "/99999999999").c_str(), S_IRWXU), 0);
+
+    std::vector<int32_t> ids;
+    ASSERT_TRUE(DumpCommonUtils::GetIdsInFolder(folder, ids));
+    ASSERT_EQ(ids.size(), static_cast<size_t>(idCount));
+    for (int i = 0; i < idCount; i++) {
+        ASSERT_EQ(ids[i], i * idStep);
+    }
+    std::vector<int32_t> missing;
+    ASSERT_FALSE(DumpCommonUtils::GetIdsInFolder(folder + "/not_exist", missing));
+    ASSERT_TRUE(missing.empty());
+
+    std::vector<int32_t> pids = DumpCommonUtils::GetAllPids();
+    ASSERT_TRUE(std::find(pids.begin(), pids.end(), getpid()) != pids.end());
+    ASSERT_TRUE(std::is_sorted(pids.begin(), pids.end()));
+    std::vector<int32_t> tids = DumpCommonUtils::GetAllTids(getpid());
+    ASSERT_TRUE(std::find(tids.begin(), tids.end(), getpid()) != tids.end());
+    system(("rm -rf " + folder).c_str());
+}
 } // namespace HiviewDFX
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
@@ -14,6 +14,7 @@
  */
 
 
+#include <fstream>
 #include <gtest/gtest.h>
 #include <unistd.h>
 
@@ -203,6 +204,52 @@ HWTEST_F(EventDumperTest, DumpEventInfo_FillQueryParam, TestSize.Level1)
     ASSERT_TRUE(param.queryRule.size() == 5);
 }
 
+HWTEST_F(EventDumperTest, EventQueryCallback_LimitAndFilter, TestSize.Level1)
+{
+    std::vector<HiSysEventRecord> events;
+    SetProcessKillEvents(events);
+    auto sysEvents = std::make_shared<std::vector<HiSysEventRecord>>(events);
+    EventQueryCallback unlimitedCallback;
+    unlimitedCallback.OnQuery(sysEvents);
+    ASSERT_EQ(unlimitedCallback.GetEvents().size(), events.size());
+
+    EventQueryCallback limitedCallback(2, [](const HiSysEventRecord &event) {
+        std::string processName;
+        return event.GetParamValue("PROCESS_NAME", processName) == 0 && !processName.empty();
+    });
+    limitedCallback.OnQuery(sysEvents);
+    limitedCallback.OnQuery(sysEvents);
+    auto limitedEvents = limitedCallback.GetEvents();
+    ASSERT_EQ(limitedEvents.size(), 2);
+    ASSERT_EQ(limitedEvents[0].GetTime(), 4916632892000);
+    ASSERT_EQ(limitedEvents[1].GetTime(), 4916632892000);
+
+    EventQueryCallback filteredCallback(0, [](const HiSysEventRecord &event) {
+        return event.GetTime() < 4916632891988;
+    });
+    filteredCallback.OnQuery(sysEvents);
+    ASSERT_EQ(filteredCallback.GetEvents().size(), 3);
+}
+
+HWTEST_F(EventDumperTest, DumpEventInfo_MatchFaultEvents, TestSize.Level1)
+{
+    std::vector<HiSysEventRecord> faultEvents;
+    SetFaultEvents(faultEvents);
+    constexpr char origin[] = "{\"domain_\":\"RELIABILITY\",\"name_\":\"CPP_CRASH\","
+        "\"time_\":1502965663180,\"APP_RUNNING_UNIQUE_ID\":\"2\",\"LOG_PATH\":\"/proc/cpuinfo\"}";
+    faultEvents.emplace_back(origin);
+    std::unordered_set<std::string> pkRunningIdSet = {"2"};
+    std::unordered_set<std::string> faultEventQuerySet = {"CPP_CRASH"};
+    std::vector<HiSysEventRecord> events;
+    std::shared_ptr<DumpEventInfo> dumpEventInfo = std::make_shared<DumpEventInfo>();
+    dumpEventInfo->MatchFaultEvents(faultEvents, pkRunningIdSet, faultEventQuerySet, events);
+    ASSERT_EQ(events.size(), 1);
+    faultEventQuerySet = {"SYS_FREEZE"};
+    events.clear();
+    dumpEventInfo->MatchFaultEvents(faultEvents, pkRunningIdSet, faultEventQuerySet, events);
+    ASSERT_TRUE(events.empty());
+}
+
 HWTEST_F(EventDumperTest, DumpFaultEventListByPKSuccess, TestSize.Level1)
 {
     EventQueryParam param;
@@ -212,6 +259,14 @@ HWTEST_F(EventDumperTest, DumpFaultEventListByPKSuccess, TestSize.Level1)
     std::shared_ptr<DumpEventInfo> dumpEventInfo = std::make_shared<DumpEventInfo>();
     auto result = dumpEventInfo->DumpFaultEventListByPK(events, param);
     ASSERT_TRUE(result != EventDumpResult::EVENT_DUMP_FAIL);
+
+    // with a start time the fault events are queried alongside the processkill events.
+    EventQueryParam boundedParam;
+    boundedParam.startTime_ = 1577836800000; // 2020-01-01 00:00:00 UTC
+    boundedParam.endTime_ = 0;
+    std::vector<HiSysEventRecord> boundedEvents;
+    result = dumpEventInfo->DumpFaultEventListByPK(boundedEvents, boundedParam);
+    ASSERT_TRUE(result != EventDumpResult::EVENT_DUMP_FAIL);
 }
 
 HWTEST_F(EventDumperTest, EventListDumperSuccess, TestSize.Level1)
@@ -308,5 +363,46 @@ HWTEST_F(EventDumperTest, EventDetailDumper_ReadLogsByPaths, TestSize.Level1)
     eventDetailDumper->ReadLogsByPaths(logPaths);
     ASSERT_TRUE(!eventDetailDumper->dumpDatas_->empty());
 }
+
+HWTEST_F(EventDumperTest, EventDetailDumper_PrefetchNextLog, TestSize.Level1)
+{
+    const std::string first = "/data/local/tmp/hidumper_faultlog_first";
+    const std::string missing = "/data/local/tmp/hidumper_faultlog_missing";
+    const std::string last = "/data/local/tmp/hidumper_faultlog_last";
+    std::ofstream(first) << "first line 1\nfirst line 2\n";
+    std::ofstream(last) << "last line";
+    unlink(missing.c_str());
+    auto parameter = std::make_shared<DumperParameter>();
+    auto dumpDatas = std::make_shared<std::vector<std::vector<std::string>>>();
+    std::shared_ptr<EventDetailDumper> eventDetailDumper = std::make_shared<EventDetailDumper>();
+    eventDetailDumper->PreExecute(parameter, dumpDatas);
+
+    eventDetailDumper->OpenLogFile(first);
+    eventDetailDumper->PrefetchLogFile(last);
+    int prefetchedFd = eventDetailDumper->nextFd_;
+    ASSERT_GE(prefetchedFd, 0);
+    eventDetailDumper->OpenLogFile(last);
+    ASSERT_EQ(eventDetailDumper->fd_, prefetchedFd);
+    ASSERT_EQ(eventDetailDumper->nextFd_, -1);
+    eventDetailDumper->AfterExecute();
+
+    eventDetailDumper->ReadLogsByPaths({first, missing, last});
+    std::vector<std::string> lines;
+    for (const auto &line : *dumpDatas) {
+        ASSERT_EQ(line.size(), 1u);
+        lines.push_back(line[0]);
+    }
+    const std::string title = "-------------------------------[faultlog]-------------------------------";
+    std::vector<std::string> expected = {
+        "", title, "", first, "", "first line 1", "first line 2",
+        "", title, "", missing, "", "The faultlog has been deleted by the system due to expiration.",
+        "", title, "", last, "", "last line",
+    };
+    ASSERT_EQ(lines, expected);
+    ASSERT_EQ(eventDetailDumper->nextFd_, -1);
+    eventDetailDumper->AfterExecute();
+    unlink(first.c_str());
+    unlink(last.c_str());
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
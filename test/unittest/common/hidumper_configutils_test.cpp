@@ -12,11 +12,17 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <climits>
 #include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "hidumper_configutils_test.h"
+#include "contrib/minizip/unzip.h"
 #include "dump_common_utils.h"
 #include "dumper_opts.h"
 #include "raw_param.h"
+#include "util/dump_staging_area.h"
+#include "util/zip_utils.h"
 using namespace std;
 using namespace testing::ext;
 using namespace OHOS;
@@ -335,6 +341,36 @@ HWTEST_F(HidumperConfigUtilsTest, HidumperConfigUtils012, TestSize.Level3)
     ASSERT_TRUE(ret == false);
 }
 
+/**
+ * @tc.name: HidumperConfigUtils013
+ * @tc.desc: Test the name index of dumpers and groups.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperConfigUtilsTest, HidumperConfigUtils013, TestSize.Level3)
+{
+    int index = ConfigUtils::FindDumperIndex(DUMPER_NAME);
+    ASSERT_GE(index, 0);
+    std::vector<std::shared_ptr<DumpCfg>> result;
+    ConfigUtils configUtils(nullptr);
+    ASSERT_EQ(configUtils.GetDumper(index, result, OptionArgs::Create()), DumpStatus::DUMP_OK);
+    ASSERT_FALSE(result.empty());
+    ASSERT_EQ(result[0]->name_, DUMPER_NAME);
+    ASSERT_EQ(ConfigUtils::FindDumperIndex("dumper_not_exist"), -1);
+    ASSERT_EQ(ConfigUtils::FindGroupIndex("group_not_exist"), -1);
+
+    index = ConfigUtils::FindGroupIndex(ConfigData::CONFIG_GROUP_PROCESSES_PID);
+    ASSERT_GE(index, 0);
+    const auto &members = ConfigUtils::GetGroupMembers(index);
+    ASSERT_FALSE(members.empty());
+    for (const auto &member : members) {
+        ASSERT_NE(member.type_, ConfigData::MemberType::INVALID);
+        ASSERT_GE(member.index_, 0);
+    }
+    ASSERT_TRUE(ConfigUtils::GetGroupMembers(-1).empty());
+    const int outOfRange = 10000;
+    ASSERT_TRUE(ConfigUtils::GetGroupMembers(outOfRange).empty());
+}
+
 HWTEST_F(HidumperConfigUtilsTest, HidumperZipWriter001, TestSize.Level3)
 {
     string testfile = "/data/log/hidumpertest.txt";
@@ -344,8 +380,12 @@ HWTEST_F(HidumperConfigUtilsTest, HidumperZipWriter001, TestSize.Level3)
     auto zipwriter = std::make_shared<ZipWriter>(testzipfile);
     ASSERT_TRUE(zipwriter->Open());
     ASSERT_TRUE(zipwriter->Close());
-    auto testzip = zipwriter->OpenForZipping(testfile, APPEND_STATUS_CREATE);
-    zipwriter->AddFileEntryToZip(testzip, testzipfile, testzipfile);
+    ASSERT_TRUE(zipwriter->Open());
+    std::vector<std::pair<std::string, std::string>> zipItems = {{testfile, "hidumpertest.txt"}};
+    ASSERT_TRUE(zipwriter->Write(zipItems));
+    struct stat st = {};
+    ASSERT_EQ(stat(testzipfile.c_str(), &st), 0);
+    ASSERT_GT(st.st_size, 0);
     system("rm -rf /data/log/hidumpertest.txt");
     system("rm -rf /data/log/hidumpertest.zip");
 }
@@ -358,6 +398,132 @@ HWTEST_F(HidumperConfigUtilsTest, HidumperZipWriter002, TestSize.Level3)
     ASSERT_TRUE(zipwriter->Close());
 }
 
+HWTEST_F(HidumperConfigUtilsTest, HidumperZipWriter003, TestSize.Level3)
+{
+    ASSERT_EQ(ZipWriter::GetEntryPolicy("/data/log/a.gz", 0).method, 0);
+    ASSERT_EQ(ZipWriter::GetEntryPolicy("/data/log/a.ZIP", 0).method, 0);
+    ASSERT_EQ(ZipWriter::GetEntryPolicy("/data/log/a.rawheap", 0).method, 0);
+    ASSERT_EQ(ZipWriter::GetEntryPolicy("/data/log/a.txt", 0).level, Z_DEFAULT_COMPRESSION);
+    ASSERT_EQ(ZipWriter::GetEntryPolicy("/data/log/a.txt", 8 * 1024 * 1024).level, Z_BEST_SPEED);
+
+    const string folder = "/data/log/hidumpertest";
+    system("mkdir -p /data/log/hidumpertest");
+    std::vector<std::pair<std::string, std::string>> zipItems;
+    std::vector<std::string> contents;
+    const size_t sizes[] = {0, 100, 4096, 256 * 1024, 256 * 1024 + 1, 3 * 1024 * 1024};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        string name = "file_" + std::to_string(i) + ((i % 2 == 0) ? ".txt" : ".gz");
+        string content(sizes[i], '\0');
+        for (size_t n = 0; n < sizes[i]; n++) {
+            content[n] = static_cast<char>('a' + static_cast<int>(n % 26));
+        }
+        FILE *fp = fopen((folder + "/" + name).c_str(), "w");
+        ASSERT_NE(fp, nullptr);
+        ASSERT_EQ(fwrite(content.data(), 1, content.size(), fp), content.size());
+        (void)fclose(fp);
+        zipItems.push_back(std::make_pair(folder + "/" + name, name));
+        contents.push_back(std::move(content));
+    }
+    string zipPath = folder + "/hidumpertest.zip";
+    auto zipwriter = std::make_shared<ZipWriter>(zipPath);
+    ASSERT_TRUE(zipwriter->Open());
+    ASSERT_TRUE(zipwriter->Write(zipItems));
+    ASSERT_TRUE(zipwriter->Close());
+
+    unzFile unzip = unzOpen(zipPath.c_str());
+    ASSERT_NE(unzip, nullptr);
+    std::vector<char> buffer(64 * 1024);
+    for (size_t i = 0; i < zipItems.size(); i++) {
+        ASSERT_EQ(unzLocateFile(unzip, zipItems[i].second.c_str(), 0), UNZ_OK);
+        ASSERT_EQ(unzOpenCurrentFile(unzip), UNZ_OK);
+        string unzipped;
+        int readLen = 0;
+        while ((readLen = unzReadCurrentFile(unzip, buffer.data(), buffer.size())) > 0) {
+            unzipped.append(buffer.data(), readLen);
+        }
+        ASSERT_EQ(readLen, 0);
+        ASSERT_EQ(unzCloseCurrentFile(unzip), UNZ_OK);
+        ASSERT_TRUE(unzipped == contents[i]) << zipItems[i].second;
+    }
+    ASSERT_EQ(unzClose(unzip), UNZ_OK);
+
+    zipItems.push_back(std::make_pair(folder + "/not_exist", "not_exist"));
+    auto failWriter = std::make_shared<ZipWriter>(folder + "/hidumpertest_fail.zip");
+    ASSERT_TRUE(failWriter->Open());
+    ASSERT_FALSE(failWriter->Write(zipItems));
+    ASSERT_TRUE(failWriter->Close());
+    system("rm -rf /data/log/hidumpertest");
+}
+
+HWTEST_F(HidumperConfigUtilsTest, HidumperStagingArea001, TestSize.Level3)
+{
+    const string folder = "/data/log/hidumpertest/";
+    system("mkdir -p /data/log/hidumpertest");
+    {
+        DumpStagingArea stagingArea(folder, DumpStagingArea::Backend::MEMFD, 1024);
+        ASSERT_TRUE(stagingArea.Append("log.txt", string(300, 'a')));
+        ASSERT_EQ(stagingArea.GetMemoryUsage(), 300);
+        // over the limit, the entry goes to the disk folder.
+        ASSERT_TRUE(stagingArea.Append("big.txt", string(800, 'b')));
+        ASSERT_TRUE(stagingArea.Append("nested/small.txt", "c"));
+        auto memoryEntries = stagingArea.GetMemoryEntries();
+        ASSERT_TRUE(memoryEntries.size() == 1);
+        ASSERT_EQ(memoryEntries[0].second, "log.txt");
+        ASSERT_NE(access((folder + "log.txt").c_str(), F_OK), 0);
+        struct stat st = {};
+        ASSERT_EQ(stat((folder + "big.txt").c_str(), &st), 0);
+        ASSERT_EQ(st.st_size, 800);
+
+        string zipPath = "/data/log/hidumpertest_staging.zip";
+        ASSERT_TRUE(ZipUtils::ZipFolder(folder, zipPath, nullptr, memoryEntries));
+        ASSERT_EQ(access(zipPath.c_str(), F_OK), 0);
+        unlink(zipPath.c_str());
+
+        // an fd on an entry held in memory moves the entry to disk first.
+        int fd = stagingArea.OpenEntry("log.txt");
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(stagingArea.GetMemoryUsage(), 0);
+        ASSERT_EQ(write(fd, "abc", 3), 3);
+        stagingArea.CloseEntry(fd);
+        ASSERT_TRUE(stagingArea.Append("log.txt", "end"));
+        ASSERT_TRUE(stagingArea.GetMemoryEntries().empty());
+        ASSERT_EQ(stat((folder + "log.txt").c_str(), &st), 0);
+        ASSERT_EQ(st.st_size, 306);
+    }
+    system("rm -rf /data/log/hidumpertest");
+    system("mkdir -p /data/log/hidumpertest");
+    {
+        // what is written through an fd never counts against the memory limit, it is on disk from the start.
+        DumpStagingArea stagingArea(folder, DumpStagingArea::Backend::MEMFD, 1024);
+        int fd = stagingArea.OpenEntry("sa.txt");
+        ASSERT_GE(fd, 0);
+        const string body(2000, 's');
+        ASSERT_EQ(write(fd, body.data(), body.size()), static_cast<ssize_t>(body.size()));
+        int otherFd = stagingArea.OpenEntry("sa.txt");
+        ASSERT_GE(otherFd, 0);
+        ASSERT_EQ(write(fd, "tail", 4), 4);
+        ASSERT_EQ(write(otherFd, "x", 1), 1);
+        ASSERT_TRUE(stagingArea.Append("sa.txt", "end"));
+        stagingArea.CloseEntry(otherFd);
+        stagingArea.CloseEntry(fd);
+        ASSERT_EQ(stagingArea.GetMemoryUsage(), 0);
+        ASSERT_TRUE(stagingArea.Append("other.txt", "o"));
+        ASSERT_EQ(stagingArea.GetMemoryUsage(), 1);
+        struct stat st = {};
+        ASSERT_EQ(stat((folder + "sa.txt").c_str(), &st), 0);
+        ASSERT_EQ(st.st_size, 2008);
+        auto memoryEntries = stagingArea.GetMemoryEntries();
+        ASSERT_TRUE(memoryEntries.size() == 1);
+        ASSERT_EQ(memoryEntries[0].second, "other.txt");
+    }
+    DumpStagingArea diskArea(folder, DumpStagingArea::Backend::TMPFS, 1024, folder + "not_tmpfs");
+    ASSERT_EQ(diskArea.GetBackend(), DumpStagingArea::Backend::DISK);
+    ASSERT_TRUE(diskArea.Append("disk.txt", "d"));
+    ASSERT_TRUE(diskArea.GetMemoryEntries().empty());
+    ASSERT_EQ(access((folder + "disk.txt").c_str(), F_OK), 0);
+    system("rm -rf /data/log/hidumpertest");
+}
+
 HWTEST_F(HidumperConfigUtilsTest, HidumperFileUtils001, TestSize.Level3)
 {
     auto fileutils = std::make_shared<FileUtils>();
@@ -375,6 +541,24 @@ HWTEST_F(HidumperConfigUtilsTest, HidumperFileUtils001, TestSize.Level3)
     system("rm -rf /data/log/testhidumper");
 }
 
+HWTEST_F(HidumperConfigUtilsTest, HidumperFileUtils002, TestSize.Level3)
+{
+    auto fileutils = std::make_shared<FileUtils>();
+    std::vector<char> buffer;
+    string des = "/data/log/hidumper_smaps_test";
+    int64_t bytes = fileutils->CopyProcFile("/proc/self/smaps", des, buffer);
+    ASSERT_GT(bytes, 0);
+    struct stat st = {};
+    ASSERT_EQ(stat(des.c_str(), &st), 0);
+    ASSERT_EQ(static_cast<int64_t>(st.st_size), bytes);
+    ASSERT_FALSE(buffer.empty());
+    unlink(des.c_str());
+
+    string srcNotExist = "/proc/" + std::to_string(INT_MAX) + "/smaps";
+    ASSERT_EQ(fileutils->CopyProcFile(srcNotExist, des, buffer), -1);
+    ASSERT_NE(access(des.c_str(), F_OK), 0);
+}
+
 HWTEST_F(HidumperConfigUtilsTest, HidumpCommonUtils001, TestSize.Level3)
 {
     system("mkdir /data/log/hidumpertest/");
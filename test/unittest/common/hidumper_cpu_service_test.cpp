@@ -12,6 +12,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
 #include <gtest/gtest.h>
 #include <iservice_registry.h>
 #include "dump_manager_cpu_client.h"
@@ -224,5 +225,93 @@ HWTEST_F(HidumperCpuServiceTest, HidumperCpuServiceTest009, TestSize.Level3) {
     EXPECT_FALSE(dumpManagerCpuService->SortProcInfo(p1, p2));
     EXPECT_TRUE(dumpManagerCpuService->SortProcInfo(p2, p1));
 }
+
+/**
+ * @tc.name: HidumperCpuServiceTest010
+ * @tc.desc: Test packed proc records survive the parcel and are formatted on the client side.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperCpuServiceTest, HidumperCpuServiceTest010, TestSize.Level3)
+{
+    DumpCpuData sendData;
+    sendData.dumpCPUDatas_.push_back({"Load average: 1.00"});
+    CpuProcRecord record;
+    record.pid = 1234;
+    record.minflt = 56;
+    record.majflt = 7;
+    record.totalUsage = 12.5;
+    sendData.AddProcRecord(record, "foundation");
+    sendData.AddProcRecord(record, "render_service");
+    Parcel parcel;
+    ASSERT_TRUE(sendData.Marshalling(parcel));
+
+    DumpCpuData recvData;
+    ASSERT_TRUE(recvData.ReadFromParcel(parcel));
+    ASSERT_EQ(recvData.procRecords_.size(), 2);
+    EXPECT_EQ(recvData.procRecords_[1].pid, 1234);
+    EXPECT_EQ(recvData.dumpCPUDatas_.size(), 1);
+
+    std::vector<std::vector<std::string>> lines;
+    recvData.FormatProcRecords(lines);
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_TRUE(lines[1][0].find("1234") != std::string::npos);
+    EXPECT_TRUE(lines[1][0].find("12.50%") != std::string::npos);
+    EXPECT_TRUE(lines[1][0].find("render_service") != std::string::npos);
+    EXPECT_TRUE(lines[0][0].find("render_service") == std::string::npos);
+}
+/**
+ * @tc.name: HidumperCpuServiceTest011
+ * @tc.desc: Test cpu usage sampler averages the samples inside the requested window.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperCpuServiceTest, HidumperCpuServiceTest011, TestSize.Level3)
+{
+    CpuUsageSampler sampler;
+    CpuUsageSample window;
+    ASSERT_FALSE(sampler.GetWindow(1, window));
+    const uint64_t periodMs = 1000;
+    const double userUsages[] = {0.2, 0.4, 0.6};
+    const size_t count = sizeof(userUsages) / sizeof(userUsages[0]);
+    const uint64_t nowMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    const uint64_t beginMs = nowMs - count * periodMs;
+    for (size_t i = 0; i < count; i++) {
+        auto sample = std::make_shared<CpuUsageSample>();
+        sample->startTime = beginMs + i * periodMs;
+        sample->endTime = beginMs + (i + 1) * periodMs;
+        sample->cpuInfo.userUsage = userUsages[i];
+        ProcInfo procInfo = {};
+        procInfo.pid = (i == 0) ? "1" : "2";
+        procInfo.totalUsage = 30.0;
+        sample->procInfos.push_back(procInfo);
+        sampler.AddSample(sample);
+    }
+    ASSERT_TRUE(sampler.GetWindow(1, window));
+    EXPECT_NEAR(window.cpuInfo.userUsage, 0.6, 0.001);
+    EXPECT_EQ(window.procInfos.size(), 1);
+
+    ASSERT_TRUE(sampler.GetWindow(10, window));
+    EXPECT_NEAR(window.cpuInfo.userUsage, 0.4, 0.001);
+    EXPECT_EQ(window.startTime, beginMs);
+    EXPECT_EQ(window.endTime, nowMs);
+    ASSERT_EQ(window.procInfos.size(), 2);
+    EXPECT_EQ(window.procInfos[0].pid, "2");
+    EXPECT_NEAR(window.procInfos[0].totalUsage, 20.0, 0.001);
+    EXPECT_NEAR(window.procInfos[1].totalUsage, 10.0, 0.001);
+
+    CpuUsageSampler lateSampler(periodMs);
+    auto late = std::make_shared<CpuUsageSample>();
+    late->startTime = nowMs - 2 * periodMs;
+    late->endTime = nowMs - periodMs - periodMs / 2; // a wakeup half a period late is still served
+    lateSampler.AddSample(late);
+    EXPECT_TRUE(lateSampler.GetWindow(1, window));
+
+    CpuUsageSampler staleSampler(periodMs);
+    auto stale = std::make_shared<CpuUsageSample>();
+    stale->startTime = nowMs - 4 * periodMs;
+    stale->endTime = nowMs - 3 * periodMs;
+    staleSampler.AddSample(stale);
+    EXPECT_FALSE(staleSampler.GetWindow(1, window));
+}
 } // namespace HiviewDFX
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
@@ -12,7 +12,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
 #include <fcntl.h>
+#include <thread>
 #include <gtest/gtest.h>
 #define private public
 #include "executor/memory_dumper.h"
@@ -28,9 +30,16 @@
 #include "executor/sa_dumper.h"
 #include "executor/version_dumper.h"
 #include "executor/traffic_dumper.h"
+#include "executor/column_rows_filter.h"
+#include "executor/file_format_dump_filter.h"
+#include "util/column_rows_query.h"
+#include "util/command_runner.h"
 #include "util/config_utils.h"
 #include "util/string_utils.h"
+#include "util/text_sanitizer.h"
+#include "util/trace_recorder.h"
 #include "manager/dump_implement.h"
+#include "manager/dumper_stage_pool.h"
 #undef private
 
 using namespace std;
@@ -42,6 +51,22 @@ namespace HiviewDFX {
 static std::shared_ptr<DumperParameter> g_parameter;
 static std::shared_ptr<std::vector<std::vector<std::string>>> g_dump_datas;
 static std::shared_ptr<DumpCfg> g_config;
+static constexpr uint64_t FIXTURE_RECEIVED_BYTES = 123;
+static constexpr uint64_t FIXTURE_SENT_BYTES = 456;
+
+class FixtureTrafficDumper : public TrafficDumper {
+public:
+    uint32_t queriedUid_ = 0;
+
+protected:
+    void GetUidBytes(uint32_t uid, uint64_t &receivedStats, uint64_t &sendStats) override
+    {
+        queriedUid_ = uid;
+        receivedStats = FIXTURE_RECEIVED_BYTES;
+        sendStats = FIXTURE_SENT_BYTES;
+    }
+};
+
 class HidumperDumpersTest : public testing::Test {
 public:
     static void SetUpTestCase(void);
@@ -302,6 +327,23 @@ HWTEST_F(HidumperDumpersTest, FileDumperTest005, TestSize.Level0)
     HandleDumperComon("FileStreamDumper");
 }
 
+/**
+ * @tc.name: FileDumperTest006
+ * @tc.desc: Test FileDumper hide addresses of every line in one block.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, FileDumperTest006, TestSize.Level3)
+{
+    std::string block = "  node 1: u00000000abcdef01 c00000000abcdef02 pri 0:120\n"
+        "  proc 2\n"
+        "  ref 3: u00000000abcdef03 c00000000abcdef04 s 1 w 1\n";
+    FileStreamDumper::HideAddressesInBlock(block.data(), block.size());
+    std::string expect = "  node 1: u0000000000000000 c0000000000000000 pri 0:120\n"
+        "  proc 2\n"
+        "  ref 3: u0000000000000000 c0000000000000000 s 1 w 1\n";
+    ASSERT_EQ(block, expect);
+}
+
 /**
  * @tc.name: APIDumperTest001
  * @tc.desc: Test APIDumper target is build_version.
@@ -416,6 +458,53 @@ HWTEST_F(HidumperDumpersTest, CMDDumperTest004, TestSize.Level3)
     ASSERT_EQ(ret, DumpStatus::DUMP_OK);
 }
 
+/**
+ * @tc.name: CMDDumperTest005
+ * @tc.desc: Test CommandRunner parse quote and glob without shell.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, CMDDumperTest005, TestSize.Level3)
+{
+    std::vector<std::string> args;
+    ASSERT_TRUE(CommandRunner::ParseCommand("ps -o \"TIME\" -p 1", args));
+    ASSERT_EQ(args.size(), 5);
+    ASSERT_EQ(args[2], "TIME");
+    args.clear();
+    ASSERT_TRUE(CommandRunner::ParseCommand("cat /proc/self/stat*", args));
+    ASSERT_GT(args.size(), 2);
+    args.clear();
+    ASSERT_FALSE(CommandRunner::ParseCommand("ps -ef | grep init", args));
+}
+
+/**
+ * @tc.name: CMDDumperTest006
+ * @tc.desc: Test CommandRunner read all lines and kill on timeout.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, CMDDumperTest006, TestSize.Level3)
+{
+    size_t lineCount = 0;
+    ASSERT_TRUE(CommandRunner::Run("/system/bin/seq 1 10000", [&lineCount](const std::string& line) {
+        lineCount++;
+        return true;
+    }));
+    ASSERT_EQ(lineCount, 10000);
+    const int timeoutMs = 100;
+    ASSERT_FALSE(CommandRunner::Run("/system/bin/sleep 5", [](const std::string& line) {
+        return true;
+    }, false, timeoutMs));
+    // a slow consumer does not use up the timeout, only the wait for the next output does.
+    const int consumeMs = 250;
+    std::vector<std::string> lines;
+    ASSERT_TRUE(CommandRunner::Run("/system/bin/sh -c 'echo a; sleep 0.3; echo b'",
+        [&lines, consumeMs](const std::string& line) {
+        lines.push_back(line);
+        std::this_thread::sleep_for(std::chrono::milliseconds(consumeMs));
+        return true;
+    }, false, timeoutMs));
+    ASSERT_EQ(lines, std::vector<std::string>({"a", "b"}));
+}
+
 /**
  * @tc.name: MemoryDumperTest001
  * @tc.desc: Test MemoryDumper one process has correct ret.
@@ -481,6 +570,26 @@ HWTEST_F(HidumperDumpersTest, MemoryDumperTest005, TestSize.Level1)
     ASSERT_EQ(res, DumpStatus::DUMP_OK);
 }
 
+/**
+ * @tc.name: MemoryDumperTest006
+ * @tc.desc: Test MemoryDumper keeps the memory library open across requests until it is released.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, MemoryDumperTest006, TestSize.Level1)
+{
+    MemoryDumper::ReleaseMemoryLibrary();
+    HandleMemoryDumperTest(1);
+    auto library = MemoryDumper::memoryLibrary_;
+    ASSERT_NE(library, nullptr);
+    HandleMemoryDumperTest(1);
+    ASSERT_EQ(MemoryDumper::memoryLibrary_, library);
+    MemoryDumper::ReleaseMemoryLibrary();
+    ASSERT_EQ(MemoryDumper::memoryLibrary_, nullptr);
+    library = nullptr;
+    HandleMemoryDumperTest(1);
+    ASSERT_NE(MemoryDumper::memoryLibrary_, nullptr);
+}
+
 /**
  * @tc.name: SADumperTest001
  * @tc.desc: Test SADumper no saname has correct ret.
@@ -572,6 +681,24 @@ HWTEST_F(HidumperDumpersTest, TrafficDumperTest002, TestSize.Level1)
     HandleTrafficDumperTest(-1);
 }
 
+/**
+ * @tc.name: TrafficDumperTest003
+ * @tc.desc: Test TrafficDumper prints the counters of the uid that owns the process.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, TrafficDumperTest003, TestSize.Level1)
+{
+    auto trafficDumper = std::make_shared<FixtureTrafficDumper>();
+    trafficDumper->pid_ = getpid();
+    auto dumpDatas = std::make_shared<std::vector<std::vector<std::string>>>();
+    trafficDumper->result_ = dumpDatas;
+    ASSERT_EQ(trafficDumper->Execute(), DumpStatus::DUMP_OK);
+    ASSERT_EQ(trafficDumper->queriedUid_, getuid());
+    ASSERT_EQ(dumpDatas->size(), 2);
+    ASSERT_EQ((*dumpDatas)[0][0], "Received Bytes:" + std::to_string(FIXTURE_RECEIVED_BYTES));
+    ASSERT_EQ((*dumpDatas)[1][0], "Sent Bytes:" + std::to_string(FIXTURE_SENT_BYTES));
+}
+
 /**
  * @tc.name: IpcStatDumperTest001
  * @tc.desc: Test IpcDumper dump all processes.
@@ -1142,6 +1269,26 @@ HWTEST_F(HidumperDumpersTest, PruneHeapDumperTest001, TestSize.Level1)
     ASSERT_EQ(ret, DumpStatus::DUMP_OK);
 }
 
+/**
+ * @tc.name: TopMemoryDumperTest001
+ * @tc.desc: Test the top N memory ranking command
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, TopMemoryDumperTest001, TestSize.Level1)
+{
+    char *argv[] = {
+        const_cast<char *>("hidumper"),
+        const_cast<char *>("--mem"),
+        const_cast<char *>("--top"),
+        const_cast<char *>("5"),
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]);
+    std::vector<std::u16string> args;
+    std::shared_ptr<RawParam> rawParam = std::make_shared<RawParam>(0, 1, 0, args, -1);
+    int ret = DumpImplement::GetInstance().Main(argc, argv, rawParam);
+    ASSERT_EQ(ret, DumpStatus::DUMP_OK);
+}
+
 /**
  * @tc.name: EventDumperTest001
  * @tc.desc: Test EventDumperTest001
@@ -1379,5 +1526,360 @@ HWTEST_F(HidumperDumpersTest, ArkwebJsHeapDumperTest006, TestSize.Level1)
     int ret = DumpImplement::GetInstance().Main(argc, argv, rawParam);
     ASSERT_EQ(ret, DumpStatus::DUMP_HELP);
 }
+
+/**
+ * @tc.name: DumperStagePoolTest001
+ * @tc.desc: Test staged dumpers commit the same data in the same order as the serial run.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, DumperStagePoolTest001, TestSize.Level1)
+{
+    auto createExecutors = []() {
+        std::vector<std::shared_ptr<HidumperExecutor>> executors;
+        const int chainCount = 8;
+        for (int i = 0; i < chainCount; i++) {
+            auto fileCfg = DumpCfg::Create();
+            fileCfg->class_ = DumperConstant::FILE_DUMPER;
+            fileCfg->target_ = FILE_CPUINFO;
+            auto versionCfg = DumpCfg::Create();
+            versionCfg->class_ = DumperConstant::VERSION_DUMPER;
+            auto outputCfg = DumpCfg::Create();
+            outputCfg->class_ = DumperConstant::FD_OUTPUT;
+            std::vector<std::pair<std::shared_ptr<HidumperExecutor>, std::shared_ptr<DumpCfg>>> chain = {
+                {std::make_shared<FileStreamDumper>(), fileCfg},
+                {std::make_shared<VersionDumper>(), versionCfg},
+                {std::make_shared<FileStreamDumper>(), outputCfg},
+            };
+            for (auto &item : chain) {
+                item.first->SetDumpConfig(item.second);
+                executors.push_back(item.first);
+            }
+        }
+        return executors;
+    };
+    auto serialExecutors = createExecutors();
+    auto serialDatas = std::make_shared<std::vector<std::vector<std::string>>>();
+    for (auto &executor : serialExecutors) {
+        if (executor->GetDumpConfig()->IsOutput()) {
+            continue;
+        }
+        ASSERT_EQ(executor->DoPreExecute(g_parameter, serialDatas), DumpStatus::DUMP_OK);
+        executor->DoExecute();
+        executor->DoAfterExecute();
+    }
+
+    auto stagedExecutors = createExecutors();
+    auto stagedDatas = std::make_shared<std::vector<std::vector<std::string>>>();
+    {
+        DumperStagePool stagePool(stagedExecutors, g_parameter);
+        ASSERT_TRUE(stagePool.Start());
+        for (size_t index = 0; index < stagedExecutors.size(); index++) {
+            ASSERT_EQ(stagePool.IsStaged(index), !stagedExecutors[index]->GetDumpConfig()->IsOutput());
+            stagePool.Commit(index, stagedDatas);
+        }
+    }
+    ASSERT_FALSE(serialDatas->empty());
+    ASSERT_EQ(*serialDatas, *stagedDatas);
+}
+
+/**
+ * @tc.name: DumperStagePoolTest002
+ * @tc.desc: Test a chain with a looping dumper keeps running in place.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, DumperStagePoolTest002, TestSize.Level1)
+{
+    std::vector<std::shared_ptr<HidumperExecutor>> executors;
+    std::vector<int> classes = {DumperConstant::CMD_DUMPER, DumperConstant::FILE_DUMPER, DumperConstant::FD_OUTPUT,
+        DumperConstant::FILE_DUMPER, DumperConstant::MEMORY_DUMPER, DumperConstant::FD_OUTPUT};
+    for (int cls : classes) {
+        auto cfg = DumpCfg::Create();
+        cfg->class_ = cls;
+        auto executor = std::make_shared<FileStreamDumper>();
+        executor->SetDumpConfig(cfg);
+        executors.push_back(executor);
+    }
+    executors[0]->GetDumpConfig()->loop_ = DumperConstant::LOOP;
+    DumperStagePool stagePool(executors, g_parameter);
+    ASSERT_FALSE(stagePool.Start());
+    for (size_t index = 0; index < executors.size(); index++) {
+        ASSERT_FALSE(stagePool.IsStaged(index));
+    }
+}
+/**
+ * @tc.name: RawParamProgressTest001
+ * @tc.desc: Test RawParam coalesces progress frames and always reports the finish.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, RawParamProgressTest001, TestSize.Level1)
+{
+    int fds[2] = {-1, -1};
+    ASSERT_EQ(pipe(fds), 0);
+    std::vector<std::u16string> args;
+    auto rawParam = std::make_shared<RawParam>(0, 1, 0, args, fds[1]);
+    rawParam->SetProgressEnabled(true);
+    rawParam->SetProgressMode(RawParam::ProgressMode::MACHINE);
+    rawParam->SetTitle("result:/data/log/hidumper/test.zip");
+    const uint32_t total = 1000;
+    for (uint32_t i = 0; i < total; i++) {
+        rawParam->UpdateProgress(total, i);
+    }
+    rawParam->UpdateProgress(total, total);
+    rawParam->UpdateProgress(total, total);
+    rawParam->CloseOutputFd();
+
+    std::string output;
+    char buf[1024] = {0};
+    ssize_t len = 0;
+    while ((len = read(fds[0], buf, sizeof(buf))) > 0) {
+        output.append(buf, len);
+    }
+    close(fds[0]);
+    std::vector<std::string> lines;
+    StringUtils::GetInstance().StringSplit(output, "\n", lines);
+    ASSERT_GE(lines.size(), 3);
+    ASSERT_LT(lines.size(), 20);
+    ASSERT_EQ(lines[0], "progress:0");
+    ASSERT_EQ(lines[lines.size() - 2], "progress:100");
+    ASSERT_EQ(lines.back(), "result:/data/log/hidumper/test.zip");
+}
+
+/**
+ * @tc.name: RawParamProgressTest002
+ * @tc.desc: Test RawParam drops a progress frame instead of blocking on a full pipe.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, RawParamProgressTest002, TestSize.Level1)
+{
+    int fds[2] = {-1, -1};
+    ASSERT_EQ(pipe(fds), 0);
+    int flags = fcntl(fds[1], F_GETFL);
+    ASSERT_EQ(fcntl(fds[1], F_SETFL, flags | O_NONBLOCK), 0);
+    char fill[4096] = {0};
+    while (write(fds[1], fill, sizeof(fill)) > 0) {
+    }
+    ASSERT_EQ(fcntl(fds[1], F_SETFL, flags), 0);
+
+    std::vector<std::u16string> args;
+    auto rawParam = std::make_shared<RawParam>(0, 1, 0, args, fds[1]);
+    rawParam->SetProgressEnabled(true);
+    rawParam->UpdateProgress(50);
+    ASSERT_FALSE(rawParam->progressReported_);
+    ASSERT_EQ(fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK), 0);
+    while (read(fds[0], fill, sizeof(fill)) > 0) {
+    }
+    rawParam->UpdateProgress(60);
+    ASSERT_TRUE(rawParam->progressReported_);
+    ASSERT_EQ(rawParam->reportedProgress_, 60);
+    rawParam->CloseOutputFd();
+    close(fds[0]);
+}
+
+/**
+ * @tc.name: RawParamProgressTest003
+ * @tc.desc: Test RawParam reports the trace path after the last frame and writes no title when progress is off.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, RawParamProgressTest003, TestSize.Level1)
+{
+    auto runDump = [](bool progressEnabled, RawParam::ProgressMode mode) {
+        int fds[2] = {-1, -1};
+        EXPECT_EQ(pipe(fds), 0);
+        std::vector<std::u16string> args;
+        auto rawParam = std::make_shared<RawParam>(0, 1, 0, args, fds[1]);
+        rawParam->SetProgressEnabled(progressEnabled);
+        rawParam->SetProgressMode(mode);
+        rawParam->SetTitle(progressEnabled ? "result:/data/log/hidumper/test.zip" : "");
+        rawParam->UpdateProgress(10, 10);
+        rawParam->ReportTrace("/data/log/hidumper/test.trace.json");
+        rawParam->CloseOutputFd();
+
+        std::string output;
+        char buf[1024] = {0};
+        ssize_t len = 0;
+        while ((len = read(fds[0], buf, sizeof(buf))) > 0) {
+            output.append(buf, len);
+        }
+        close(fds[0]);
+        return output;
+    };
+    ASSERT_EQ(runDump(false, RawParam::ProgressMode::TERMINAL), "The trace is:/data/log/hidumper/test.trace.json\n");
+    ASSERT_EQ(runDump(true, RawParam::ProgressMode::MACHINE),
+        "progress:100\nresult:/data/log/hidumper/test.zip\ntrace:/data/log/hidumper/test.trace.json\n");
+}
+
+/**
+ * @tc.name: ColumnRowsFilterTest001
+ * @tc.desc: Test the column rows filter projects, filters, sorts and limits a section table.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, ColumnRowsFilterTest001, TestSize.Level1)
+{
+    auto parameter = std::make_shared<DumperParameter>();
+    DumperOpts opts;
+    opts.query_ = "select PID,Name where Pss>=100 and Name~^com\\. sort Pss desc limit 2";
+    parameter->SetOpts(opts);
+    auto dumpDatas = std::make_shared<std::vector<std::vector<std::string>>>();
+    dumpDatas->push_back({"process list:"});
+    dumpDatas->push_back({"PID   Pss   Name"});
+    dumpDatas->push_back({"1     50    init"});
+    dumpDatas->push_back({"2     300   com.a"});
+    dumpDatas->push_back({"3     200   com.b --arg"});
+    dumpDatas->push_back({"4     400   com.c"});
+    dumpDatas->push_back({"5     500   foundation"});
+    dumpDatas->push_back({""});
+    dumpDatas->push_back({"end"});
+    auto filter = std::make_shared<ColumnRowsFilter>();
+    ASSERT_EQ(filter->PreExecute(parameter, dumpDatas), DumpStatus::DUMP_OK);
+    ASSERT_EQ(filter->Execute(), DumpStatus::DUMP_OK);
+    ASSERT_EQ(filter->AfterExecute(), DumpStatus::DUMP_OK);
+    std::vector<std::vector<std::string>> expected = {
+        {"process list:"}, {"PID  Name"}, {"4    com.c"}, {"2    com.a"}, {""}, {"end"}};
+    ASSERT_EQ(*dumpDatas, expected);
+
+    opts.query_ = "where Pss > abc";
+    parameter->SetOpts(opts);
+    ASSERT_EQ(filter->PreExecute(parameter, dumpDatas), DumpStatus::DUMP_FAIL);
+}
+
+/**
+ * @tc.name: ColumnRowsQueryTest001
+ * @tc.desc: Test the query keeps the cells of a table of cells and checks its expression.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, ColumnRowsQueryTest001, TestSize.Level1)
+{
+    ColumnRowsQuery query;
+    std::string errStr;
+    ASSERT_TRUE(query.Parse("select 'Total Pss' where 'Total Pss' > 2.5 sort by 'Total Pss'", errStr));
+    std::vector<std::vector<std::string>> datas = {
+        {"  PID", "  Total Pss"}, {"    1", "    9(1 in SwapPss) kB"}, {"    3", "    2(0 in SwapPss) kB"},
+        {"    5", "    4(0 in SwapPss) kB"}};
+    ASSERT_EQ(query.Apply(datas), 1);
+    std::vector<std::vector<std::string>> expected = {
+        {"  Total Pss"}, {"    4(0 in SwapPss) kB"}, {"    9(1 in SwapPss) kB"}};
+    ASSERT_EQ(datas, expected);
+
+    const std::vector<std::string> invalidExprs = {"", "limit 5", "select", "where Name ~ ([", "sort",
+        "limit 0", "select PID select Name", "where PID in (1,2", "unknown PID"};
+    for (const auto &expr : invalidExprs) {
+        ASSERT_FALSE(query.Parse(expr, errStr)) << expr;
+    }
+    DumperOpts opts;
+    opts.query_ = "where PID in (1";
+    ASSERT_FALSE(opts.CheckOptions(errStr));
+
+    // a name with blanks is told apart by the wider gaps, a row divided with words in Pss is passed through.
+    ASSERT_TRUE(query.Parse("where Pss > 50", errStr));
+    datas = {{"PID  Name     Pss"}, {"20   foo bar  5000"}, {"21   baz      40"}, {"22   a b c d e f"}};
+    ASSERT_EQ(query.Apply(datas), 1);
+    expected = {{"PID  Name     Pss"}, {"20   foo bar  5000"}, {"22   a b c d e f"}};
+    ASSERT_EQ(datas, expected);
+    ASSERT_TRUE(query.Parse("select Cmd where PID == 7", errStr));
+    datas = {{"PID Cmd"}, {"7 sh -c ls"}, {"8 init"}};
+    ASSERT_EQ(query.Apply(datas), 1);
+    expected = {{"Cmd"}, {"sh -c ls"}};
+    ASSERT_EQ(datas, expected);
+}
+
+/**
+ * @tc.name: ColumnRowsQueryTest002
+ * @tc.desc: Test the PID, Pss and Name predicates pushed down to a process collector.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, ColumnRowsQueryTest002, TestSize.Level1)
+{
+    ColumnRowsQuery query;
+    std::string errStr;
+    ASSERT_TRUE(query.Parse("where PID in (1,3,5) and pid==3 and Pss>1023.5 and Name~^com\\.", errStr));
+    auto filter = query.GetProcessFilter();
+    ASSERT_EQ(filter.pids, std::set<int32_t>({3}));
+    ASSERT_EQ(filter.minPss, 1024);
+    ASSERT_TRUE(filter.MatchPid(3));
+    ASSERT_FALSE(filter.MatchPid(1));
+    ASSERT_TRUE(filter.MatchName("com.example"));
+    ASSERT_FALSE(filter.MatchName("foundation"));
+
+    ASSERT_TRUE(query.Parse("where Name==init and Name==foundation", errStr));
+    filter = query.GetProcessFilter();
+    ASSERT_FALSE(filter.MatchPid(1));
+
+    ASSERT_TRUE(query.Parse("where 'Total Pss' > 10 sort Name", errStr));
+    ASSERT_TRUE(query.GetProcessFilter().IsEmpty());
+    ASSERT_FALSE(query.IsProcessFilterOnly());
+
+    DumperOpts opts;
+    opts.isDumpMem_ = true;
+    opts.query_ = "where Pss >= 10 and Name ~ ^com";
+    ASSERT_TRUE(opts.CheckOptions(errStr));
+    const std::vector<std::string> unappliedExprs = {"sort Pss", "select PID", "where Pss > 1 limit 3",
+        "where Pss < 10", "where Uss > 10"};
+    for (const auto &expr : unappliedExprs) {
+        opts.query_ = expr;
+        ASSERT_FALSE(opts.CheckOptions(errStr)) << expr;
+    }
+    opts.memPid_ = 1;
+    ASSERT_TRUE(opts.CheckOptions(errStr));
+}
+
+/**
+ * @tc.name: FileFormatDumpFilterTest001
+ * @tc.desc: Test the file format filter drops CR, LF and escape sequences across the scan blocks.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, FileFormatDumpFilterTest001, TestSize.Level1)
+{
+    const std::string clean(70, 'x');
+    auto dumpDatas = std::make_shared<std::vector<std::vector<std::string>>>();
+    dumpDatas->push_back({"\033[1;32mTotal\033[0m DISK READ\r\n", clean, clean + "\n" + clean});
+    dumpDatas->push_back({"\033(B", "tail\033", "\033[12", ""});
+    auto filter = std::make_shared<FileFormatDumpFilter>();
+    ASSERT_EQ(filter->PreExecute(g_parameter, dumpDatas), DumpStatus::DUMP_OK);
+    ASSERT_EQ(filter->Execute(), DumpStatus::DUMP_OK);
+    ASSERT_EQ(filter->AfterExecute(), DumpStatus::DUMP_OK);
+    std::vector<std::vector<std::string>> expected = {
+        {"Total DISK READ", clean, clean + clean}, {"\033(B", "tail\033", "", ""}};
+    ASSERT_EQ(*dumpDatas, expected);
+
+    std::string out = "head:";
+    std::string dirty = clean + "\033[7m" + clean + "\r";
+    TextSanitizer::SanitizeAppend(dirty.data(), dirty.size(), out);
+    ASSERT_EQ(out, "head:" + clean + clean);
+    ASSERT_EQ(TextSanitizer::FindDirty(dirty.data(), dirty.size()), clean.size());
+    ASSERT_TRUE(TextSanitizer::IsClean(clean));
+}
+
+/**
+ * @tc.name: TraceRecorderTest001
+ * @tc.desc: Test the spans of a session come out as Chrome trace events and nothing is kept outside a session.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, TraceRecorderTest001, TestSize.Level1)
+{
+    {
+        TraceSpan span("test", "Untraced");
+    }
+    ASSERT_TRUE(TraceRecorder::Start());
+    ASSERT_FALSE(TraceRecorder::Start());
+    ASSERT_TRUE(TraceRecorder::IsEnabled());
+    const std::string detail = "say \"hi\"\n";
+    {
+        TraceSpan span("test", "Outer", &detail);
+        std::thread worker([] {
+            TraceSpan span("test", "Worker");
+        });
+        worker.join();
+    }
+    std::string trace = TraceRecorder::Stop();
+    ASSERT_FALSE(TraceRecorder::IsEnabled());
+    ASSERT_EQ(trace.rfind("{\"traceEvents\":[", 0), 0u);
+    ASSERT_NE(trace.find("\"name\":\"Outer\",\"cat\":\"test\",\"ph\":\"X\""), std::string::npos);
+    ASSERT_NE(trace.find("\"name\":\"Worker\""), std::string::npos);
+    ASSERT_NE(trace.find("\"detail\":\"say \\\"hi\\\"\\u000a\""), std::string::npos);
+    ASSERT_NE(trace.find("\"name\":\"thread_name\""), std::string::npos);
+    ASSERT_EQ(trace.find("Untraced"), std::string::npos);
+    ASSERT_NE(trace.find("\"dropped\":0}}"), std::string::npos);
+    ASSERT_EQ(TraceRecorder::Stop(), "");
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file
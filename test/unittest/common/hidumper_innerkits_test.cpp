@@ -206,6 +206,39 @@ HWTEST_F(HiDumperInnerkitsTest, GetSharedDirtyTest001, TestSize.Level1)
     EXPECT_GE(dumpUsage->GetSharedDirty(g_pid), 0);
 }
 
+/**
+ * @tc.name: GetMemUsagesTest001
+ * @tc.desc: Test GetMemUsages with valid and invalid pids on the serial and the parallel path.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiDumperInnerkitsTest, GetMemUsagesTest001, TestSize.Level1)
+{
+    std::unique_ptr<DumpUsage> dumpUsage = std::make_unique<DumpUsage>();
+    int pids[] = {g_pid, -1};
+    DumpUsage::MemUsageRecord records[2] = {};
+    EXPECT_EQ(dumpUsage->GetMemUsages(pids, 2, DumpUsage::USAGE_FIELD_PSS, records), 1);
+    EXPECT_TRUE(records[0].success);
+    EXPECT_EQ(records[0].pid, g_pid);
+    EXPECT_GT(records[0].pss, 0);
+    EXPECT_EQ(records[0].rss, 0);
+    EXPECT_EQ(records[0].privateDirty, 0);
+    EXPECT_FALSE(records[1].success);
+    EXPECT_EQ(dumpUsage->GetMemUsages(pids, 0, DumpUsage::USAGE_FIELD_ALL, records), 0);
+
+    std::vector<int> batch(DumpUsage::PARALLEL_MIN_PIDS * 2);
+    for (size_t i = 0; i < batch.size(); i++) {
+        batch[i] = (i % 2 == 0) ? g_pid : -1;
+    }
+    std::vector<DumpUsage::MemUsageRecord> batchRecords(batch.size());
+    size_t ret = dumpUsage->GetMemUsages(batch.data(), batch.size(), DumpUsage::USAGE_FIELD_ALL,
+        batchRecords.data());
+    EXPECT_EQ(ret, batch.size() / 2);
+    for (size_t i = 0; i < batch.size(); i++) {
+        EXPECT_EQ(batchRecords[i].success, i % 2 == 0);
+    }
+    EXPECT_GT(batchRecords[0].rss, 0);
+}
+
 /**
  * @tc.name: GetCpuUsage001
  * @tc.desc: Test GetCpuUsage.
@@ -13,15 +13,21 @@
  * limitations under the License.
  */
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <fcntl.h>
+#include <fstream>
 #include <iostream>
 #include <map>
 #include <sstream>
 #include <unistd.h>
 #include <vector>
+#include "dump_common_utils.h"
 #include "dump_utils.h"
 #include "executor/memory/get_hardware_info.h"
 #include "executor/memory/get_process_info.h"
 #include "executor/memory/get_kernel_info.h"
+#include "executor/memory/graphics_memory_provider.h"
+#include "executor/memory/kernel_counter_reader.h"
 #include "executor/memory/memory_info.h"
 #include "executor/memory/memory_filter.h"
 #include "executor/memory/memory_util.h"
@@ -33,7 +39,9 @@
 #include "hidumper_test_utils.h"
 #include "memory_collector.h"
 #include "meminfo.h"
+#include "proc_fixture.h"
 #include "string_ex.h"
+#include "util/file_utils.h"
 #include "dumper_plugin.h"
 
 using namespace std;
@@ -159,6 +167,39 @@ const std::vector<std::string> DMA_SHOW_TITLES = {
     "Process", "pid", "fd", "size_bytes", "ino", "exp_pid",
     "exp_task_comm", "buf_name", "exp_name", "buf_type", "leak_type"
 };
+const std::string GRAPHICS_FIXTURE_PATH = "/data/local/tmp/hidumper_graphics_memory";
+
+// serves the graphics memory from a fixture table of "pid gl graph" lines in kB.
+class FixtureGraphicsMemoryProvider : public GraphicsMemoryProvider {
+public:
+    explicit FixtureGraphicsMemoryProvider(const std::string &path) : path_(path) {}
+    int collectCount_ = 0;
+
+protected:
+    bool CollectAll(const std::vector<int32_t> &pids, bool withGraph, EntryMap &entries) override
+    {
+        collectCount_++;
+        std::ifstream fixture(path_);
+        if (!fixture.is_open()) {
+            return false;
+        }
+        int32_t pid = 0;
+        uint64_t gl = 0;
+        uint64_t graph = 0;
+        while (fixture >> pid >> gl >> graph) {
+            if (std::find(pids.begin(), pids.end(), pid) == pids.end()) {
+                continue;
+            }
+            entries[pid].gl = gl;
+            entries[pid].graph = withGraph ? graph : 0;
+        }
+        return true;
+    }
+
+private:
+    std::string path_;
+};
+
 using ValueMap = std::map<std::string, uint64_t>;
 using GroupMap = std::map<std::string, ValueMap>;
 using StringMatrix = std::shared_ptr<std::vector<std::vector<std::string>>>;
@@ -644,6 +685,37 @@ HWTEST_F(HidumperMemoryTest, MemoryInfo0016, TestSize.Level1)
     }
 }
 
+/**
+ * @tc.name: MemoryInfo0016_1
+ * @tc.desc: Test plugin instance reuse and the batched collection fallback.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperMemoryTest, MemoryInfo0016_1, TestSize.Level1)
+{
+    // other tests may hold the plugin loaded, so the batched result is only checked to be consistent.
+    auto checkBatch = []() {
+        std::vector<DumpPluginRecord> records;
+        if (!CollectBatch({INIT_PID}, PLUGIN_BATCH_GRAPHICS_MEMORY, records)) {
+            ASSERT_TRUE(records.empty());
+            return;
+        }
+        for (const auto& record : records) {
+            ASSERT_EQ(record.pid, INIT_PID);
+        }
+    };
+    checkBatch();
+    if (LoadPlugin() != PLUGIN_ENABLE) {
+        GTEST_SKIP() << "no memory plugin on this device, instance reuse is not covered";
+    }
+    int realSize = 0;
+    DumpMeminfo info[256];
+    bool first = QueryMemInfo(info, realSize);
+    ASSERT_EQ(QueryMemInfo(info, realSize), first);
+    checkBatch();
+    UnloadPlugin();
+    checkBatch();
+}
+
 /**
  * @tc.name: MemoryInfo017
  * @tc.desc: Test about gpumem.
@@ -671,6 +743,221 @@ HWTEST_F(HidumperMemoryTest, MemoryInfo017, TestSize.Level1)
 }
 
 
+/**
+ * @tc.name: MemoryInfo018
+ * @tc.desc: Test a reset MemoryInfo serves the next request like a new one.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperMemoryTest, MemoryInfo018, TestSize.Level1)
+{
+    unique_ptr<OHOS::HiviewDFX::MemoryInfo> memoryInfo =
+        make_unique<OHOS::HiviewDFX::MemoryInfo>();
+    shared_ptr<vector<vector<string>>> result = make_shared<vector<vector<string>>>();
+    int fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(memoryInfo->GetMemoryInfoPrune(fd, result), DumpStatus::DUMP_OK);
+    ASSERT_TRUE(memoryInfo->dumpPrune_);
+    ASSERT_FALSE(memoryInfo->memUsages_.empty());
+    memoryInfo->Reset();
+    ASSERT_FALSE(memoryInfo->dumpPrune_);
+    ASSERT_FALSE(memoryInfo->isReady_);
+    ASSERT_TRUE(memoryInfo->memUsages_.empty());
+    ASSERT_TRUE(memoryInfo->pids_.empty());
+    ASSERT_EQ(memoryInfo->totalDma_, 0);
+    for (const auto &adjMem : memoryInfo->adjMemResult_) {
+        ASSERT_TRUE(adjMem.second.empty());
+    }
+    result->clear();
+    ASSERT_EQ(memoryInfo->GetMemoryInfoNoPid(fd, result), DumpStatus::DUMP_OK);
+    close(fd);
+}
+
+/**
+ * @tc.name: MemoryInfo019
+ * @tc.desc: Test the top N ranking keeps the largest processes only.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperMemoryTest, MemoryInfo019, TestSize.Level1)
+{
+    unique_ptr<OHOS::HiviewDFX::MemoryInfo> memoryInfo =
+        make_unique<OHOS::HiviewDFX::MemoryInfo>();
+    const size_t topN = 3;
+    const uint64_t pssList[] = {10, 50, 20, 40, 30};
+    MemInfoData::MemUsage usage;
+    MemoryUtil::GetInstance().InitMemUsage(usage);
+    memoryInfo->topN_ = topN;
+    for (size_t i = 0; i < sizeof(pssList) / sizeof(pssList[0]); i++) {
+        usage.pid = static_cast<int>(i + 1);
+        usage.pss = pssList[i];
+        memoryInfo->PushTopN(usage);
+    }
+    ASSERT_EQ(memoryInfo->memUsages_.size(), topN);
+    std::sort(memoryInfo->memUsages_.begin(), memoryInfo->memUsages_.end(),
+        [] (const MemInfoData::MemUsage &left, const MemInfoData::MemUsage &right) {
+        return left.pss > right.pss;
+    });
+    ASSERT_EQ(memoryInfo->memUsages_[0].pss, 50);
+    ASSERT_EQ(memoryInfo->memUsages_[1].pss, 40);
+    ASSERT_EQ(memoryInfo->memUsages_[2].pss, 30);
+    memoryInfo->Reset();
+    ASSERT_EQ(memoryInfo->topN_, 0);
+
+    int fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    ASSERT_GE(fd, 0);
+    shared_ptr<vector<vector<string>>> result = make_shared<vector<vector<string>>>();
+    ASSERT_EQ(memoryInfo->GetMemoryInfoTop(fd, topN, false, result), DumpStatus::DUMP_OK);
+    ASSERT_TRUE(memoryInfo->memUsages_.empty());
+    ASSERT_EQ(memoryInfo->topN_, 0);
+    close(fd);
+}
+
+/**
+ * @tc.name: MemoryInfo020
+ * @tc.desc: Test a pushed down query leaves processes out of the rows but not out of the totals.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperMemoryTest, MemoryInfo020, TestSize.Level1)
+{
+    unique_ptr<OHOS::HiviewDFX::MemoryInfo> memoryInfo =
+        make_unique<OHOS::HiviewDFX::MemoryInfo>();
+    auto countAdjUsages = [&memoryInfo]() {
+        size_t count = 0;
+        for (const auto &adjMem : memoryInfo->adjMemResult_) {
+            count += adjMem.second.size();
+        }
+        return count;
+    };
+    ColumnRowsQuery query;
+    string errStr;
+    ASSERT_TRUE(query.Parse("where PID==1", errStr));
+    memoryInfo->SetProcessFilter(query.GetProcessFilter());
+    int fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    ASSERT_GE(fd, 0);
+    shared_ptr<vector<vector<string>>> result = make_shared<vector<vector<string>>>();
+    ASSERT_EQ(memoryInfo->GetMemoryInfoPrune(fd, result), DumpStatus::DUMP_OK);
+    ASSERT_LE(memoryInfo->memUsages_.size(), 1);
+    for (const auto &memUsage : memoryInfo->memUsages_) {
+        ASSERT_EQ(memUsage.pid, 1);
+    }
+    if (memoryInfo->pids_.size() > 1) {
+        ASSERT_GT(countAdjUsages(), memoryInfo->memUsages_.size());
+    }
+    memoryInfo->Reset();
+
+    ASSERT_TRUE(query.Parse("where Pss>=" + to_string(UINT32_MAX), errStr));
+    memoryInfo->SetProcessFilter(query.GetProcessFilter());
+    ASSERT_EQ(memoryInfo->GetMemoryInfoPrune(fd, result), DumpStatus::DUMP_OK);
+    ASSERT_TRUE(memoryInfo->memUsages_.empty());
+    ASSERT_GT(countAdjUsages(), 0);
+    memoryInfo->Reset();
+    ASSERT_TRUE(memoryInfo->processFilter_.IsEmpty());
+    close(fd);
+}
+
+/**
+ * @tc.name: ProcRoot001
+ * @tc.desc: Test the parsers and the pid scan read a generated tree under the proc root.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperMemoryTest, ProcRoot001, TestSize.Level1)
+{
+    ProcFixture::Spec spec;
+    spec.processCount = 3;
+    spec.vmaCount = 20;
+    spec.ashmemCount = 2;
+    ProcFixture fixture("/data/local/tmp/hidumper_proc_root_test", spec);
+    ASSERT_TRUE(fixture.Generate());
+    DumpCommonUtils::SetProcRoot(fixture.GetRoot() + "/");
+    ASSERT_EQ(FileUtils::GetInstance().GetProcPath("/proc/meminfo"), fixture.GetRoot() + "/proc/meminfo");
+    ASSERT_EQ(DumpCommonUtils::GetAllPids(), fixture.GetPids());
+    string name;
+    ASSERT_TRUE(DumpCommonUtils::GetProcessNameByPid(spec.firstPid + 1, name));
+    ASSERT_EQ(name, ProcFixture::GetProcessName(1));
+
+    ParseMeminfo parseMeminfo;
+    ParseMeminfo::ValueMap meminfo;
+    ASSERT_TRUE(parseMeminfo.GetMeminfo(meminfo));
+    ASSERT_GT(meminfo["MemTotal"], 0);
+    ParseSmapsRollupInfo parseRollup;
+    MemInfoData::MemInfo memInfo;
+    ASSERT_TRUE(parseRollup.GetMemInfo(spec.firstPid, memInfo));
+    ASSERT_GT(memInfo.rss, 0);
+    ParseAshmemInfo parseAshmem;
+    pair<int, vector<string>> ashmem;
+    ASSERT_TRUE(parseAshmem.GetAshmemInfo(spec.firstPid + 2, ashmem));
+    ASSERT_EQ(ashmem.second.size(), static_cast<size_t>(spec.ashmemCount) + 1); // 1: the title
+
+    FileUtils::GetInstance().SetProcRoot("");
+    ASSERT_EQ(FileUtils::GetInstance().GetProcPath("/proc/meminfo"), "/proc/meminfo");
+    fixture.Remove();
+}
+
+/**
+ * @tc.name: GraphicsMemoryProvider001
+ * @tc.desc: Test the graphics memory index of a batched provider.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperMemoryTest, GraphicsMemoryProvider001, TestSize.Level1)
+{
+    {
+        std::ofstream fixture(GRAPHICS_FIXTURE_PATH, std::ios::trunc);
+        ASSERT_TRUE(fixture.is_open());
+        fixture << "1 100 200\n" << "2 300 400\n" << "99 500 600\n";
+    }
+    FixtureGraphicsMemoryProvider provider(GRAPHICS_FIXTURE_PATH);
+    ASSERT_FALSE(provider.Collect({}, true));
+    ASSERT_TRUE(provider.Collect({1, 2, 3}, true));
+    ASSERT_TRUE(provider.IsCollected());
+    ASSERT_EQ(provider.GetGl(1), 100);
+    ASSERT_EQ(provider.GetGraph(2), 400);
+    ASSERT_EQ(provider.GetGl(3), 0);
+    ASSERT_EQ(provider.GetGl(99), 0);
+    ASSERT_TRUE(provider.Collect({1}, false));
+    ASSERT_EQ(provider.GetGl(1), 100);
+    ASSERT_EQ(provider.GetGraph(1), 0);
+    provider.Clear();
+    ASSERT_FALSE(provider.IsCollected());
+
+    FixtureGraphicsMemoryProvider missing("/data/local/tmp/hidumper_graphics_memory_missing");
+    ASSERT_FALSE(missing.Collect({1}, true));
+    ASSERT_FALSE(missing.IsCollected());
+    remove(GRAPHICS_FIXTURE_PATH.c_str());
+}
+
+/**
+ * @tc.name: GraphicsMemoryProvider002
+ * @tc.desc: Test the all process summary reads the graphics memory from one collection.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperMemoryTest, GraphicsMemoryProvider002, TestSize.Level1)
+{
+    int32_t pid = static_cast<int32_t>(getpid());
+    {
+        std::ofstream fixture(GRAPHICS_FIXTURE_PATH, std::ios::trunc);
+        ASSERT_TRUE(fixture.is_open());
+        fixture << pid << " 100 200\n";
+    }
+    unique_ptr<OHOS::HiviewDFX::MemoryInfo> memoryInfo =
+        make_unique<OHOS::HiviewDFX::MemoryInfo>();
+    auto provider = new FixtureGraphicsMemoryProvider(GRAPHICS_FIXTURE_PATH);
+    memoryInfo->graphicsProvider_.reset(provider);
+    memoryInfo->pids_ = {pid, pid};
+    memoryInfo->rawParamFd_ = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    ASSERT_GE(memoryInfo->rawParamFd_, 0);
+    shared_ptr<vector<vector<string>>> result = make_shared<vector<vector<string>>>();
+    memoryInfo->GetMemoryUsageInfo(result);
+    close(memoryInfo->rawParamFd_);
+    ASSERT_EQ(provider->collectCount_, 1);
+    ASSERT_FALSE(provider->IsCollected());
+    ASSERT_EQ(memoryInfo->memUsages_.size(), 2);
+    for (const auto &usage : memoryInfo->memUsages_) {
+        ASSERT_EQ(usage.gl, 100);
+        ASSERT_EQ(usage.graph, 200);
+    }
+    ASSERT_EQ(memoryInfo->totalGL_, 200);
+    remove(GRAPHICS_FIXTURE_PATH.c_str());
+}
+
 /**
  * @tc.name: GetProcessInfo001
  * @tc.desc: Test GetProcessInfo ret.
@@ -701,6 +988,50 @@ HWTEST_F(HidumperMemoryTest, GetKernelInfo001, TestSize.Level1)
     ASSERT_TRUE(getGetKernelInfo->GetKernel(memInfo, value));
 }
 
+/**
+ * @tc.name: KernelCounterReader001
+ * @tc.desc: Test KernelCounterReader sums the matched files and matches them again when they change.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperMemoryTest, KernelCounterReader001, TestSize.Level1)
+{
+    const string folder = "/data/local/tmp/hidumper_kernel_counter";
+    ASSERT_EQ(system(("rm -rf " + folder + " && mkdir -p " + folder + "/a " + folder + "/b").c_str()), 0);
+    ofstream(folder + "/a/used") << "12\n";
+    ofstream(folder + "/b/used") << "30\n";
+    KernelCounterReader &reader = KernelCounterReader::GetInstance();
+    ASSERT_TRUE(reader.IsRegistered(KernelCounterReader::CMA_USED));
+    reader.Register({"test_used", folder, "*/used"});
+    uint64_t value = 0;
+    ASSERT_TRUE(reader.Read("test_used", value));
+    ASSERT_EQ(value, 42);
+    ASSERT_EQ(system(("rm -rf " + folder + "/a").c_str()), 0);
+    value = 0;
+    ASSERT_TRUE(reader.Read("test_used", value));
+    ASSERT_EQ(value, 30);
+    // a new file is only picked up once the cache has aged out.
+    ASSERT_EQ(system(("mkdir -p " + folder + "/c").c_str()), 0);
+    ofstream(folder + "/c/used") << "5\n";
+    value = 0;
+    ASSERT_TRUE(reader.Read("test_used", value));
+    ASSERT_EQ(value, 30);
+    {
+        lock_guard<mutex> lock(reader.mutex_);
+        reader.counters_["test_used"].matchedMs -= KernelCounterReader::REMATCH_INTERVAL_MS;
+    }
+    value = 0;
+    ASSERT_TRUE(reader.Read("test_used", value));
+    ASSERT_EQ(value, 35);
+    ofstream(folder + "/b/used") << "invalid\n";
+    ASSERT_FALSE(reader.Read("test_used", value));
+    ASSERT_FALSE(reader.Read("unknown", value));
+    reader.Register({"missing", folder + "/missing", "*"});
+    value = 0;
+    ASSERT_TRUE(reader.Read("missing", value));
+    ASSERT_EQ(value, 0);
+    system(("rm -rf " + folder).c_str());
+}
+
 
 /**
  * @tc.name: GraphicMemory001
@@ -15,12 +15,16 @@
 #include "hidumper_service_test.h"
 #include <fstream>
 #include <fcntl.h>
+#include <thread>
 #include <iservice_registry.h>
+#include "common.h"
 #include "dump_manager_client.h"
 #include "dump_manager_service.h"
 #include "inner/dump_service_id.h"
 #include "dump_on_demand_load.h"
 #include "executor/memory/memory_util.h"
+#include "output_fanout.h"
+#include "raw_param.h"
 #include "string_ex.h"
 
 using namespace std;
@@ -758,5 +762,161 @@ HWTEST_F(HidumperServiceTest, DumpManagerService036, TestSize.Level3)
     EXPECT_EQ(result, expected);
     std::cout << "DumpManagerService036 passed: Equal counts choose fd." << std::endl;
 }
+
+/**
+ * @tc.name: DumpManagerService038
+ * @tc.desc: Test request fingerprint and priority used by the admission layer.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperServiceTest, DumpManagerService038, TestSize.Level3)
+{
+    auto toArgs = [](const std::vector<std::string> &strs) {
+        std::vector<std::u16string> args;
+        for (const auto &str : strs) {
+            args.push_back(Str8ToStr16(str));
+        }
+        return args;
+    };
+    std::string memAll = DumpManagerService::GetRequestFingerprint(toArgs({"hidumper", "--mem", "100"}));
+    EXPECT_FALSE(memAll.empty());
+    EXPECT_EQ(memAll, DumpManagerService::GetRequestFingerprint(toArgs({"hidumper", "--mem", "200"})));
+    EXPECT_NE(memAll, DumpManagerService::GetRequestFingerprint(toArgs({"hidumper", "--mem", "1", "200"})));
+    EXPECT_TRUE(DumpManagerService::GetRequestFingerprint(toArgs({"hidumper", "--zip", "100"})).empty());
+    EXPECT_TRUE(DumpManagerService::GetRequestFingerprint(toArgs({"hidumper", "100"})).empty());
+
+    char arg0[] = "hidumper";
+    char arg1[] = "--mem";
+    char arg2[] = "1";
+    char argAll[] = "-a";
+    char *pidArgv[] = {arg0, arg1, arg2, nullptr};
+    char *memArgv[] = {arg0, arg1, nullptr};
+    char *allArgv[] = {arg0, argAll, nullptr};
+    int pidPriority = DumpManagerService::GetRequestPriority(3, pidArgv);
+    int memPriority = DumpManagerService::GetRequestPriority(2, memArgv);
+    int allPriority = DumpManagerService::GetRequestPriority(2, allArgv);
+    EXPECT_GT(pidPriority, memPriority);
+    EXPECT_GT(memPriority, allPriority);
+}
+
+/**
+ * @tc.name: DumpManagerService039
+ * @tc.desc: Test an identical request attaches to the inflight one and gets the whole output.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperServiceTest, DumpManagerService039, TestSize.Level3)
+{
+    auto dumpManagerService = std::make_shared<DumpManagerService>();
+    int leaderPipe[2] = {-1, -1};
+    int followerPipe[2] = {-1, -1};
+    ASSERT_EQ(pipe(leaderPipe), 0);
+    ASSERT_EQ(pipe(followerPipe), 0);
+    std::string fingerprint = "--mem ";
+    int outfd = leaderPipe[1];
+    auto fanout = dumpManagerService->LeadInflightRequest(fingerprint, outfd);
+    ASSERT_TRUE(fanout != nullptr);
+    ASSERT_NE(outfd, leaderPipe[1]);
+    std::string output = "shared output\n";
+    ASSERT_EQ(write(outfd, output.c_str(), output.size()), static_cast<ssize_t>(output.size()));
+
+    std::string followerOutput;
+    std::thread follower([&]() {
+        int32_t status = DumpStatus::DUMP_OK;
+        EXPECT_TRUE(dumpManagerService->AttachToInflightRequest(fingerprint, followerPipe[1], status));
+        EXPECT_EQ(status, DumpStatus::DUMP_FAIL);
+    });
+    auto readAll = [](int fd, std::string &result) {
+        char buf[64] = {0};
+        ssize_t len = 0;
+        while ((len = read(fd, buf, sizeof(buf))) > 0) {
+            result.append(buf, len);
+        }
+        close(fd);
+    };
+    std::string leaderOutput;
+    std::thread leaderReader(readAll, leaderPipe[0], std::ref(leaderOutput));
+    std::thread followerReader(readAll, followerPipe[0], std::ref(followerOutput));
+    bool attached = false;
+    while (!attached) { // wait until the follower has joined the clients
+        std::this_thread::yield();
+        std::lock_guard<std::mutex> lock(fanout->mutex_);
+        attached = fanout->followers_.size() == 1;
+    }
+    EXPECT_EQ(dumpManagerService->GetRequestSum(), 1);
+    std::vector<std::u16string> args;
+    auto rawParam = std::make_shared<RawParam>(0, 0, 1, args, outfd);
+    dumpManagerService->inflightLeaders_[rawParam->GetRequestId()] = fingerprint;
+    dumpManagerService->EndInflightRequest(rawParam, DumpStatus::DUMP_FAIL);
+    follower.join();
+    leaderReader.join();
+    followerReader.join();
+    EXPECT_EQ(leaderOutput, output);
+    EXPECT_EQ(followerOutput, output);
+    EXPECT_TRUE(dumpManagerService->inflightRequests_.empty());
+}
+
+/**
+ * @tc.name: DumpManagerService040
+ * @tc.desc: Test a follower that does not read stalls neither the leader nor loses output within the queue limit,
+ *           and gets DUMP_FAIL once it falls further behind.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperServiceTest, DumpManagerService040, TestSize.Level3)
+{
+    // far more than a pipe holds, the follower pipe is not read until the leader has finished.
+    const std::string block(64 * 1024, 'x');
+    const size_t blockCount = 16;
+    auto runFollower = [&block, blockCount](size_t queueLimit, size_t &followerSize, int32_t &followerStatus) {
+        int leaderPipe[2] = {-1, -1};
+        int followerPipe[2] = {-1, -1};
+        ASSERT_EQ(pipe(leaderPipe), 0);
+        ASSERT_EQ(pipe(followerPipe), 0);
+        OutputFanout fanout(queueLimit);
+        ASSERT_TRUE(fanout.Start(leaderPipe[1]));
+        std::thread follower([&]() {
+            EXPECT_TRUE(fanout.Attach(followerPipe[1], followerStatus));
+        });
+        bool attached = false;
+        while (!attached) {
+            std::this_thread::yield();
+            std::lock_guard<std::mutex> lock(fanout.mutex_);
+            attached = fanout.followers_.size() == 1;
+        }
+        std::string leaderOutput;
+        std::thread leaderReader([&]() {
+            char buf[4096] = {0};
+            ssize_t len = 0;
+            while ((len = read(leaderPipe[0], buf, sizeof(buf))) > 0) {
+                leaderOutput.append(buf, len);
+            }
+            close(leaderPipe[0]);
+        });
+        int inputFd = fanout.GetInputFd();
+        for (size_t i = 0; i < blockCount; i++) {
+            ASSERT_EQ(write(inputFd, block.data(), block.size()), static_cast<ssize_t>(block.size()));
+        }
+        close(inputFd);
+        fanout.Finish(DumpStatus::DUMP_OK);
+        leaderReader.join();
+        EXPECT_EQ(leaderOutput.size(), block.size() * blockCount);
+        char buf[4096] = {0};
+        ssize_t len = 0;
+        while ((len = read(followerPipe[0], buf, sizeof(buf))) > 0) {
+            followerSize += static_cast<size_t>(len);
+        }
+        close(followerPipe[0]);
+        follower.join();
+    };
+    size_t followerSize = 0;
+    int32_t followerStatus = DumpStatus::DUMP_FAIL;
+    runFollower(OutputFanout::DEFAULT_REPLAY_LIMIT, followerSize, followerStatus);
+    EXPECT_EQ(followerSize, block.size() * blockCount);
+    EXPECT_EQ(followerStatus, DumpStatus::DUMP_OK);
+
+    followerSize = 0;
+    followerStatus = DumpStatus::DUMP_OK;
+    runFollower(block.size() * 4, followerSize, followerStatus);
+    EXPECT_LT(followerSize, block.size() * blockCount);
+    EXPECT_EQ(followerStatus, DumpStatus::DUMP_FAIL);
+}
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -211,5 +211,38 @@ HWTEST_F(ZipFileCleanerTest, CleanOldFilesTest004, TestSize.Level3)
     ASSERT_EQ(static_cast<int>(files.size()), LOGFILE_MAX);
 }
 
+/**
+ * @tc.name: CleanOldFilesTest005
+ * @tc.desc: Test CleanOldFiles evicts the trace files next to the zips by their own limits
+ * @tc.type: FUNC
+ */
+HWTEST_F(ZipFileCleanerTest, CleanOldFilesTest005, TestSize.Level3)
+{
+    for (int i = 0; i < LOGFILE_MAX; i++) {
+        std::string fileName = testDir_ + "20250305-143025-" + to_string(i) + ".zip";
+        ASSERT_TRUE(CreateTestFile(fileName, TEST_FILE_SIZE_1KB));
+    }
+    const int traceCount = TRACEFILE_MAX + 3;
+    for (int i = 0; i < traceCount; i++) {
+        std::string fileName = testDir_ + "20250305-143026-" + to_string(i + 10) + ".trace.json";
+        ASSERT_TRUE(CreateTestFile(fileName, TEST_FILE_SIZE_1KB));
+    }
+    std::string other = testDir_ + "20250305-143025-000.json";
+    ASSERT_TRUE(CreateTestFile(other, TEST_FILE_SIZE_1KB));
+
+    ASSERT_TRUE(ZipFileCleaner::CleanOldFiles(testDir_));
+
+    std::vector<FileInfo> zips;
+    ZipFileCleaner::GetDirTotalSize(testDir_, zips);
+    ASSERT_EQ(static_cast<int>(zips.size()), LOGFILE_MAX);
+    std::vector<FileInfo> traces;
+    ZipFileCleaner::GetDirTotalSize(testDir_, traces, true);
+    ASSERT_EQ(static_cast<int>(traces.size()), TRACEFILE_MAX);
+    ASSERT_FALSE(access((testDir_ + "20250305-143026-10.trace.json").c_str(), F_OK) == 0);
+    ASSERT_TRUE(access((testDir_ + "20250305-143026-" + to_string(traceCount + 9) + ".trace.json").c_str(),
+        F_OK) == 0);
+    ASSERT_TRUE(access(other.c_str(), F_OK) == 0);
+}
+
 } // namespace HiviewDFX
 } // namespace OHOS